@@ -0,0 +1,504 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#include "amxmodx.h"
+#include "CAsyncFile.h"
+#include "CFileSystem.h"
+#include "CLibrarySys.h"
+#include "datastructs.h"
+#include "hasher.h"
+
+CAsyncFileMngr g_AsyncFiles;
+
+CAsyncFileMngr::CAsyncFileMngr() : m_InFlight(0), m_MaxSize(0), m_Completed(0), m_Refused(0)
+{
+}
+
+size_t CAsyncFileMngr::GetMaxSize()
+{
+	// Read once, before the first job, workers only see it afterwards
+	if (!m_MaxSize)
+	{
+		int megs = atoi(get_localinfo("asyncfile_maxsize", "16"));
+
+		m_MaxSize = static_cast<size_t>(megs > 0 ? megs : 16) * 1024 * 1024;
+	}
+
+	return m_MaxSize;
+}
+
+bool CAsyncFileMngr::Reserve(size_t bytes)
+{
+	size_t max = GetMaxSize();
+	size_t current = m_InFlight.load();
+
+	do
+	{
+		if (bytes > max || current > max - bytes)
+		{
+			++m_Refused;
+			return false;
+		}
+	}
+	while (!m_InFlight.compare_exchange_weak(current, current + bytes));
+
+	return true;
+}
+
+int CAsyncFileMngr::Read(AMX *amx, int forward, const char *name, size_t blocksize, const cell *data, size_t datalen, bool valvefs, const char *pathID)
+{
+	Job *job = new Job;
+
+	job->op = AsyncFile_Read;
+	job->amx = amx;
+	job->forward = forward;
+	job->name = name;
+	job->path = valvefs ? name : build_pathname("%s", name);
+	job->pathID = pathID ? pathID : "";
+	job->valvefs = valvefs;
+	job->append = false;
+	job->blocksize = blocksize;
+	job->reserved = 0;
+
+	return AddJob(job, data, datalen);
+}
+
+int CAsyncFileMngr::Write(AMX *amx, int forward, const char *name, ke::Vector<char> &&buffer, bool append, const cell *data, size_t datalen)
+{
+	Job *job = new Job;
+
+	job->op = AsyncFile_Write;
+	job->amx = amx;
+	job->forward = forward;
+	job->name = name;
+	job->path = build_pathname("%s", name);
+	job->valvefs = false;
+	job->append = append;
+	job->blocksize = 0;
+	job->reserved = buffer.length();
+	job->buffer = ke::Move(buffer);
+
+	return AddJob(job, data, datalen);
+}
+
+int CAsyncFileMngr::List(AMX *amx, int forward, const char *name, const cell *data, size_t datalen, bool valvefs, const char *pathID)
+{
+	Job *job = new Job;
+
+	job->op = AsyncFile_List;
+	job->amx = amx;
+	job->forward = forward;
+	job->name = name;
+	job->path = valvefs ? name : build_pathname("%s", name);
+	job->pathID = pathID ? pathID : "";
+	job->valvefs = valvefs;
+	job->append = false;
+	job->blocksize = PLATFORM_MAX_PATH;
+	job->reserved = 0;
+
+	return AddJob(job, data, datalen);
+}
+
+int CAsyncFileMngr::Hash(AMX *amx, int forward, const char *name, HashType type, const cell *data, size_t datalen)
+{
+	Job *job = new Job;
+
+	job->op = AsyncFile_Hash;
+	job->amx = amx;
+	job->forward = forward;
+	job->name = name;
+	job->path = build_pathname("%s", name);
+	job->valvefs = false;
+	job->append = false;
+	job->blocksize = 0;
+	job->hashtype = type;
+	job->reserved = 0;
+
+	return AddJob(job, data, datalen);
+}
+
+int CAsyncFileMngr::AddJob(Job *job, const cell *data, size_t datalen)
+{
+	for (size_t i = 0; i < datalen; ++i)
+	{
+		job->data.append(data[i]);
+	}
+
+	job->result = nullptr;
+	job->status = AsyncResult_Ok;
+
+	GetMaxSize();
+
+	// Same path, same queue, so jobs on a file are run in order
+	unsigned int hash = 2166136261u;
+
+	for (const char *c = job->path.chars(); *c; ++c)
+	{
+		hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+	}
+
+	int id = g_ThreadPool.AddJob(job->amx, &m_Queues[hash % NumQueues], RunJob, CompleteJob, job);
+
+	if (!id)
+	{
+		if (job->forward != -1)
+		{
+			unregisterSPForward(job->forward);
+		}
+
+		Release(job);
+		delete job;
+	}
+
+	return id;
+}
+
+void CAsyncFileMngr::RunJob(void *data)
+{
+	Job *job = static_cast<Job *>(data);
+
+	if (job->valvefs)
+	{
+		// Done on the main thread when completed
+		return;
+	}
+
+	switch (job->op)
+	{
+		case AsyncFile_Read:  g_AsyncFiles.ReadFile(job);  break;
+		case AsyncFile_Write: g_AsyncFiles.WriteFile(job); break;
+		case AsyncFile_List:  g_AsyncFiles.ListDir(job);   break;
+		case AsyncFile_Hash:  g_AsyncFiles.HashFile(job);  break;
+	}
+}
+
+void CAsyncFileMngr::CompleteJob(void *data, bool cancelled)
+{
+	Job *job = static_cast<Job *>(data);
+
+	if (!cancelled)
+	{
+		if (job->valvefs)
+		{
+			if (job->op == AsyncFile_Read)
+			{
+				g_AsyncFiles.ReadFile(job);
+			}
+			else if (job->op == AsyncFile_List)
+			{
+				g_AsyncFiles.ListDir(job);
+			}
+		}
+
+		if (job->forward != -1)
+		{
+			cell empty = 0;
+			size_t datalen = job->data.length();
+
+			if (job->op == AsyncFile_Hash)
+			{
+				executeForwards(job->forward, static_cast<cell>(job->status), job->name.chars(), job->hash.chars(),
+								prepareCellArray(datalen ? job->data.buffer() : &empty, datalen ? datalen : 1), static_cast<cell>(datalen));
+			}
+			else
+			{
+				cell array = 0;
+
+				if (job->result)
+				{
+					// The plugin owns the Array from now on
+					AMX *caller = g_HandleStats.EnterNative(job->amx);
+					array = ArrayHandles.clone(job->result);
+					g_HandleStats.LeaveNative(caller);
+
+					job->result = nullptr;
+				}
+
+				executeForwards(job->forward, static_cast<cell>(job->status), job->name.chars(), array,
+								prepareCellArray(datalen ? job->data.buffer() : &empty, datalen ? datalen : 1), static_cast<cell>(datalen));
+			}
+		}
+
+		++g_AsyncFiles.m_Completed;
+	}
+
+	if (job->forward != -1)
+	{
+		unregisterSPForward(job->forward);
+	}
+
+	delete job->result;
+
+	g_AsyncFiles.Release(job);
+
+	delete job;
+}
+
+void CAsyncFileMngr::Release(Job *job)
+{
+	if (job->reserved)
+	{
+		m_InFlight -= job->reserved;
+		job->reserved = 0;
+	}
+}
+
+void CAsyncFileMngr::ReadFile(Job *job)
+{
+	ke::AutoPtr<FileObject> fp;
+
+	if (job->valvefs)
+	{
+		fp = ValveFile::Open(job->path.chars(), "rb", job->pathID.length() ? job->pathID.chars() : nullptr);
+	}
+	else
+	{
+		fp = SystemFile::Open(job->path.chars(), "rb");
+	}
+
+	if (!fp)
+	{
+		job->status = AsyncResult_OpenFailed;
+		return;
+	}
+
+	fp->Seek(0, SEEK_END);
+	int size = fp->Tell();
+	fp->Seek(0, SEEK_SET);
+
+	if (size < 0)
+	{
+		job->status = AsyncResult_Failed;
+		return;
+	}
+
+	if (!Reserve(size))
+	{
+		job->status = AsyncResult_OverLimit;
+		return;
+	}
+
+	job->reserved = size;
+
+	char *contents = new char[size + 1];
+	size_t length = fp->Read(contents, size);
+
+	if (fp->HasError())
+	{
+		job->status = AsyncResult_Failed;
+	}
+	else
+	{
+		SplitLines(job, contents, length);
+	}
+
+	delete [] contents;
+}
+
+void CAsyncFileMngr::SplitLines(Job *job, const char *contents, size_t length)
+{
+	CellArray *lines = new CellArray(job->blocksize);
+
+	const char *end = contents + length;
+	const char *line = contents;
+
+	while (line < end)
+	{
+		const char *eol = static_cast<const char *>(memchr(line, '\n', end - line));
+		const char *next = eol ? eol + 1 : end;
+
+		if (!eol)
+		{
+			eol = end;
+		}
+
+		if (eol > line && eol[-1] == '\r')
+		{
+			--eol;
+		}
+
+		cell *block = lines->push();
+
+		if (!block)
+		{
+			delete lines;
+
+			job->status = AsyncResult_Failed;
+			return;
+		}
+
+		size_t count = ke::Min(static_cast<size_t>(eol - line), job->blocksize - 1);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			block[i] = static_cast<unsigned char>(line[i]);
+		}
+
+		// Don't leave half of a multi-byte character behind
+		if (count && count < static_cast<size_t>(eol - line) && (block[count - 1] & 1 << 7))
+		{
+			count -= UTIL_CheckValidChar(block + count - 1);
+		}
+
+		block[count] = '\0';
+
+		line = next;
+	}
+
+	job->result = lines;
+}
+
+void CAsyncFileMngr::WriteFile(Job *job)
+{
+	ke::AutoPtr<SystemFile> fp(SystemFile::Open(job->path.chars(), job->append ? "a" : "w"));
+
+	if (!fp)
+	{
+		job->status = AsyncResult_OpenFailed;
+		return;
+	}
+
+	size_t length = job->buffer.length();
+
+	if ((length && fp->Write(job->buffer.buffer(), length) != length) || fp->Flush() != 0)
+	{
+		job->status = AsyncResult_Failed;
+	}
+}
+
+void CAsyncFileMngr::ListDir(Job *job)
+{
+	CellArray *entries = new CellArray(job->blocksize);
+
+	if (job->valvefs)
+	{
+		const char *path = job->path.chars();
+		size_t length = job->path.length();
+
+		char wildcard[PLATFORM_MAX_PATH];
+		ke::SafeSprintf(wildcard, sizeof(wildcard), "%s%s*", path, (length && path[length - 1] != '/' && path[length - 1] != '\\') ? "/" : "");
+
+		FileFindHandle_t handle;
+		const char *entry = g_FileSystem->FindFirst(wildcard, &handle, job->pathID.length() ? job->pathID.chars() : nullptr);
+
+		if (!entry)
+		{
+			delete entries;
+
+			job->status = AsyncResult_OpenFailed;
+			return;
+		}
+
+		for (; entry; entry = g_FileSystem->FindNext(handle))
+		{
+			if (strcmp(entry, ".") != 0 && strcmp(entry, "..") != 0)
+			{
+				cell *block = entries->push();
+
+				if (!block)
+				{
+					job->status = AsyncResult_Failed;
+					break;
+				}
+
+				strncopy(block, entry, job->blocksize);
+			}
+		}
+
+		g_FileSystem->FindClose(handle);
+
+		if (job->status != AsyncResult_Ok)
+		{
+			delete entries;
+			return;
+		}
+	}
+	else
+	{
+		ke::AutoPtr<CDirectory> dir(g_LibSys.OpenDirectory(job->path.chars()));
+
+		if (!dir)
+		{
+			delete entries;
+
+			job->status = AsyncResult_OpenFailed;
+			return;
+		}
+
+		for (; dir->MoreFiles(); dir->NextEntry())
+		{
+			const char *entry = dir->GetEntryName();
+
+			if (strcmp(entry, ".") != 0 && strcmp(entry, "..") != 0)
+			{
+				cell *block = entries->push();
+
+				if (!block)
+				{
+					delete entries;
+
+					job->status = AsyncResult_Failed;
+					return;
+				}
+
+				strncopy(block, entry, job->blocksize);
+			}
+		}
+	}
+
+	job->result = entries;
+}
+
+void CAsyncFileMngr::HashFile(Job *job)
+{
+	ke::AutoPtr<SystemFile> fp(SystemFile::Open(job->path.chars(), "rb"));
+
+	if (!fp)
+	{
+		job->status = AsyncResult_OpenFailed;
+		return;
+	}
+
+	Hasher hasher(job->hashtype);
+
+	char buffer[16384];
+	size_t length;
+
+	while ((length = fp->Read(buffer, sizeof(buffer))) > 0)
+	{
+		hasher.add(buffer, length);
+	}
+
+	if (fp->HasError())
+	{
+		job->status = AsyncResult_Failed;
+		return;
+	}
+
+	char hash[MaxHashLength + 1];
+	hasher.finish(hash);
+
+	job->hash = hash;
+}
+
+void CAsyncFileMngr::OnPluginsUnloading()
+{
+	// Writes made in plugin_end() must not be lost with the plugins
+	for (size_t i = 0; i < NumQueues; ++i)
+	{
+		g_ThreadPool.WaitJobs(&m_Queues[i]);
+	}
+}
+
+void CAsyncFileMngr::OnConsoleCommand()
+{
+	print_srvconsole("Asynchronous file jobs:\n");
+	print_srvconsole(" %u bytes in flight, %u bytes at most.\n", (unsigned int)m_InFlight.load(), (unsigned int)GetMaxSize());
+	print_srvconsole(" %u jobs completed, %u refused over the limit.\n", (unsigned int)m_Completed, (unsigned int)m_Refused);
+}
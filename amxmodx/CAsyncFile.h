@@ -0,0 +1,118 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_CASYNCFILE_H_
+#define _INCLUDE_CASYNCFILE_H_
+
+#include "amx.h"
+#include "hashing.h"
+#include <amtl/am-string.h>
+#include <amtl/am-vector.h>
+#include <atomic>
+
+class CellArray;
+
+enum AsyncFileOp
+{
+	AsyncFile_Read,				// Reads the lines of a file into an Array
+	AsyncFile_Write,			// Writes or appends a buffer to a file
+	AsyncFile_List,				// Lists the entries of a directory into an Array
+	AsyncFile_Hash,				// Hashes a file, read in chunks
+};
+
+// Passed to the plugin callback, mirrored by AsyncFileResult in file.inc
+enum AsyncFileResult
+{
+	AsyncResult_Ok,
+	AsyncResult_OpenFailed,		// File or directory couldn't be opened
+	AsyncResult_Failed,			// Read or write error
+	AsyncResult_OverLimit,		// Reading the file would exceed asyncfile_maxsize
+};
+
+/**
+ * File natives which do their I/O on the core thread pool, and report to a plugin public on
+ * a later frame.
+ *
+ * Paths are resolved with build_pathname() when the native is called. Jobs on the same path
+ * share a pool queue, so they run in the order they were made, e.g. a read made after a write
+ * sees the written data. The Valve file system isn't thread-safe: reads and listings going
+ * through it are done on the main thread, right before their callback.
+ *
+ * Buffers being written and files being read count against asyncfile_maxsize (core.ini):
+ * writes over it are refused, and reads over it fail with AsyncResult_OverLimit. Hashed
+ * files are streamed through a fixed buffer and don't count.
+ */
+class CAsyncFileMngr
+{
+public:
+	static const size_t NumQueues = 16;
+
+	struct Job
+	{
+		AsyncFileOp op;
+		AMX *amx;
+		int forward;				// -1 if the plugin doesn't want a callback
+		ke::AString name;			// As given by the plugin
+		ke::AString path;			// Resolved, or relative to the search paths if valvefs
+		ke::AString pathID;
+		bool valvefs;
+		bool append;
+		size_t blocksize;			// Cells per Array entry
+		HashType hashtype;
+		ke::AString hash;			// Hex digest of a hashed file
+		ke::Vector<char> buffer;	// Data to write
+		ke::Vector<cell> data;		// Passed back to the callback
+		size_t reserved;			// Bytes counted against the limit
+		CellArray *result;
+		AsyncFileResult status;
+	};
+
+public:
+	CAsyncFileMngr();
+
+public:
+	int Read(AMX *amx, int forward, const char *name, size_t blocksize, const cell *data, size_t datalen, bool valvefs, const char *pathID);
+	int Write(AMX *amx, int forward, const char *name, ke::Vector<char> &&buffer, bool append, const cell *data, size_t datalen);
+	int List(AMX *amx, int forward, const char *name, const cell *data, size_t datalen, bool valvefs, const char *pathID);
+	int Hash(AMX *amx, int forward, const char *name, HashType type, const cell *data, size_t datalen);
+
+	// Reserves room for a buffer about to be written, false if it doesn't fit
+	bool Reserve(size_t bytes);
+
+	// Runs the remaining jobs and their callbacks while plugins are still there
+	void OnPluginsUnloading();
+
+	void OnConsoleCommand();
+
+private:
+	int AddJob(Job *job, const cell *data, size_t datalen);
+	size_t GetMaxSize();
+
+	static void RunJob(void *data);
+	static void CompleteJob(void *data, bool cancelled);
+
+	void ReadFile(Job *job);
+	void WriteFile(Job *job);
+	void ListDir(Job *job);
+	void HashFile(Job *job);
+	void SplitLines(Job *job, const char *contents, size_t length);
+	void Release(Job *job);
+
+private:
+	char m_Queues[NumQueues];		// Addresses used as pool queue keys, by path hash
+	std::atomic<size_t> m_InFlight;
+	size_t m_MaxSize;
+
+	size_t m_Completed;
+	std::atomic<size_t> m_Refused;
+};
+
+extern CAsyncFileMngr g_AsyncFiles;
+
+#endif // _INCLUDE_CASYNCFILE_H_
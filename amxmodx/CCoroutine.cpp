@@ -0,0 +1,578 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#if defined(__APPLE__)
+	// The ucontext functions are only declared for XSI
+	#define _XOPEN_SOURCE 600
+	#define _DARWIN_C_SOURCE
+#endif
+
+#include "amxmodx.h"
+#include "CCoroutine.h"
+#include "debugger.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+	#include <ucontext.h>
+#endif
+
+#if defined(__APPLE__)
+	// Deprecated, but still the only way to switch stacks there
+	#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+CCoroutineMngr g_Coroutines;
+
+struct CCoroutineMngr::FiberContext
+{
+#if defined(__linux__) || defined(__APPLE__)
+	ucontext_t context;
+	ucontext_t caller;
+	char *stack;
+#else
+	LPVOID fiber;
+	LPVOID caller;
+#endif
+};
+
+/*********************** Fibers ***********************/
+
+#if defined(__linux__) || defined(__APPLE__)
+
+static CCoroutineMngr::CCoroutine *StartingCoroutine;
+
+static void FiberMain()
+{
+	CCoroutineMngr::CCoroutine *co = StartingCoroutine;
+
+	g_Coroutines.Execute(co);
+
+	// Done, the context is never switched to again
+	swapcontext(&co->context->context, &co->context->caller);
+}
+
+static CCoroutineMngr::FiberContext *CreateFiberContext(CCoroutineMngr::CCoroutine *co)
+{
+	auto context = new CCoroutineMngr::FiberContext;
+
+	if (getcontext(&context->context) != 0)
+	{
+		delete context;
+		return nullptr;
+	}
+
+	context->stack = new char[CCoroutineMngr::StackSize];
+	context->context.uc_stack.ss_sp = context->stack;
+	context->context.uc_stack.ss_size = CCoroutineMngr::StackSize;
+	context->context.uc_link = nullptr;
+
+	makecontext(&context->context, FiberMain, 0);
+
+	return context;
+}
+
+static void DestroyFiberContext(CCoroutineMngr::FiberContext *context)
+{
+	delete [] context->stack;
+	delete context;
+}
+
+static void SwitchToCoroutine(CCoroutineMngr::CCoroutine *co)
+{
+	StartingCoroutine = co;
+	swapcontext(&co->context->caller, &co->context->context);
+}
+
+static void SwitchFromCoroutine(CCoroutineMngr::CCoroutine *co)
+{
+	swapcontext(&co->context->context, &co->context->caller);
+}
+
+#else
+
+static VOID CALLBACK FiberMain(LPVOID param)
+{
+	auto co = static_cast<CCoroutineMngr::CCoroutine *>(param);
+
+	g_Coroutines.Execute(co);
+
+	// Done, the fiber is never switched to again
+	SwitchToFiber(co->context->caller);
+}
+
+static CCoroutineMngr::FiberContext *CreateFiberContext(CCoroutineMngr::CCoroutine *co)
+{
+	static bool ThreadIsFiber = false;
+
+	if (!ThreadIsFiber)
+	{
+		if (!ConvertThreadToFiber(nullptr) && GetLastError() != ERROR_ALREADY_FIBER)
+		{
+			return nullptr;
+		}
+
+		ThreadIsFiber = true;
+	}
+
+	auto context = new CCoroutineMngr::FiberContext;
+
+	context->fiber = CreateFiber(CCoroutineMngr::StackSize, FiberMain, co);
+	context->caller = nullptr;
+
+	if (!context->fiber)
+	{
+		delete context;
+		return nullptr;
+	}
+
+	return context;
+}
+
+static void DestroyFiberContext(CCoroutineMngr::FiberContext *context)
+{
+	DeleteFiber(context->fiber);
+	delete context;
+}
+
+static void SwitchToCoroutine(CCoroutineMngr::CCoroutine *co)
+{
+	co->context->caller = GetCurrentFiber();
+	SwitchToFiber(co->context->fiber);
+}
+
+static void SwitchFromCoroutine(CCoroutineMngr::CCoroutine *co)
+{
+	SwitchToFiber(co->context->caller);
+}
+
+#endif
+
+/*********************** CCoroutine ***********************/
+
+CCoroutineMngr::CCoroutine::CCoroutine() : id(0), amx(nullptr), func(-1), state(Coroutine_Running),
+	started(false), cancelled(false), wakeTime(0.0f), value(0), entryStk(0), entryHea(0), baseFrm(0),
+	saved(nullptr), savedCapacity(0), tracer(nullptr), context(nullptr)
+{
+	memset(&regs, 0, sizeof(regs));
+}
+
+CCoroutineMngr::CCoroutine::~CCoroutine()
+{
+	delete [] saved;
+	delete tracer;
+
+	if (context)
+	{
+		DestroyFiberContext(context);
+	}
+}
+
+/*********************** CCoroutineMngr ***********************/
+
+CCoroutineMngr::CCoroutineMngr() : m_Current(nullptr), m_NextId(0)
+{
+}
+
+CCoroutineMngr::~CCoroutineMngr()
+{
+	// Whatever is left can't be unwound anymore, plugins are gone
+	m_Coroutines.clear();
+}
+
+int CCoroutineMngr::Start(AMX *amx, int func, const cell *data, size_t length)
+{
+	ke::AutoPtr<CCoroutine> co(new CCoroutine);
+
+	co->context = CreateFiberContext(co.get());
+
+	if (!co->context)
+	{
+		return 0;
+	}
+
+	if (++m_NextId <= 0)
+	{
+		m_NextId = 1;
+	}
+
+	co->id = m_NextId;
+	co->amx = amx;
+	co->func = func;
+	co->entryStk = amx->stk;
+	co->entryHea = amx->hea;
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		co->data.append(data[i]);
+	}
+
+	CCoroutine *coroutine = co.get();
+	m_Coroutines.append(ke::Move(co));
+
+	Run(coroutine);
+
+	return coroutine->id;
+}
+
+cell CCoroutineMngr::Yield(AMX *amx, CoroutineState state, float wakeTime)
+{
+	CCoroutine *co = m_Current;
+
+	if (!co || co->amx != amx)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Not called from a coroutine");
+		return 0;
+	}
+
+	if (!IsDirectCall(co))
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Coroutines can only yield from their own public, not from a public called by a native");
+		return 0;
+	}
+
+	if (co->cancelled)
+	{
+		amx_RaiseError(amx, AMX_ERR_EXIT);
+		return 0;
+	}
+
+	co->state = state;
+	co->wakeTime = wakeTime;
+	co->value = 0;
+
+	SaveRegisters(amx, co->regs);
+	SwitchFromCoroutine(co);
+
+	if (co->cancelled)
+	{
+		// Unwinds the public, and the native stack with it
+		amx_RaiseError(amx, AMX_ERR_EXIT);
+		return 0;
+	}
+
+	return co->value;
+}
+
+bool CCoroutineMngr::Resume(int id, cell value)
+{
+	CCoroutine *co = Find(id);
+
+	if (!co || co->cancelled || (co->state != Coroutine_Sleeping && co->state != Coroutine_Waiting))
+	{
+		return false;
+	}
+
+	co->state = Coroutine_Ready;
+	co->value = value;
+
+	return true;
+}
+
+bool CCoroutineMngr::Cancel(int id)
+{
+	CCoroutine *co = Find(id);
+
+	if (!co || co->cancelled || co->state == Coroutine_Done)
+	{
+		return false;
+	}
+
+	co->cancelled = true;
+
+	// A running coroutine is stopped when it yields next
+	if (co->state != Coroutine_Running)
+	{
+		Run(co);
+	}
+
+	return true;
+}
+
+void CCoroutineMngr::RunFrame(float time)
+{
+	if (m_Coroutines.empty())
+	{
+		return;
+	}
+
+	// Coroutines started from this frame wait for the next one
+	size_t count = m_Coroutines.length();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		CCoroutine *co = m_Coroutines[i].get();
+
+		if (co->state != Coroutine_Ready && (co->state != Coroutine_Sleeping || co->wakeTime > time))
+		{
+			continue;
+		}
+
+		CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(co->amx);
+
+		if (!plugin || !plugin->isValid())
+		{
+			co->cancelled = true;
+		}
+		else if (plugin->isPaused())
+		{
+			continue;
+		}
+
+		Run(co);
+	}
+
+	for (size_t i = m_Coroutines.length(); i-- > 0; )
+	{
+		if (m_Coroutines[i]->state == Coroutine_Done)
+		{
+			m_Coroutines.remove(i);
+		}
+	}
+}
+
+void CCoroutineMngr::Clear()
+{
+	for (size_t i = 0; i < m_Coroutines.length(); ++i)
+	{
+		CCoroutine *co = m_Coroutines[i].get();
+
+		if (co->state != Coroutine_Done && co->state != Coroutine_Running)
+		{
+			co->cancelled = true;
+			Run(co);
+		}
+	}
+
+	m_Coroutines.clear();
+	m_Current = nullptr;
+}
+
+CCoroutineMngr::CCoroutine *CCoroutineMngr::Find(int id)
+{
+	for (size_t i = 0; i < m_Coroutines.length(); ++i)
+	{
+		if (m_Coroutines[i]->id == id)
+		{
+			return m_Coroutines[i].get();
+		}
+	}
+
+	return nullptr;
+}
+
+bool CCoroutineMngr::Run(CCoroutine *co)
+{
+	AMX *amx = co->amx;
+	bool restore = co->started && !co->cancelled;
+
+	// Its region is put back where it was, the plugin mustn't be executing there.
+	// Cancelling doesn't need it, the execution is aborted without touching memory.
+	if (restore && (amx->stk < co->entryStk || amx->hea > co->entryHea))
+	{
+		return false;
+	}
+
+	Registers outer;
+	SaveRegisters(amx, outer);
+
+	if (co->started)
+	{
+		if (restore)
+		{
+			RestoreRegion(co);
+		}
+
+		LoadRegisters(amx, co->regs);
+	}
+
+	Debugger *pDebugger = (Debugger *)amx->userdata[UD_DEBUGGER];
+
+	if (pDebugger && co->tracer)
+	{
+		pDebugger->ResumeExec(co->tracer);
+		co->tracer = nullptr;
+	}
+
+	CCoroutine *previous = m_Current;
+
+	m_Current = co;
+	co->state = Coroutine_Running;
+	co->started = true;
+
+	{
+		ProfilerScope profile(amx, co->func);
+		AMX *caller = g_HandleStats.EnterNative(amx);
+
+		SwitchToCoroutine(co);
+
+		g_HandleStats.LeaveNative(caller);
+	}
+
+	m_Current = previous;
+
+	if (co->state == Coroutine_Done)
+	{
+		DestroyFiberContext(co->context);
+		co->context = nullptr;
+	}
+	else
+	{
+		if (pDebugger)
+		{
+			co->tracer = pDebugger->SuspendExec();
+		}
+
+		SaveRegion(co);
+	}
+
+	LoadRegisters(amx, outer);
+
+	return true;
+}
+
+void CCoroutineMngr::Execute(CCoroutine *co)
+{
+	AMX *amx = co->amx;
+	Debugger *pDebugger = (Debugger *)amx->userdata[UD_DEBUGGER];
+
+	if (pDebugger)
+	{
+		pDebugger->BeginExec();
+	}
+
+	cell address = 0;
+
+	if (co->data.length())
+	{
+		cell *physAddress;
+		amx_PushArray(amx, &address, &physAddress, co->data.buffer(), co->data.length());
+	}
+
+	co->data.clear();
+
+	// amx_Exec pushes the parameter count and a return address, then the public its frame
+	co->baseFrm = amx->stk - 3 * sizeof(cell);
+
+	cell retval = 0;
+	int err = amx_Exec(amx, &retval, co->func);
+
+	if (err != AMX_ERR_NONE && err != AMX_ERR_EXIT)
+	{
+		//Did something else set an error?
+		if (pDebugger && pDebugger->ErrorExists())
+		{
+			//we don't care, something else logged the error.
+		}
+		else if (err != -1)
+		{
+			LogError(amx, err, NULL);
+		}
+	}
+
+	if (pDebugger)
+	{
+		pDebugger->EndExec();
+	}
+
+	amx->error = AMX_ERR_NONE;
+
+	if (address)
+	{
+		amx_Release(amx, address);
+	}
+
+	co->state = Coroutine_Done;
+}
+
+bool CCoroutineMngr::IsDirectCall(CCoroutine *co)
+{
+	AMX *amx = co->amx;
+	unsigned char *data = GetData(amx);
+	cell frm = amx->frm;
+
+	// Walks the frames up to the first one of the innermost execution, which saved a null frame
+	while (frm >= amx->stk && frm < co->entryStk)
+	{
+		cell previous = *reinterpret_cast<cell *>(data + frm);
+
+		if (!previous)
+		{
+			return frm == co->baseFrm;
+		}
+
+		if (previous <= frm)
+		{
+			break;
+		}
+
+		frm = previous;
+	}
+
+	return false;
+}
+
+void CCoroutineMngr::SaveRegion(CCoroutine *co)
+{
+	size_t stackCells = (co->entryStk - co->regs.stk) / sizeof(cell);
+	size_t heapCells = (co->regs.hea - co->entryHea) / sizeof(cell);
+
+	if (stackCells + heapCells > co->savedCapacity)
+	{
+		delete [] co->saved;
+
+		co->savedCapacity = stackCells + heapCells;
+		co->saved = new cell[co->savedCapacity];
+	}
+
+	unsigned char *data = GetData(co->amx);
+
+	memcpy(co->saved, data + co->regs.stk, stackCells * sizeof(cell));
+	memcpy(co->saved + stackCells, data + co->entryHea, heapCells * sizeof(cell));
+}
+
+void CCoroutineMngr::RestoreRegion(CCoroutine *co)
+{
+	size_t stackCells = (co->entryStk - co->regs.stk) / sizeof(cell);
+	size_t heapCells = (co->regs.hea - co->entryHea) / sizeof(cell);
+
+	unsigned char *data = GetData(co->amx);
+
+	memcpy(data + co->regs.stk, co->saved, stackCells * sizeof(cell));
+	memcpy(data + co->entryHea, co->saved + stackCells, heapCells * sizeof(cell));
+}
+
+void CCoroutineMngr::SaveRegisters(AMX *amx, Registers &regs)
+{
+	regs.cip = amx->cip;
+	regs.frm = amx->frm;
+	regs.hea = amx->hea;
+	regs.stk = amx->stk;
+	regs.pri = amx->pri;
+	regs.alt = amx->alt;
+	regs.reset_stk = amx->reset_stk;
+	regs.reset_hea = amx->reset_hea;
+	regs.error = amx->error;
+}
+
+void CCoroutineMngr::LoadRegisters(AMX *amx, const Registers &regs)
+{
+	amx->cip = regs.cip;
+	amx->frm = regs.frm;
+	amx->hea = regs.hea;
+	amx->stk = regs.stk;
+	amx->pri = regs.pri;
+	amx->alt = regs.alt;
+	amx->reset_stk = regs.reset_stk;
+	amx->reset_hea = regs.reset_hea;
+	amx->error = regs.error;
+}
+
+unsigned char *CCoroutineMngr::GetData(AMX *amx)
+{
+	return amx->data ? amx->data : amx->base + (int)((AMX_HEADER *)amx->base)->dat;
+}
@@ -0,0 +1,138 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_CCOROUTINE_H_
+#define _INCLUDE_CCOROUTINE_H_
+
+#include "amx.h"
+#include "debugger.h"
+#include <amtl/am-vector.h>
+#include <amtl/am-autoptr.h>
+
+enum CoroutineState
+{
+	Coroutine_Running,		// Executing, or waiting for a coroutine it started or resumed
+	Coroutine_Sleeping,		// Yielded, resumed once its wake time is reached
+	Coroutine_Waiting,		// Suspended until coroutine_resume() or an async native resumes it
+	Coroutine_Ready,		// Resumed, runs again on the next frame
+	Coroutine_Done,
+};
+
+/**
+ * Publics which can suspend themselves and be resumed on a later frame.
+ *
+ * The JIT keeps the return addresses of Pawn calls on the native stack, so execution can't be
+ * restarted from a saved CIP like the interpreter does with AMX_ERR_SLEEP. A coroutine runs
+ * on a native stack of its own instead (a fiber on Windows, a ucontext elsewhere), which
+ * keeps amx_Exec suspended as is, and works the same with the JIT and the interpreter.
+ *
+ * While a coroutine is suspended, other publics of its plugin reuse the AMX stack and heap.
+ * The part it uses, between its entry STK/HEA and the registers it yielded with, is saved
+ * aside and put back at the same addresses when it resumes. This requires the plugin not to
+ * be executing below that point, which is always the case at the start of a frame, where
+ * coroutines are resumed.
+ *
+ * Coroutines can only yield from their own public, not from a public called by a native
+ * they use: cancelling one, when its plugin is unloaded, makes the yield abort the execution
+ * with AMX_ERR_EXIT, which unwinds the native stack through amx_Exec.
+ */
+class CCoroutineMngr
+{
+public:
+	static const size_t StackSize = 256 * 1024;	// Native stack of each coroutine
+
+	struct Registers
+	{
+		cell cip, frm, hea, stk, pri, alt;
+		cell reset_stk, reset_hea;
+		int error;
+	};
+
+	struct FiberContext;
+
+	class CCoroutine
+	{
+	public:
+		CCoroutine();
+		~CCoroutine();
+
+	public:
+		int id;
+		AMX *amx;
+		int func;
+		ke::Vector<cell> data;		// Passed to the public when started
+
+		CoroutineState state;
+		bool started;
+		bool cancelled;
+		float wakeTime;
+		cell value;					// Returned by the yield once resumed
+
+		cell entryStk;				// Region owned by the coroutine, saved while suspended
+		cell entryHea;
+		cell baseFrm;				// Frame of its public
+		Registers regs;
+		cell *saved;
+		size_t savedCapacity;
+
+		Debugger::Tracer *tracer;	// Debugger call stack while suspended
+		FiberContext *context;
+	};
+
+public:
+	CCoroutineMngr();
+	~CCoroutineMngr();
+
+public:
+	// Starts a public as a coroutine, runs it until it yields or ends
+	int Start(AMX *amx, int func, const cell *data, size_t length);
+
+	// Suspends the running coroutine of amx, returns the value it's resumed with
+	cell Yield(AMX *amx, CoroutineState state, float wakeTime);
+
+	// Resumes a sleeping or waiting coroutine on the next frame
+	bool Resume(int id, cell value);
+
+	bool Cancel(int id);
+
+	inline int GetCurrent(AMX *amx) const
+	{
+		return (m_Current && m_Current->amx == amx) ? m_Current->id : 0;
+	}
+
+	void RunFrame(float time);
+
+	// Cancels all coroutines, must be called before plugins are unloaded
+	void Clear();
+
+private:
+	CCoroutine *Find(int id);
+	bool Run(CCoroutine *co);
+	bool IsDirectCall(CCoroutine *co);
+	void SaveRegion(CCoroutine *co);
+	void RestoreRegion(CCoroutine *co);
+
+	static void SaveRegisters(AMX *amx, Registers &regs);
+	static void LoadRegisters(AMX *amx, const Registers &regs);
+	static unsigned char *GetData(AMX *amx);
+
+public:
+	// Entry point of the coroutines' native stack
+	void Execute(CCoroutine *co);
+
+private:
+	ke::Vector<ke::AutoPtr<CCoroutine>> m_Coroutines;
+	CCoroutine *m_Current;
+	int m_NextId;
+};
+
+extern CCoroutineMngr g_Coroutines;
+extern AMX_NATIVE_INFO g_CoroutineNatives[];
+
+#endif // _INCLUDE_CCOROUTINE_H_
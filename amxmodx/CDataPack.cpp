@@ -30,6 +30,7 @@
 #include "CDataPack.h"
 
 #define DATAPACK_INITIAL_SIZE 64
+#define DATAPACK_MAX_RESERVE  (1 << 24)
 
 CDataPack::CDataPack()
 {
@@ -38,6 +39,35 @@ CDataPack::CDataPack()
 	Initialize();
 }
 
+CDataPack::CDataPack(size_t cells)
+{
+	size_t capacity = DATAPACK_INITIAL_SIZE;
+	size_t cellsize = sizeof(char) + sizeof(size_t) + sizeof(cell);
+
+	if (cells > capacity / cellsize)
+	{
+		// A hint, not a limit; anything past this grows as usual.
+		capacity = cells < DATAPACK_MAX_RESERVE / cellsize ? cells * cellsize : DATAPACK_MAX_RESERVE;
+	}
+
+	m_pBase = (char *)malloc(capacity);
+	m_capacity = capacity;
+	Initialize();
+}
+
+CDataPack::CDataPack(CDataPack &&other)
+{
+	m_pBase = other.m_pBase;
+	m_curptr = other.m_curptr;
+	m_capacity = other.m_capacity;
+	m_size = other.m_size;
+
+	// Left empty, the next write allocates.
+	other.m_pBase = nullptr;
+	other.m_capacity = 0;
+	other.Initialize();
+}
+
 CDataPack::~CDataPack()
 {
 	free(m_pBase);
@@ -57,10 +87,16 @@ void CDataPack::CheckSize(size_t typesize)
 	}
 
 	size_t pos = m_curptr - m_pBase;
-	do
+
+	if (!m_capacity)
+	{
+		m_capacity = DATAPACK_INITIAL_SIZE;
+	}
+
+	while (pos + typesize > m_capacity)
 	{
 		m_capacity *= 2;
-	} while (pos + typesize > m_capacity);
+	}
 
 	m_pBase = (char *)realloc(m_pBase, m_capacity);
 	m_curptr = m_pBase + pos;
@@ -146,6 +182,39 @@ void CDataPack::PackString(const char *string)
 	m_size += maxsize;
 }
 
+void CDataPack::PackArray(char type, const cell *cells, size_t count)
+{
+	size_t maxsize = sizeof(char) + sizeof(size_t) + sizeof(cell) * count;
+	CheckSize(maxsize);
+
+	*(char *)m_curptr = type;
+	m_curptr += sizeof(char);
+
+	// The number of cells, not bytes, so it can be checked against the reader's buffer.
+	*(size_t *)m_curptr = count;
+	m_curptr += sizeof(size_t);
+
+	memcpy(m_curptr, cells, sizeof(cell) * count);
+	m_curptr += sizeof(cell) * count;
+
+	m_size += maxsize;
+}
+
+void CDataPack::PackCellArray(const cell *cells, size_t count)
+{
+	PackArray(DataPackType::Cells, cells, count);
+}
+
+void CDataPack::PackFloatArray(const cell *floats, size_t count)
+{
+	PackArray(DataPackType::Floats, floats, count);
+}
+
+void CDataPack::ReserveStrings(size_t count, size_t length)
+{
+	CheckSize(count * (sizeof(char) + sizeof(size_t) + 1) + length);
+}
+
 void CDataPack::Reset() const
 {
 	m_curptr = m_pBase;
@@ -156,6 +225,11 @@ size_t CDataPack::GetPosition() const
 	return static_cast<size_t>(m_curptr - m_pBase);
 }
 
+size_t CDataPack::GetCapacity() const
+{
+	return m_capacity;
+}
+
 bool CDataPack::SetPosition(size_t pos) const
 {
 	if (pos > m_size-1)
@@ -287,6 +361,88 @@ const char *CDataPack::ReadString(size_t *len) const
 	return str;
 }
 
+bool CDataPack::CanReadStrings(size_t count) const
+{
+	char *start = m_curptr;
+	bool readable = true;
+
+	for (size_t i = 0; i < count && readable; ++i)
+	{
+		readable = ReadString(NULL) != NULL;
+	}
+
+	m_curptr = start;
+
+	return readable;
+}
+
+bool CDataPack::CanReadArray(char type, size_t *count) const
+{
+	if (!IsReadable(sizeof(char) + sizeof(size_t)))
+	{
+		return false;
+	}
+	if (*reinterpret_cast<char *>(m_curptr) != type)
+	{
+		return false;
+	}
+
+	size_t cellcount = *(size_t *)(m_curptr + sizeof(char));
+	if (cellcount > m_size / sizeof(cell) || !IsReadable(sizeof(char) + sizeof(size_t) + sizeof(cell) * cellcount))
+	{
+		return false;
+	}
+
+	if (count)
+	{
+		*count = cellcount;
+	}
+
+	return true;
+}
+
+const cell *CDataPack::ReadArray(char type, size_t *count) const
+{
+	size_t cellcount;
+	if (!CanReadArray(type, &cellcount))
+	{
+		return NULL;
+	}
+
+	m_curptr += sizeof(char);
+	m_curptr += sizeof(size_t);
+
+	const cell *cells = reinterpret_cast<cell *>(m_curptr);
+	m_curptr += sizeof(cell) * cellcount;
+
+	if (count)
+	{
+		*count = cellcount;
+	}
+
+	return cells;
+}
+
+bool CDataPack::CanReadCellArray(size_t *count) const
+{
+	return CanReadArray(DataPackType::Cells, count);
+}
+
+const cell *CDataPack::ReadCellArray(size_t *count) const
+{
+	return ReadArray(DataPackType::Cells, count);
+}
+
+bool CDataPack::CanReadFloatArray(size_t *count) const
+{
+	return CanReadArray(DataPackType::Floats, count);
+}
+
+const cell *CDataPack::ReadFloatArray(size_t *count) const
+{
+	return ReadArray(DataPackType::Floats, count);
+}
+
 void *CDataPack::GetMemory() const
 {
 	return m_curptr;
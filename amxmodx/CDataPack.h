@@ -42,6 +42,20 @@ public:
 	CDataPack();
 	~CDataPack();
 
+	/**
+	 * @brief Creates a stream with room for a number of cells up front.
+	 *
+	 * @param cells		Number of packed cells to reserve room for.
+	 */
+	explicit CDataPack(size_t cells);
+
+	/**
+	 * @brief Takes over the stream of another pack, leaving it empty.
+	 *
+	 * @param other		Pack to move the stream from.
+	 */
+	CDataPack(CDataPack &&other);
+
 public:
 	/**
 	 * @brief Resets the position in the data stream to the beginning.
@@ -55,6 +69,13 @@ public:
 	 */
 	size_t GetPosition() const;
 
+	/**
+	 * @brief Retrieves the memory allocated for the data stream.
+	 *
+	 * @return			Size in bytes.
+	 */
+	size_t GetCapacity() const;
+
 	/**
 	 * @brief Sets the current stream position.
 	 *
@@ -109,10 +130,37 @@ public:
 	 */
 	void *ReadMemory(size_t *size) const;
 
+	/**
+	 * @brief Reads an array of cells from the data stream.
+	 *
+	 * @param count		Optional pointer to store the number of cells.
+	 * @return			Pointer to the cells, or NULL if out of bounds.
+	 */
+	const cell *ReadCellArray(size_t *count) const;
+
+	/**
+	 * @brief Reads an array of floats from the data stream.
+	 *
+	 * @param count		Optional pointer to store the number of floats.
+	 * @return			Pointer to the floats, or NULL if out of bounds.
+	 */
+	const cell *ReadFloatArray(size_t *count) const;
+
 	bool CanReadCell() const;
 	bool CanReadFloat() const;
 	bool CanReadString(size_t *len) const;
 	bool CanReadMemory(size_t *size) const;
+	bool CanReadCellArray(size_t *count) const;
+	bool CanReadFloatArray(size_t *count) const;
+
+	/**
+	 * @brief Returns whether a number of strings can be read in a row from the
+	 *  current stream position, without moving it.
+	 *
+	 * @param count		Number of strings to check.
+	 * @return			True if all of them can be read, false otherwise.
+	 */
+	bool CanReadStrings(size_t count) const;
 
 public:
 	/**
@@ -142,6 +190,31 @@ public:
 	 */
 	void PackString(const char *string);
 
+	/**
+	 * @brief Packs an array of cells into the data stream as a single entry.
+	 *
+	 * @param cells		Cells to write.
+	 * @param count		Number of cells.
+	 */
+	void PackCellArray(const cell *cells, size_t count);
+
+	/**
+	 * @brief Packs an array of floats into the data stream as a single entry.
+	 *
+	 * @param floats	Floats to write, as cells.
+	 * @param count		Number of floats.
+	 */
+	void PackFloatArray(const cell *floats, size_t count);
+
+	/**
+	 * @brief Makes room for a number of strings so they can be packed one after
+	 *  another without growing the stream in between.
+	 *
+	 * @param count		Number of strings.
+	 * @param length	Total length of the strings, terminators excluded.
+	 */
+	void ReserveStrings(size_t count, size_t length);
+
 	/**
 	 * @brief Creates a generic block of memory in the stream.
 	 *
@@ -160,6 +233,9 @@ public:
 
 private:
 	void CheckSize(size_t sizetype);
+	void PackArray(char type, const cell *cells, size_t count);
+	bool CanReadArray(char type, size_t *count) const;
+	const cell *ReadArray(char type, size_t *count) const;
 
 private:
 	char *m_pBase;
@@ -172,6 +248,8 @@ private:
 		Cell,
 		Float,
 		String,
+		Cells,
+		Floats,
 	};
 };
 
@@ -0,0 +1,250 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#include "amxmodx.h"
+#include "CHandleStats.h"
+#include "datastructs.h"
+#include "trie_natives.h"
+#include "CDataPack.h"
+#include "textparse.h"
+#include "gameconfigs.h"
+#include "hashnatives.h"
+#include "newmenus.h"
+
+CHandleStats g_HandleStats;
+
+CHandleStats::CHandleStats() : m_Caller(nullptr)
+{
+}
+
+int CHandleStats::GetCallingPlugin()
+{
+	if (!m_Caller)
+	{
+		return -1;
+	}
+
+	CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(m_Caller);
+
+	return plugin ? plugin->getId() : -1;
+}
+
+void CHandleStats::AddReporter(HANDLE_REPORTER reporter)
+{
+	m_Reporters.append(reporter);
+}
+
+void CHandleStats::RemoveReporter(HANDLE_REPORTER reporter)
+{
+	for (size_t i = 0; i < m_Reporters.length(); ++i)
+	{
+		if (m_Reporters[i] == reporter)
+		{
+			m_Reporters.remove(i);
+			return;
+		}
+	}
+}
+
+void CHandleStats::Report::AddHandle(const char *type, int plugin, size_t bytes)
+{
+	char key[128];
+	ke::SafeSprintf(key, sizeof(key), "%d:%s", plugin, type);
+
+	StringHashMap<Usage>::Insert i = usage.findForAdd(key);
+
+	if (!i.found())
+	{
+		if (!usage.add(i, key))
+		{
+			return;
+		}
+
+		i->value.type = type;
+		i->value.plugin = plugin;
+		i->value.count = 0;
+		i->value.bytes = 0;
+	}
+
+	++i->value.count;
+	i->value.bytes += bytes;
+
+	if (plugin >= 0)
+	{
+		while (plugins.length() <= static_cast<size_t>(plugin))
+		{
+			plugins.append(0);
+		}
+
+		++plugins[plugin];
+	}
+}
+
+template <typename T, typename F>
+static void ReportHandles(IHandleReport *report, const char *type, NativeHandle<T> &handles, F bytes)
+{
+	for (size_t i = 0; i < handles.size(); ++i)
+	{
+		T *object = handles.slot(i);
+
+		if (object)
+		{
+			report->AddHandle(type, handles.owner(i), bytes(object));
+		}
+	}
+}
+
+void CHandleStats::Collect(Report &report)
+{
+	ReportHandles(&report, "Array", ArrayHandles, [](CellArray *array) { return sizeof(CellArray) + array->mem_usage(); });
+	ReportHandles(&report, "Trie", TrieHandles, [](CellTrie *trie) { return sizeof(CellTrie) + trie->map.mem_usage(); });
+	ReportHandles(&report, "Trie Iterator", TrieIterHandles, [](CellTrieIter *) { return sizeof(CellTrieIter); });
+	ReportHandles(&report, "Trie Snapshot", TrieSnapshotHandles, [](TrieSnapshot *snapshot) { return sizeof(TrieSnapshot) + snapshot->mem_usage(); });
+	ReportHandles(&report, "DataPack", DataPackHandles, [](CDataPack *pack) { return sizeof(CDataPack) + pack->GetCapacity(); });
+	ReportHandles(&report, "Text Parser", TextParsersHandles, [](ParseInfo *) { return sizeof(ParseInfo); });
+	ReportHandles(&report, "Game Config", GameConfigHandle, [](GameConfigNative *) { return sizeof(GameConfigNative); });
+	ReportHandles(&report, "Hash", HashHandles, [](Hasher *) { return sizeof(Hasher); });
+	ReportHandles(&report, "Event Hook", EventHandles, [](EventHook *) { return sizeof(EventHook); });
+	ReportHandles(&report, "Log Event Hook", LogEventHandles, [](LogEventHook *) { return sizeof(LogEventHook); });
+
+	for (size_t i = 0; i < g_NewMenus.length(); ++i)
+	{
+		Menu *menu = g_NewMenus[i];
+
+		if (menu)
+		{
+			CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(menu->amx);
+			report.AddHandle("Menu", plugin ? plugin->getId() : -1, sizeof(Menu) + menu->m_Items.length() * sizeof(menuitem));
+		}
+	}
+
+	for (size_t i = 0; i < m_Reporters.length(); ++i)
+	{
+		m_Reporters[i](&report);
+	}
+}
+
+void CHandleStats::OnMapEnd()
+{
+	Report report;
+	Collect(report);
+
+	for (CPluginMngr::iterator iter = g_plugins.begin(); iter; ++iter)
+	{
+		CPluginMngr::CPlugin *plugin = &(*iter);
+		size_t id = static_cast<size_t>(plugin->getId());
+		size_t count = id < report.plugins.length() ? report.plugins[id] : 0;
+
+		StringHashMap<Growth>::Insert i = m_Growth.findForAdd(plugin->getName());
+
+		if (!i.found())
+		{
+			if (m_Growth.add(i, plugin->getName()))
+			{
+				i->value.count = count;
+				i->value.maps = 0;
+			}
+
+			continue;
+		}
+
+		Growth &growth = i->value;
+
+		growth.maps = count > growth.count ? growth.maps + 1 : 0;
+		growth.count = count;
+
+		if (growth.maps >= GrowthWarning)
+		{
+			AMXXLOG_Log("[AMXX] Plugin \"%s\" ended the last %u maps with more live handles each time (%u now), it may be leaking them. See \"amxx handles\".",
+						plugin->getName(), (unsigned int)growth.maps, (unsigned int)count);
+		}
+	}
+}
+
+void CHandleStats::OnConsoleCommand()
+{
+	// amxx handles           <- live handles by type and plugin, and plugins' memory peaks
+	// amxx handles <plugin>  <- same, for the plugins whose name starts with the given text
+
+	const char *filter = CMD_ARGC() > 2 ? CMD_ARGV(2) : "";
+	size_t filterLength = strlen(filter);
+
+	Report report;
+	Collect(report);
+
+	ke::Vector<const Usage *> entries;
+
+	for (StringHashMap<Usage>::iterator iter = report.usage.iter(); !iter.empty(); iter.next())
+	{
+		const Usage &usage = iter->value;
+		CPluginMngr::CPlugin *plugin = usage.plugin >= 0 ? g_plugins.findPlugin(usage.plugin) : nullptr;
+
+		if (filterLength && (!plugin || strncmp(plugin->getName(), filter, filterLength)))
+		{
+			continue;
+		}
+
+		entries.append(&usage);
+	}
+
+	qsort(entries.buffer(), entries.length(), sizeof(const Usage *), [](const void *a, const void *b) -> int
+	{
+		size_t bytesA = (*static_cast<const Usage * const *>(a))->bytes;
+		size_t bytesB = (*static_cast<const Usage * const *>(b))->bytes;
+
+		return bytesA < bytesB ? 1 : (bytesA > bytesB ? -1 : 0);
+	});
+
+	size_t count = 0, bytes = 0;
+
+	print_srvconsole("Live handles:\n");
+	print_srvconsole("       %-16.15s %-24.23s %8s %12s\n", "type", "plugin", "count", "bytes");
+
+	for (size_t i = 0; i < entries.length(); ++i)
+	{
+		const Usage *usage = entries[i];
+		CPluginMngr::CPlugin *plugin = usage->plugin >= 0 ? g_plugins.findPlugin(usage->plugin) : nullptr;
+
+		if (usage->bytes)
+		{
+			print_srvconsole(" [%3u] %-16.15s %-24.23s %8u %12u\n", (unsigned int)(i + 1), usage->type.chars(),
+							 plugin ? plugin->getName() : "-", (unsigned int)usage->count, (unsigned int)usage->bytes);
+		}
+		else
+		{
+			print_srvconsole(" [%3u] %-16.15s %-24.23s %8u %12s\n", (unsigned int)(i + 1), usage->type.chars(),
+							 plugin ? plugin->getName() : "-", (unsigned int)usage->count, "?");
+		}
+
+		count += usage->count;
+		bytes += usage->bytes;
+	}
+
+	print_srvconsole("%u handles, %u bytes known.\n\n", (unsigned int)count, (unsigned int)bytes);
+
+	print_srvconsole("Plugin memory (bytes):\n");
+	print_srvconsole("       %-24.23s %12s %12s %12s\n", "plugin", "stack peak", "heap peak", "available");
+
+	for (CPluginMngr::iterator iter = g_plugins.begin(); iter; ++iter)
+	{
+		CPluginMngr::CPlugin *plugin = &(*iter);
+
+		if (!plugin->isValid() || (filterLength && strncmp(plugin->getName(), filter, filterLength)))
+		{
+			continue;
+		}
+
+		AMX *amx = plugin->getAMX();
+
+		print_srvconsole(" [%3d] %-24.23s %12d %12d %12d\n", plugin->getId(), plugin->getName(),
+						 plugin->getStackPeak(), plugin->getHeapPeak(), amx->stp - amx->hlw);
+	}
+
+	print_srvconsole("Usage: amxx handles [ plugin ]\n");
+}
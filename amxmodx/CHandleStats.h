@@ -0,0 +1,96 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_CHANDLESTATS_H_
+#define _INCLUDE_CHANDLESTATS_H_
+
+#include "amx.h"
+#include <IHandleStats.h>
+#include <amtl/am-vector.h>
+#include <amtl/am-string.h>
+#include <sm_stringhashmap.h>
+
+/**
+ * Per-plugin accounting of live handles, shown by "amxx handles".
+ *
+ * Handles are attributed to the plugin whose native created them, tracked by amx_Callback.
+ * The core's handle tables and menus are walked directly, modules add theirs through
+ * IHandleStats reporters. Nothing is counted until a report is requested, so keeping the
+ * owner of each handle is the only runtime cost.
+ *
+ * Core handles are freed on map change, but a plugin ending several maps in a row with more
+ * of them, or with module handles which persist, is likely leaking: this is logged.
+ */
+class CHandleStats : public IHandleStats
+{
+public:
+	static const size_t GrowthWarning = 3;  // Maps in a row a plugin's handle count grew
+
+public:
+	CHandleStats();
+
+public: // IHandleStats
+	int GetCallingPlugin() override;
+	void AddReporter(HANDLE_REPORTER reporter) override;
+	void RemoveReporter(HANDLE_REPORTER reporter) override;
+
+public:
+	inline AMX *EnterNative(AMX *amx)
+	{
+		AMX *caller = m_Caller;
+		m_Caller = amx;
+
+		return caller;
+	}
+
+	inline void LeaveNative(AMX *caller)
+	{
+		m_Caller = caller;
+	}
+
+	// Called before plugins are unloaded and core handles freed
+	void OnMapEnd();
+	void OnConsoleCommand();
+
+private:
+	struct Usage
+	{
+		ke::AString type;
+		int plugin;
+		size_t count;
+		size_t bytes;
+	};
+
+	class Report : public IHandleReport
+	{
+	public:
+		void AddHandle(const char *type, int plugin, size_t bytes) override;
+
+	public:
+		StringHashMap<Usage> usage;
+		ke::Vector<size_t> plugins;   // Live handles by plugin id
+	};
+
+	struct Growth
+	{
+		size_t count;
+		size_t maps;
+	};
+
+	void Collect(Report &report);
+
+private:
+	AMX *m_Caller;
+	ke::Vector<HANDLE_REPORTER> m_Reporters;
+	StringHashMap<Growth> m_Growth;  // By plugin filename, plugin ids change across maps
+};
+
+extern CHandleStats g_HandleStats;
+
+#endif // _INCLUDE_CHANDLESTATS_H_
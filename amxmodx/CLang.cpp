@@ -224,6 +224,7 @@ int CLangMngr::CLang::Entries()
 
 CLangMngr::CLangMngr()
 {
+	m_Generation = 0;
 	Clear();
 }
 
@@ -517,6 +518,8 @@ CLangMngr::CLang * CLangMngr::GetLang(const char *name)
 	p->SetMngr(this);
 
 	m_Languages.append(p);
+	++m_Generation;
+
 	return p;
 }
 
@@ -550,6 +553,22 @@ const char *CLangMngr::GetDef(const char *langName, const char *key, int &status
 	}
 }
 
+const char *CLangMngr::GetDef(int langId, int key, int &status)
+{
+	if (langId < 0 || langId >= static_cast<int>(m_Languages.length()))
+	{
+		status = ERR_BADLANG;
+		return nullptr;
+	}
+	else if (key < 0 || key >= static_cast<int>(KeyList.length()))
+	{
+		status = ERR_BADKEY;
+		return nullptr;
+	}
+
+	return m_Languages[langId]->GetDef(key, status);
+}
+
 void CLangMngr::InvalidateCache()
 {
 	FileList.clear();
@@ -581,6 +600,8 @@ void CLangMngr::Clear()
 	m_Languages.clear();
 	KeyList.clear();
 	FileList.clear();
+
+	++m_Generation;
 }
 
 int CLangMngr::GetLangsNum()
@@ -622,6 +643,19 @@ bool CLangMngr::LangExists(const char *langName)
 	return false;
 }
 
+int CLangMngr::GetLangId(const char *langName)
+{
+	for (size_t iter = 0; iter < m_Languages.length(); ++iter)
+	{
+		if (strcmp(m_Languages[iter]->GetName(), langName) == 0)
+		{
+			return static_cast<int>(iter);
+		}
+	}
+
+	return -1;
+}
+
 void CLangMngr::SetDefLang(int id)
 {
 	m_CurGlobId = id;
@@ -130,11 +130,16 @@ private:
 
 	// Current global client-id for functions like client_print with first parameter 0
 	int m_CurGlobId;
+
+	// Bumped whenever cached language or key indexes may have become stale
+	unsigned int m_Generation;
 public:
 	// Merge a definitions file
 	int MergeDefinitionFile(const char *file);
 	// Get a definition from a lang name and a key
 	const char *GetDef(const char *langName, const char *key, int &status);
+	// Get a definition from a lang index and a key index
+	const char *GetDef(int langId, int key, int &status);
 	// Format a string for an AMX plugin
 	char *FormatAmxString(AMX *amx, cell *params, int parm, int &len);
 	void InvalidateCache();
@@ -153,6 +158,11 @@ public:
 	const char *GetLangName(int langId);
 	// Check if a language exists
 	bool LangExists(const char *langName);
+	// Get the index of a language, -1 if not found
+	int GetLangId(const char *langName);
+
+	// Lang and key indexes remain valid as long as this value doesn't change
+	inline unsigned int GetGeneration() const { return m_Generation; }
 
 	// When a language id in a format string in FormatAmxString is LANG_PLAYER, the glob id decides which language to take.
 	void SetDefLang(int id);
@@ -32,6 +32,9 @@ void CPlayer::Init(edict_t* e, int i)
 	menuexpire = 0.0;
 	newmenu = -1;
 
+	langId = -1;
+	langGeneration = 0;
+
 	death_weapon = nullptr;
 	name = nullptr;
 	ip = nullptr;
@@ -68,6 +71,24 @@ void CPlayer::PutInServer()
 	ingame = true;
 }
 
+int CPlayer::GetLanguageId()
+{
+	if (langGeneration != g_langMngr.GetGeneration())
+	{
+		UpdateLanguage();
+	}
+
+	return langId;
+}
+
+void CPlayer::UpdateLanguage()
+{
+	const char *lang = ENTITY_KEYVALUE(pEdict, "lang");
+
+	langId = (lang && isalpha(lang[0])) ? g_langMngr.GetLangId(lang) : -1;
+	langGeneration = g_langMngr.GetGeneration();
+}
+
 int CPlayer::NextHUDChannel()
 {
 	int ilow = 1;
@@ -96,6 +117,8 @@ bool CPlayer::Connect(const char* connectname, const char* ipaddress)
 	initialized = true;
 	authorized = false;
 
+	InvalidateLanguage();
+
 	for (int i=0; i<=4; i++)
 	{
 		channels[i] = 0.0f;
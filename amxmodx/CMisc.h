@@ -75,6 +75,9 @@ public:
 	
 	List<ClientCvarQuery_Info *> queries;
 
+	int langId;
+	unsigned int langGeneration;
+
 	void Init(edict_t* e, int i);
 	void Disconnect();
 	void PutInServer();
@@ -104,6 +107,11 @@ public:
 
 	inline void Authorize() { authorized = true; }
 
+	// Index of the client "lang" setinfo in the dictionary, -1 if unknown
+	int GetLanguageId();
+	void UpdateLanguage();
+	inline void InvalidateLanguage() { langGeneration = 0; }
+
 	int NextHUDChannel();
 
 };
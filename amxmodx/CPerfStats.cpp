@@ -0,0 +1,428 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#include "amxmodx.h"
+#include "CPerfStats.h"
+
+CPerfStats g_PerfStats;
+
+uint64_t PublicLatency::Percentile(double fraction) const
+{
+	if (!count)
+	{
+		return 0;
+	}
+
+	uint64_t rank = static_cast<uint64_t>(fraction * count + 0.5);
+	uint64_t seen = 0;
+
+	if (rank < 1)
+	{
+		rank = 1;
+	}
+
+	for (unsigned int i = 0; i < Buckets; ++i)
+	{
+		seen += buckets[i];
+
+		if (seen < rank)
+		{
+			continue;
+		}
+
+		if (i < SubBuckets * 2)
+		{
+			return i;
+		}
+
+		unsigned int bit = (i - SubBuckets * 2) / SubBuckets + SubBucketBits + 1;
+		unsigned int sub = (i - SubBuckets * 2) % SubBuckets;
+		unsigned int shift = bit - SubBucketBits;
+
+		// Middle of the bucket, the highest one holding the max at most
+		uint64_t value = (uint64_t(SubBuckets + sub) << shift) + (uint64_t(1) << (shift - 1));
+
+		return value < max ? value : max;
+	}
+
+	return max;
+}
+
+CPerfStats::CPerfStats() : m_ProfileNatives(false), m_StartTicks(Now()), m_StartTime(std::chrono::steady_clock::now())
+{
+}
+
+PublicLatency *CPerfStats::Create(int plugin, int index)
+{
+	while (m_Plugins.length() <= static_cast<size_t>(plugin))
+	{
+		m_Plugins.append(nullptr);
+	}
+
+	if (!m_Plugins[plugin])
+	{
+		m_Plugins[plugin] = ke::AutoPtr<ke::Vector<ke::AutoPtr<PublicLatency>>>(new ke::Vector<ke::AutoPtr<PublicLatency>>());
+	}
+
+	ke::Vector<ke::AutoPtr<PublicLatency>> &publics = *m_Plugins[plugin];
+
+	while (publics.length() <= static_cast<size_t>(index))
+	{
+		publics.append(nullptr);
+	}
+
+	// Only publics which are run get a histogram
+	PublicLatency *latency = new PublicLatency;
+	memset(latency, 0, sizeof(PublicLatency));
+
+	publics[index] = ke::AutoPtr<PublicLatency>(latency);
+
+	return latency;
+}
+
+void CPerfStats::RecordNative(AMX *amx, cell index, uint64_t ticks)
+{
+	CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(amx);
+
+	if (!plugin || index < 0)
+	{
+		return;
+	}
+
+	size_t id = static_cast<size_t>(plugin->getId());
+
+	while (m_Natives.length() <= id)
+	{
+		m_Natives.append(nullptr);
+	}
+
+	if (!m_Natives[id])
+	{
+		int count = 0;
+		amx_NumNatives(amx, &count);
+
+		NativeCalls empty = { 0, 0, 0 };
+		m_Natives[id] = ke::AutoPtr<ke::Vector<NativeCalls>>(new ke::Vector<NativeCalls>());
+
+		for (int i = 0; i < count; ++i)
+		{
+			m_Natives[id]->append(empty);
+		}
+	}
+
+	ke::Vector<NativeCalls> &natives = *m_Natives[id];
+
+	if (static_cast<size_t>(index) >= natives.length())
+	{
+		return;
+	}
+
+	NativeCalls &calls = natives[index];
+
+	++calls.count;
+	calls.total += ticks;
+
+	if (ticks > calls.max)
+	{
+		calls.max = ticks;
+	}
+}
+
+const PublicLatency *CPerfStats::Find(int plugin, int index) const
+{
+	if (plugin < 0 || static_cast<size_t>(plugin) >= m_Plugins.length() || !m_Plugins[plugin])
+	{
+		return nullptr;
+	}
+
+	const ke::Vector<ke::AutoPtr<PublicLatency>> &publics = *m_Plugins[plugin];
+
+	if (index < 0 || static_cast<size_t>(index) >= publics.length())
+	{
+		return nullptr;
+	}
+
+	return publics[index].get();
+}
+
+double CPerfStats::TicksToMicroseconds(uint64_t ticks) const
+{
+	using std::chrono::duration;
+	using std::chrono::steady_clock;
+
+	double elapsed = duration<double, std::micro>(steady_clock::now() - m_StartTime).count();
+	uint64_t elapsedTicks = Now() - m_StartTicks;
+
+	if (elapsed <= 0.0 || !elapsedTicks)
+	{
+		return 0.0;
+	}
+
+	return ticks * (elapsed / elapsedTicks);
+}
+
+void CPerfStats::Clear()
+{
+	m_Plugins.clear();
+	m_Natives.clear();
+}
+
+struct PerfEntry
+{
+	CPluginMngr::CPlugin *plugin;
+	int index;
+	const PublicLatency *latency;
+};
+
+static int ComparePerfEntries(const void *a, const void *b)
+{
+	uint64_t totalA = static_cast<const PerfEntry *>(a)->latency->total;
+	uint64_t totalB = static_cast<const PerfEntry *>(b)->latency->total;
+
+	return totalA < totalB ? 1 : (totalA > totalB ? -1 : 0);
+}
+
+struct NativeEntry
+{
+	CPluginMngr::CPlugin *plugin;
+	int index;
+	const NativeCalls *calls;
+};
+
+static int CompareNativeEntries(const void *a, const void *b)
+{
+	uint64_t totalA = static_cast<const NativeEntry *>(a)->calls->total;
+	uint64_t totalB = static_cast<const NativeEntry *>(b)->calls->total;
+
+	return totalA < totalB ? 1 : (totalA > totalB ? -1 : 0);
+}
+
+static void CollectNatives(const ke::Vector<ke::AutoPtr<ke::Vector<NativeCalls>>> &stats, ke::Vector<NativeEntry> &entries)
+{
+	for (CPluginMngr::iterator iter = g_plugins.begin(); iter; ++iter)
+	{
+		CPluginMngr::CPlugin *plugin = &(*iter);
+		size_t id = static_cast<size_t>(plugin->getId());
+
+		if (id >= stats.length() || !stats[id])
+		{
+			continue;
+		}
+
+		const ke::Vector<NativeCalls> &natives = *stats[id];
+
+		for (size_t i = 0; i < natives.length(); ++i)
+		{
+			if (natives[i].count)
+			{
+				NativeEntry entry = { plugin, static_cast<int>(i), &natives[i] };
+				entries.append(entry);
+			}
+		}
+	}
+
+	qsort(entries.buffer(), entries.length(), sizeof(NativeEntry), CompareNativeEntries);
+}
+
+static void GetNativeName(CPluginMngr::CPlugin *plugin, int index, char *name)
+{
+	if (amx_GetNative(plugin->getAMX(), index, name) != AMX_ERR_NONE)
+	{
+		ke::SafeSprintf(name, sNAMEMAX + 1, "native_%d", index);
+	}
+}
+
+bool CPerfStats::DumpNatives(const char *path, size_t *count)
+{
+	FILE *fp = fopen(path, "wt");
+
+	if (!fp)
+	{
+		return false;
+	}
+
+	ke::Vector<NativeEntry> entries;
+	CollectNatives(m_Natives, entries);
+
+	fprintf(fp, "plugin\tnative\tcalls\ttotal_us\tavg_us\tmax_us\n");
+
+	for (size_t i = 0; i < entries.length(); ++i)
+	{
+		const NativeEntry &entry = entries[i];
+		double total = TicksToMicroseconds(entry.calls->total);
+
+		char name[sNAMEMAX + 1];
+		GetNativeName(entry.plugin, entry.index, name);
+
+		fprintf(fp, "%s\t%s\t%u\t%.2f\t%.3f\t%.2f\n", entry.plugin->getName(), name, (unsigned int)entry.calls->count,
+				total, total / entry.calls->count, TicksToMicroseconds(entry.calls->max));
+	}
+
+	fclose(fp);
+
+	*count = entries.length();
+
+	return true;
+}
+
+void CPerfStats::OnNativesCommand()
+{
+	// amxx perf natives start        <- start counting native calls, results are kept
+	// amxx perf natives stop         <- stop counting
+	// amxx perf natives dump [file]  <- write every counted native to the logs directory
+	// amxx perf natives              <- show the natives taking the most time
+
+	const char *action = CMD_ARGC() > 3 ? CMD_ARGV(3) : "";
+
+	if (!strcmp(action, "start"))
+	{
+		m_ProfileNatives = true;
+		print_srvconsole("Native profiling started.\n");
+	}
+	else if (!strcmp(action, "stop"))
+	{
+		m_ProfileNatives = false;
+		print_srvconsole("Native profiling stopped.\n");
+	}
+	else if (!strcmp(action, "dump"))
+	{
+		const char *file = CMD_ARGC() > 4 ? CMD_ARGV(4) : "natives.tsv";
+
+		char path[PLATFORM_MAX_PATH];
+		build_pathname_r(path, sizeof(path), "%s/%s", g_log_dir.chars(), file);
+
+		size_t count;
+
+		if (!DumpNatives(path, &count))
+		{
+			print_srvconsole("Couldn't write native statistics to \"%s\".\n", path);
+			return;
+		}
+
+		print_srvconsole("Wrote %u natives to \"%s\".\n", (unsigned int)count, path);
+	}
+	else
+	{
+		ke::Vector<NativeEntry> entries;
+		CollectNatives(m_Natives, entries);
+
+		print_srvconsole("Native profiling is %s.\n", m_ProfileNatives ? "running" : "stopped");
+
+		size_t count = entries.length() < DefaultTop ? entries.length() : DefaultTop;
+
+		if (count)
+		{
+			print_srvconsole("Natives taking the most time (%u of %u):\n", (unsigned int)count, (unsigned int)entries.length());
+			print_srvconsole("       %-24.23s %-24.23s %10s %10s %9s %9s\n", "plugin", "native", "calls", "total ms", "avg us", "max us");
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const NativeEntry &entry = entries[i];
+				double total = TicksToMicroseconds(entry.calls->total);
+
+				char name[sNAMEMAX + 1];
+				GetNativeName(entry.plugin, entry.index, name);
+
+				print_srvconsole(" [%3u] %-24.23s %-24.23s %10u %10.2f %9.3f %9.2f\n",
+								 (unsigned int)(i + 1), entry.plugin->getName(), name, (unsigned int)entry.calls->count,
+								 total / 1000.0, total / entry.calls->count, TicksToMicroseconds(entry.calls->max));
+			}
+		}
+
+		print_srvconsole("Usage: amxx perf natives < start | stop | dump [ file ] >\n");
+	}
+}
+
+void CPerfStats::OnConsoleCommand()
+{
+	// amxx perf             <- show the publics taking the most time
+	// amxx perf <plugin>    <- same, for the plugins whose name starts with the given text
+	// amxx perf reset       <- clear statistics
+	// amxx perf natives     <- native profiling, see OnNativesCommand()
+
+	const char *filter = CMD_ARGC() > 2 ? CMD_ARGV(2) : "";
+
+	if (!strcmp(filter, "natives"))
+	{
+		OnNativesCommand();
+		return;
+	}
+
+	if (!strcmp(filter, "reset"))
+	{
+		Clear();
+		print_srvconsole("Performance statistics cleared.\n");
+		return;
+	}
+
+	size_t filterLength = strlen(filter);
+	ke::Vector<PerfEntry> entries;
+
+	for (CPluginMngr::iterator iter = g_plugins.begin(); iter; ++iter)
+	{
+		CPluginMngr::CPlugin *plugin = &(*iter);
+
+		if (filterLength && strncmp(plugin->getName(), filter, filterLength))
+		{
+			continue;
+		}
+
+		if (static_cast<size_t>(plugin->getId()) >= m_Plugins.length() || !m_Plugins[plugin->getId()])
+		{
+			continue;
+		}
+
+		const ke::Vector<ke::AutoPtr<PublicLatency>> &publics = *m_Plugins[plugin->getId()];
+
+		for (size_t i = 0; i < publics.length(); ++i)
+		{
+			if (publics[i] && publics[i]->count)
+			{
+				PerfEntry entry = { plugin, static_cast<int>(i), publics[i].get() };
+				entries.append(entry);
+			}
+		}
+	}
+
+	if (entries.empty())
+	{
+		print_srvconsole("No public has been executed%s.\n", filterLength ? " by these plugins" : "");
+		return;
+	}
+
+	qsort(entries.buffer(), entries.length(), sizeof(PerfEntry), ComparePerfEntries);
+
+	size_t count = entries.length() < DefaultTop ? entries.length() : DefaultTop;
+
+	print_srvconsole("Publics taking the most time (%u of %u):\n", (unsigned int)count, (unsigned int)entries.length());
+	print_srvconsole("       %-24.23s %-24.23s %10s %10s %9s %9s %9s %9s\n", "plugin", "public", "calls", "total ms", "avg us", "p50 us", "p99 us", "max us");
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const PerfEntry &entry = entries[i];
+		const PublicLatency *latency = entry.latency;
+
+		char function[sNAMEMAX + 1];
+
+		if (amx_GetPublic(entry.plugin->getAMX(), entry.index, function) != AMX_ERR_NONE)
+		{
+			ke::SafeSprintf(function, sizeof(function), "public_%d", entry.index);
+		}
+
+		print_srvconsole(" [%3u] %-24.23s %-24.23s %10u %10.2f %9.2f %9.2f %9.2f %9.2f\n",
+						 (unsigned int)(i + 1), entry.plugin->getName(), function, (unsigned int)latency->count,
+						 TicksToMicroseconds(latency->total) / 1000.0,
+						 TicksToMicroseconds(latency->total) / latency->count,
+						 TicksToMicroseconds(latency->Percentile(0.50)),
+						 TicksToMicroseconds(latency->Percentile(0.99)),
+						 TicksToMicroseconds(latency->max));
+	}
+
+	print_srvconsole("Usage: amxx perf [ plugin | reset | natives [ action ] ]\n");
+}
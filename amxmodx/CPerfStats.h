@@ -0,0 +1,175 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_CPERFSTATS_H_
+#define _INCLUDE_CPERFSTATS_H_
+
+#include <stdint.h>
+#include <chrono>
+#include <amtl/am-vector.h>
+#include <amtl/am-autoptr.h>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#else
+	#include <x86intrin.h>
+#endif
+
+/**
+ * Latency histogram of a public, in TSC ticks.
+ *
+ * Buckets are log-linear, like HDR histograms: values under 16 ticks are exact, above that
+ * every power of two is split into 8 buckets, which bounds the error to 1/16 of the value.
+ */
+struct PublicLatency
+{
+	static const unsigned int SubBucketBits = 3;
+	static const unsigned int SubBuckets    = 1 << SubBucketBits;
+	static const unsigned int MaxBits       = 40;   // Longer executions are clamped
+	static const unsigned int Buckets       = SubBuckets * 2 + (MaxBits - SubBucketBits - 1) * SubBuckets;
+
+	uint64_t count;
+	uint64_t total;
+	uint64_t max;
+	uint32_t buckets[Buckets];
+
+	inline void Add(uint64_t ticks)
+	{
+		++count;
+		total += ticks;
+
+		if (ticks > max)
+		{
+			max = ticks;
+		}
+
+		++buckets[BucketOf(ticks)];
+	}
+
+	// Value under which the given fraction of the executions fell
+	uint64_t Percentile(double fraction) const;
+
+	static inline unsigned int BucketOf(uint64_t ticks)
+	{
+		if (ticks < SubBuckets * 2)
+		{
+			return static_cast<unsigned int>(ticks);
+		}
+
+		if (ticks >= (uint64_t(1) << MaxBits))
+		{
+			return Buckets - 1;
+		}
+
+		unsigned int bit = HighestBit(ticks);
+		unsigned int sub = static_cast<unsigned int>(ticks >> (bit - SubBucketBits)) & (SubBuckets - 1);
+
+		return SubBuckets * 2 + (bit - SubBucketBits - 1) * SubBuckets + sub;
+	}
+
+	static inline unsigned int HighestBit(uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+
+		if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32)))
+		{
+			return index + 32;
+		}
+
+		_BitScanReverse(&index, static_cast<unsigned long>(value));
+		return index;
+#else
+		return 63 - __builtin_clzll(value);
+#endif
+	}
+};
+
+/**
+ * Calls made by a plugin to a native. Time includes the publics the native runs itself.
+ */
+struct NativeCalls
+{
+	uint64_t count;
+	uint64_t total;
+	uint64_t max;
+};
+
+/**
+ * Continuous execution statistics of every public run through amx_ExecPerf, which covers
+ * forwards and natives calling publics. Shown by "amxx perf".
+ *
+ * Executions are timed with the TSC, converted to time only when displayed, against the
+ * steady clock since startup. Publics are always executed from the main thread, so the
+ * counters need neither atomics nor locks. Statistics are kept by plugin id and are cleared
+ * on map change, along with the plugins.
+ *
+ * Native calls can be profiled as well, from amx_Callback which both the JIT and the
+ * interpreter go through. This is opt-in and switched at runtime with "amxx perf natives".
+ * Natives are identified by their index in the plugin's native table, the id BinLog records.
+ */
+class CPerfStats
+{
+public:
+	static const size_t DefaultTop = 15;
+
+public:
+	CPerfStats();
+
+public:
+	static inline uint64_t Now()
+	{
+		return __rdtsc();
+	}
+
+	inline void Record(int plugin, int index, uint64_t ticks)
+	{
+		if (static_cast<size_t>(plugin) < m_Plugins.length() && m_Plugins[plugin])
+		{
+			ke::Vector<ke::AutoPtr<PublicLatency>> &publics = *m_Plugins[plugin];
+
+			if (static_cast<size_t>(index) < publics.length() && publics[index])
+			{
+				publics[index]->Add(ticks);
+				return;
+			}
+		}
+
+		Create(plugin, index)->Add(ticks);
+	}
+
+	inline bool IsProfilingNatives() const
+	{
+		return m_ProfileNatives;
+	}
+
+	void RecordNative(AMX *amx, cell index, uint64_t ticks);
+
+	const PublicLatency *Find(int plugin, int index) const;
+	double TicksToMicroseconds(uint64_t ticks) const;
+	void Clear();
+	void OnConsoleCommand();
+
+private:
+	PublicLatency *Create(int plugin, int index);
+	void OnNativesCommand();
+	bool DumpNatives(const char *path, size_t *count);
+
+private:
+	ke::Vector<ke::AutoPtr<ke::Vector<ke::AutoPtr<PublicLatency>>>> m_Plugins;
+	ke::Vector<ke::AutoPtr<ke::Vector<NativeCalls>>> m_Natives;
+	bool m_ProfileNatives;
+
+	uint64_t m_StartTicks;
+	std::chrono::steady_clock::time_point m_StartTime;
+};
+
+extern CPerfStats g_PerfStats;
+
+#endif // _INCLUDE_CPERFSTATS_H_
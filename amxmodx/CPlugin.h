@@ -72,6 +72,8 @@ public:
 		~CPlugin();
 		
 		bool m_Debug;
+		cell m_StackPeak;
+		cell m_HeapPeak;
 		cell* m_pNullStringOfs;
 		cell* m_pNullVectorOfs;
 		ke::Vector<ke::AutoPtr<AutoConfig>> m_configs;
@@ -110,6 +112,21 @@ public:
 		inline bool isDebug() const { return m_Debug; }
 		inline cell* getNullStringOfs() const { return m_pNullStringOfs; }
 		inline cell* getNullVectorOfs() const { return m_pNullVectorOfs; }
+		inline cell getStackPeak() const { return m_StackPeak; }
+		inline cell getHeapPeak() const { return m_HeapPeak; }
+
+		// Sampled on native calls made from amx_ExecPerf, where the deepest stack and
+		// largest heap are usually reached
+		inline void updateMemoryPeaks()
+		{
+			cell stack = amx.stp - amx.stk;
+			cell heap = amx.hea - amx.hlw;
+
+			if (stack > m_StackPeak)
+				m_StackPeak = stack;
+			if (heap > m_HeapPeak)
+				m_HeapPeak = heap;
+		}
 	public:
 		void AddConfig(bool create, const char *name, const char *folder);
 		size_t GetConfigCount();
@@ -0,0 +1,427 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#include "amxmodx.h"
+#include "CProfiler.h"
+#include "debugger.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+	#include <sys/time.h>
+#else
+	#include <chrono>
+#endif
+
+CProfiler g_Profiler;
+
+CProfiler::CProfiler() : m_Running(false), m_Rate(0), m_Depth(0), m_DebugPending(0), m_Ring(nullptr), m_Head(0), m_Tail(0),
+                         m_Samples(0), m_Idle(0), m_Dropped(0)
+{
+}
+
+CProfiler::~CProfiler()
+{
+	Stop();
+	delete [] m_Ring;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+
+static void OnProfilerSignal(int)
+{
+	g_Profiler.Sample();
+}
+
+void CProfiler::StartTimer(int rate)
+{
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+
+	action.sa_handler = OnProfilerSignal;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+
+	sigaction(SIGPROF, &action, &m_OldAction);
+
+	// Counts CPU time only, an idle server isn't sampled
+	struct itimerval timer;
+	timer.it_interval.tv_sec = 0;
+	timer.it_interval.tv_usec = 1000000 / rate;
+	timer.it_value = timer.it_interval;
+
+	setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+void CProfiler::StopTimer()
+{
+	struct itimerval timer;
+	memset(&timer, 0, sizeof(timer));
+
+	setitimer(ITIMER_PROF, &timer, nullptr);
+	sigaction(SIGPROF, &m_OldAction, nullptr);
+}
+
+#else
+
+void CProfiler::StartTimer(int rate)
+{
+	auto interval = std::chrono::microseconds(1000000 / rate);
+
+	m_Thread = std::thread([this, interval]
+	{
+		while (m_Running)
+		{
+			std::this_thread::sleep_for(interval);
+			Sample();
+		}
+	});
+}
+
+void CProfiler::StopTimer()
+{
+	if (m_Thread.joinable())
+	{
+		m_Thread.join();
+	}
+}
+
+#endif
+
+bool CProfiler::Start(int rate)
+{
+	if (m_Running || rate <= 0 || rate > MaxRate)
+	{
+		return false;
+	}
+
+	if (!m_Ring)
+	{
+		m_Ring = new RawSample[RingSize];
+	}
+
+	Clear();
+
+	m_Rate = rate;
+	m_Depth = 0;
+	m_DebugPending = 0;
+	m_Running = true;
+
+	StartTimer(rate);
+
+	return true;
+}
+
+void CProfiler::Stop()
+{
+	if (!m_Running)
+	{
+		return;
+	}
+
+	m_Running = false;
+	StopTimer();
+
+	m_DebugPending = 0;
+	Drain();
+}
+
+void CProfiler::Clear()
+{
+	m_Stacks.clear();
+	m_Tail.store(m_Head.load());
+
+	m_Samples = 0;
+	m_Idle = 0;
+	m_Dropped = 0;
+}
+
+void CProfiler::Sample()
+{
+	size_t depth = m_Depth;
+
+	if (!depth)
+	{
+		++m_Idle;
+		return;
+	}
+
+	if (depth <= MaxDepth && m_Stack[depth - 1].debug)
+	{
+		++m_DebugPending;
+		return;
+	}
+
+	size_t head = m_Head.load(std::memory_order_relaxed);
+
+	if (head - m_Tail.load(std::memory_order_acquire) >= RingSize)
+	{
+		++m_Dropped;
+		return;
+	}
+
+	RawSample *sample = &m_Ring[head % RingSize];
+
+	if (depth > MaxDepth)
+	{
+		depth = MaxDepth;
+	}
+
+	// Keeps the innermost publics
+	size_t first = depth > MaxFrames ? depth - MaxFrames : 0;
+
+	sample->count = depth - first;
+
+	for (size_t i = first; i < depth; ++i)
+	{
+		Frame &frame = sample->frames[i - first];
+
+		frame.amx = m_Stack[i].amx;
+		frame.value = m_Stack[i].index;
+		frame.type = Frame_Public;
+	}
+
+	m_Head.store(head + 1, std::memory_order_release);
+}
+
+void CProfiler::SampleDebug(Debugger *debugger)
+{
+	// Lines running longer than the sampling period get all of their samples
+	size_t weight = m_DebugPending;
+	m_DebugPending = 0;
+
+	size_t depth = m_Depth;
+
+	// The line may belong to another plugin than the one the timer caught, which happens
+	// when returning from a nested call.
+	if (!depth || depth > MaxDepth || m_Stack[depth - 1].amx != debugger->GetAMX())
+	{
+		return;
+	}
+
+	Frame frames[MaxFrames];
+	size_t count = 0;
+
+	trace_info_t *trace = debugger->GetTraceStart();
+
+	while (trace && count < MaxFrames)
+	{
+		frames[count].amx = debugger->GetAMX();
+		frames[count].value = trace->cip;
+		frames[count].type = Frame_Code;
+
+		++count;
+		trace = debugger->GetNextTrace(trace);
+	}
+
+	// The code frames replace the public the plugin was entered with
+	for (size_t i = depth - 1; i-- > 0 && count < MaxFrames; )
+	{
+		frames[count].amx = m_Stack[i].amx;
+		frames[count].value = m_Stack[i].index;
+		frames[count].type = Frame_Public;
+
+		++count;
+	}
+
+	// Collected from the innermost frame
+	for (size_t i = 0; i < count / 2; ++i)
+	{
+		Frame frame = frames[i];
+		frames[i] = frames[count - 1 - i];
+		frames[count - 1 - i] = frame;
+	}
+
+	char stack[4096];
+	FormatFrames(stack, sizeof(stack), frames, count);
+
+	AddStack(stack, weight);
+}
+
+size_t CProfiler::FormatFrames(char *buffer, size_t maxlength, const Frame *frames, size_t count)
+{
+	size_t length = 0;
+	buffer[0] = '\0';
+
+	for (size_t i = 0; i < count && length < maxlength - 1; ++i)
+	{
+		const Frame &frame = frames[i];
+		const char *separator = length ? ";" : "";
+
+		CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(frame.amx);
+		const char *filename = plugin ? plugin->getName() : "unknown";
+
+		if (frame.type == Frame_Public)
+		{
+			char function[sNAMEMAX + 1];
+
+			if (frame.value == AMX_EXEC_MAIN)
+			{
+				strcpy(function, "main");
+			}
+			else if (frame.value < 0 || amx_GetPublic(frame.amx, frame.value, function) != AMX_ERR_NONE)
+			{
+				ke::SafeSprintf(function, sizeof(function), "public_%d", frame.value);
+			}
+
+			length += ke::SafeSprintf(buffer + length, maxlength - length, "%s%s::%s", separator, filename, function);
+			continue;
+		}
+
+		Debugger *debugger = static_cast<Debugger *>(frame.amx->userdata[UD_DEBUGGER]);
+		const char *function = nullptr;
+
+		if (!debugger || dbg_LookupFunction(debugger->m_pAmxDbg, frame.value, &function) != AMX_ERR_NONE)
+		{
+			length += ke::SafeSprintf(buffer + length, maxlength - length, "%s%s::0x%X", separator, filename, frame.value);
+			continue;
+		}
+
+		// Callers only get their name, so that their samples aren't split by call site
+		if (i == count - 1)
+		{
+			long line = 0;
+			dbg_LookupLine(debugger->m_pAmxDbg, frame.value, &line);
+
+			length += ke::SafeSprintf(buffer + length, maxlength - length, "%s%s::%s:%ld", separator, filename, function, line + 1);
+		}
+		else
+		{
+			length += ke::SafeSprintf(buffer + length, maxlength - length, "%s%s::%s", separator, filename, function);
+		}
+	}
+
+	return length;
+}
+
+void CProfiler::AddStack(const char *stack, size_t samples)
+{
+	StringHashMap<size_t>::Insert i = m_Stacks.findForAdd(stack);
+
+	if (!i.found())
+	{
+		if (!m_Stacks.add(i, stack))
+		{
+			return;
+		}
+
+		i->value = 0;
+	}
+
+	i->value += samples;
+	m_Samples += samples;
+}
+
+void CProfiler::Drain()
+{
+	size_t tail = m_Tail.load(std::memory_order_relaxed);
+	size_t head = m_Head.load(std::memory_order_acquire);
+
+	char stack[4096];
+
+	while (tail != head)
+	{
+		const RawSample &sample = m_Ring[tail % RingSize];
+
+		FormatFrames(stack, sizeof(stack), sample.frames, sample.count);
+		AddStack(stack, 1);
+
+		m_Tail.store(++tail, std::memory_order_release);
+	}
+}
+
+bool CProfiler::Dump(const char *path, size_t *stacks)
+{
+	Drain();
+
+	FILE *fp = fopen(path, "wt");
+
+	if (!fp)
+	{
+		return false;
+	}
+
+	*stacks = 0;
+
+	for (StringHashMap<size_t>::iterator iter = m_Stacks.iter(); !iter.empty(); iter.next())
+	{
+		fprintf(fp, "%s %u\n", iter->key.chars(), (unsigned int)iter->value);
+		++*stacks;
+	}
+
+	fclose(fp);
+
+	return true;
+}
+
+void CProfiler::OnConsoleCommand()
+{
+	// amxx profile start [rate]  <- clear previous results and start sampling
+	// amxx profile stop          <- stop sampling, results are kept
+	// amxx profile dump [file]   <- write the folded stacks to the logs directory
+	// amxx profile               <- show status
+
+	const char *action = CMD_ARGC() > 2 ? CMD_ARGV(2) : "";
+
+	if (!strcmp(action, "start"))
+	{
+		int rate = CMD_ARGC() > 3 ? atoi(CMD_ARGV(3)) : DefaultRate;
+
+		if (m_Running)
+		{
+			print_srvconsole("Profiler is already running.\n");
+		}
+		else if (!Start(rate))
+		{
+			print_srvconsole("Invalid sampling rate (%d), must be between 1 and %d.\n", rate, MaxRate);
+		}
+		else
+		{
+			print_srvconsole("Profiler started at %d samples per second.\n", rate);
+		}
+	}
+	else if (!strcmp(action, "stop"))
+	{
+		if (!m_Running)
+		{
+			print_srvconsole("Profiler is not running.\n");
+			return;
+		}
+
+		Stop();
+		print_srvconsole("Profiler stopped, %u samples recorded.\n", (unsigned int)m_Samples);
+	}
+	else if (!strcmp(action, "dump"))
+	{
+		const char *file = CMD_ARGC() > 3 ? CMD_ARGV(3) : "profile.folded";
+
+		char path[PLATFORM_MAX_PATH];
+		build_pathname_r(path, sizeof(path), "%s/%s", g_log_dir.chars(), file);
+
+		size_t stacks;
+
+		if (!Dump(path, &stacks))
+		{
+			print_srvconsole("Couldn't write profile to \"%s\".\n", path);
+			return;
+		}
+
+		print_srvconsole("Wrote %u stacks (%u samples) to \"%s\".\n", (unsigned int)stacks, (unsigned int)m_Samples, path);
+	}
+	else
+	{
+		print_srvconsole("Profiler is %s", m_Running ? "running" : "stopped");
+		if (m_Running)
+		{
+			print_srvconsole(" at %d samples per second", m_Rate);
+		}
+		print_srvconsole(".\n");
+
+		print_srvconsole("   %u samples in plugins, %u outside of plugins, %u dropped\n", (unsigned int)m_Samples, (unsigned int)m_Idle, (unsigned int)m_Dropped);
+		print_srvconsole("Usage: amxx profile < start [ rate ] | stop | dump [ file ] >\n");
+	}
+}
@@ -0,0 +1,183 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_CPROFILER_H_
+#define _INCLUDE_CPROFILER_H_
+
+#include <signal.h>
+#include <atomic>
+#include <sm_stringhashmap.h>
+
+#if !defined(__linux__) && !defined(__APPLE__)
+	#include <thread>
+#endif
+
+class Debugger;
+
+/**
+ * Statistical sampling profiler for plugins, started with "amxx profile".
+ *
+ * A timer (SIGPROF on Linux and macOS, a sampling thread on Windows) periodically records
+ * the publics being executed. JIT compiled code has no usable call stack, so these samples
+ * stop at the public level. Plugins in debug mode run through the interpreter instead: their
+ * samples are deferred to the next line executed, and taken from the debugger's call stack
+ * with the functions and line being run.
+ *
+ * Samples from the timer go through a fixed ring buffer and are symbolised once per frame,
+ * into folded stacks ("plugin.amxx::public;plugin.amxx::function:line count"), the input
+ * format of flamegraph tools. Nothing is recorded, and only a flag is checked, when stopped.
+ */
+class CProfiler
+{
+public:
+	static const int    DefaultRate  = 997;
+	static const int    MaxRate      = 10000;
+	static const size_t MaxDepth     = 64;    // Nested publics tracked
+	static const size_t MaxFrames    = 32;    // Frames kept per sample
+	static const size_t RingSize     = 4096;  // Samples waiting to be symbolised
+
+public:
+	CProfiler();
+	~CProfiler();
+
+public:
+	bool Start(int rate);
+	void Stop();
+	void Clear();
+	bool Dump(const char *path, size_t *stacks);
+	void OnConsoleCommand();
+
+	// Symbolises pending samples, must be called before plugins are unloaded
+	void Drain();
+
+	inline bool IsRunning() const
+	{
+		return m_Running;
+	}
+
+	inline void EnterPublic(AMX *amx, int index)
+	{
+		size_t depth = m_Depth;
+
+		if (depth < MaxDepth)
+		{
+			m_Stack[depth].amx = amx;
+			m_Stack[depth].index = index;
+			m_Stack[depth].debug = (amx->flags & AMX_FLAG_DEBUG) != 0;
+		}
+
+		m_Depth = depth + 1;
+	}
+
+	inline void LeavePublic()
+	{
+		if (m_Depth)
+		{
+			--m_Depth;
+		}
+	}
+
+	// Called from the debug hook on every line of debug plugins
+	inline void OnDebugStep(Debugger *debugger)
+	{
+		if (m_DebugPending)
+		{
+			SampleDebug(debugger);
+		}
+	}
+
+	// Called from the timer
+	void Sample();
+
+private:
+	enum FrameType
+	{
+		Frame_Public,
+		Frame_Code,
+	};
+
+	struct Frame
+	{
+		AMX      *amx;
+		cell      value;    // Public index or code address
+		FrameType type;
+	};
+
+	struct RawSample
+	{
+		size_t count;
+		Frame  frames[MaxFrames];
+	};
+
+	struct ExecEntry
+	{
+		AMX *amx;
+		int  index;
+		bool debug;
+	};
+
+	void SampleDebug(Debugger *debugger);
+	size_t FormatFrames(char *buffer, size_t maxlength, const Frame *frames, size_t count);
+	void AddStack(const char *stack, size_t samples);
+	void StartTimer(int rate);
+	void StopTimer();
+
+private:
+	volatile bool   m_Running;
+	int             m_Rate;
+
+	ExecEntry       m_Stack[MaxDepth];
+	volatile size_t m_Depth;
+	volatile sig_atomic_t m_DebugPending;
+
+	RawSample          *m_Ring;
+	std::atomic<size_t> m_Head;
+	std::atomic<size_t> m_Tail;
+
+	StringHashMap<size_t> m_Stacks;
+	size_t                m_Samples;
+	volatile size_t       m_Idle;
+	volatile size_t       m_Dropped;
+
+#if defined(__linux__) || defined(__APPLE__)
+	struct sigaction m_OldAction;
+#else
+	std::thread      m_Thread;
+#endif
+};
+
+extern CProfiler g_Profiler;
+
+/**
+ * Tracks a public execution for the profiler, for the duration of the scope.
+ */
+class ProfilerScope
+{
+public:
+	ProfilerScope(AMX *amx, int index) : m_Entered(g_Profiler.IsRunning())
+	{
+		if (m_Entered)
+		{
+			g_Profiler.EnterPublic(amx, index);
+		}
+	}
+
+	~ProfilerScope()
+	{
+		if (m_Entered)
+		{
+			g_Profiler.LeavePublic();
+		}
+	}
+
+private:
+	bool m_Entered;
+};
+
+#endif // _INCLUDE_CPROFILER_H_
@@ -12,7 +12,7 @@
 
 /*********************** CTask ***********************/
 
-void CTaskMngr::CTask::set(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat, float fCurrentTime)
+void CTaskMngr::CTask::set(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat, int iPriority, float fCurrentTime)
 {
 	clear();
 	m_bFree = false;
@@ -36,6 +36,8 @@ void CTaskMngr::CTask::set(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags,
 	
 	m_bAfterStart =	(iFlags & 4) ? true : false;
 	m_bBeforeEnd = (iFlags & 8) ? true : false;
+	m_bDeferrable = (iFlags & 16) ? true : false;
+	m_iPriority = iPriority;
 
 	m_fNextExecTime = fCurrentTime + m_fBase;
 
@@ -75,8 +77,11 @@ void CTaskMngr::CTask::clear()
 	m_bLoop = false;
 	m_bAfterStart =	false;
 	m_bBeforeEnd = false;
+	m_bDeferrable = false;
+	m_iPriority = 0;
 
 	m_fNextExecTime = 0.0f;
+	m_fDueSince = 0.0f;
 }
 
 bool CTaskMngr::CTask::isFree() const
@@ -93,31 +98,34 @@ void CTaskMngr::CTask::resetNextExecTime(float fCurrentTime)
 {
 	// If we're here while we're executing we would add m_fBase twice
 	if (!m_bInExecute)
+	{
 		m_fNextExecTime = fCurrentTime + m_fBase;
+		m_fDueSince = 0.0f;
+	}
 }
 
-void CTaskMngr::CTask::executeIfRequired(float fCurrentTime, float fTimeLimit, float fTimeLeft)
+bool CTaskMngr::CTask::isDue(float fCurrentTime, float fTimeLimit, float fTimeLeft) const
 {
-	bool execute = false;
-	bool done = false;
-	
 	if (m_bAfterStart)
 	{
-		if (fCurrentTime - fTimeLeft + 1.0f >= m_fBase)
-			execute = true;
+		return fCurrentTime - fTimeLeft + 1.0f >= m_fBase;
 	}
 	else if (m_bBeforeEnd)
 	{
-		if (fTimeLimit != 0.0f && (fTimeLeft + fTimeLimit * 60.0f) - fCurrentTime - 1.0f <= m_fBase)
-			execute = true;
-	}
-	else if (m_fNextExecTime <= fCurrentTime)
-	{
-		execute = true;
+		return fTimeLimit != 0.0f && (fTimeLeft + fTimeLimit * 60.0f) - fCurrentTime - 1.0f <= m_fBase;
 	}
 
-	if (execute)
+	return m_fNextExecTime <= fCurrentTime;
+}
+
+bool CTaskMngr::CTask::executeIfRequired(float fCurrentTime, float fTimeLimit, float fTimeLeft)
+{
+	bool done = false;
+
+	if (isDue(fCurrentTime, fTimeLimit, fTimeLeft))
 	{
+		m_fDueSince = 0.0f;
+
 		//only bother calling if we have something to call
 		if (!(m_bLoop && !m_iRepeat))
 		{
@@ -133,7 +141,7 @@ void CTaskMngr::CTask::executeIfRequired(float fCurrentTime, float fTimeLimit, f
 		}
 	
 		if (isFree())
-			return;
+			return true;
 
 		// set new exec time OR remove the task if needed
 		if (m_bLoop)
@@ -150,7 +158,11 @@ void CTaskMngr::CTask::executeIfRequired(float fCurrentTime, float fTimeLimit, f
 		} else {
 			m_fNextExecTime += m_fBase;
 		}
+
+		return true;
 	}
+
+	return false;
 }
 
 CTaskMngr::CTask::CTask()
@@ -166,9 +178,12 @@ CTaskMngr::CTask::CTask()
 	m_bLoop = false;
 	m_bAfterStart =	false;
 	m_bBeforeEnd = false;
+	m_bDeferrable = false;
+	m_iPriority = 0;
 	m_bInExecute = false;
 
 	m_fNextExecTime = 0.0f;
+	m_fDueSince = 0.0f;
 
 	m_iParamLen = 0;
 	m_pParams = NULL;
@@ -186,6 +201,9 @@ CTaskMngr::CTaskMngr()
 	m_pTmr_CurrentTime = NULL;
 	m_pTmr_TimeLimit = NULL;
 	m_pTmr_TimeLeft = NULL;
+
+	m_iOverBudgetFrames = 0;
+	m_iMostPending = 0;
 }
 
 CTaskMngr::~CTaskMngr()
@@ -200,7 +218,7 @@ void CTaskMngr::registerTimers(float *pCurrentTime, float *pTimeLimit, float *pT
 	m_pTmr_TimeLeft = pTimeLeft;
 }
 
-void CTaskMngr::registerTask(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat)
+void CTaskMngr::registerTask(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat, int iPriority)
 {
 	// first, search for free tasks
 	for (auto &task : m_Tasks)
@@ -208,7 +226,7 @@ void CTaskMngr::registerTask(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlag
 		if (task->isFree() && !task->inExecute())
 		{
 			// found: reuse it
-			task->set(pPlugin, iFunc, iFlags, iId, fBase, iParamsLen, pParams, iRepeat, *m_pTmr_CurrentTime);
+			task->set(pPlugin, iFunc, iFlags, iId, fBase, iParamsLen, pParams, iRepeat, iPriority, *m_pTmr_CurrentTime);
 			return;
 		}
 	}
@@ -218,7 +236,7 @@ void CTaskMngr::registerTask(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlag
 	if (!task)
 		return;
 		
-	task->set(pPlugin, iFunc, iFlags, iId, fBase, iParamsLen, pParams, iRepeat, *m_pTmr_CurrentTime);
+	task->set(pPlugin, iFunc, iFlags, iId, fBase, iParamsLen, pParams, iRepeat, iPriority, *m_pTmr_CurrentTime);
 	m_Tasks.append(ke::Move(task));
 }
 
@@ -269,6 +287,11 @@ bool CTaskMngr::taskExists(int iId, AMX *pAmx)
 
 void CTaskMngr::startFrame()
 {
+	auto start = std::chrono::steady_clock::now();
+
+	// Tasks carried over are collected again below, they are still due
+	m_Pending.clear();
+
 	auto lastSize = m_Tasks.length();
 	for(auto i = 0u; i < lastSize; i++)
 	{
@@ -276,11 +299,168 @@ void CTaskMngr::startFrame()
 
 		if (task->isFree())
 			continue;
+
+		if (task->isDeferrable())
+		{
+			if (task->isDue(*m_pTmr_CurrentTime, *m_pTmr_TimeLimit, *m_pTmr_TimeLeft))
+			{
+				if (task->getDueSince() == 0.0f)
+					task->setDueSince(*m_pTmr_CurrentTime);
+
+				Pending pending = { i, task->getPriority(), task->getDueSince() };
+				m_Pending.append(pending);
+			}
+			continue;
+		}
+
 		task->executeIfRequired(*m_pTmr_CurrentTime, *m_pTmr_TimeLimit, *m_pTmr_TimeLeft);
 	}
+
+	if (m_Pending.empty())
+		return;
+
+	qsort(m_Pending.buffer(), m_Pending.length(), sizeof(Pending), [](const void *a, const void *b) -> int
+	{
+		const Pending *pendingA = static_cast<const Pending *>(a);
+		const Pending *pendingB = static_cast<const Pending *>(b);
+
+		if (pendingA->priority != pendingB->priority)
+			return pendingA->priority > pendingB->priority ? -1 : 1;
+
+		if (pendingA->since != pendingB->since)
+			return pendingA->since < pendingB->since ? -1 : 1;
+
+		return pendingA->index < pendingB->index ? -1 : (pendingA->index > pendingB->index ? 1 : 0);
+	});
+
+	runPending(start);
+}
+
+void CTaskMngr::runDeferredTasks()
+{
+	if (m_Pending.empty())
+		return;
+
+	runPending(std::chrono::steady_clock::now());
+}
+
+void CTaskMngr::runPending(std::chrono::steady_clock::time_point start)
+{
+	if (m_Pending.length() > m_iMostPending)
+		m_iMostPending = m_Pending.length();
+
+	float budget = amxmodx_taskbudget->value;
+	size_t run = 0;
+
+	while (run < m_Pending.length())
+	{
+		// At least one task runs each frame, so a long non-deferrable task can't starve them
+		if (run && budget > 0.0f)
+		{
+			std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+			if (elapsed.count() >= budget)
+				break;
+		}
+
+		auto &task = m_Tasks[m_Pending[run++].index];
+
+		// The task may have been removed, or removed and reused by another, since collected
+		if (task->isFree() || !task->isDeferrable() || task->getDueSince() == 0.0f)
+			continue;
+
+		CPluginMngr::CPlugin *plugin = task->getPlugin();
+		float lateness = *m_pTmr_CurrentTime - task->getDueSince();
+
+		if (task->executeIfRequired(*m_pTmr_CurrentTime, *m_pTmr_TimeLimit, *m_pTmr_TimeLeft))
+		{
+			PluginStats &stats = getStats(plugin);
+
+			++stats.runs;
+
+			if (lateness > stats.worstLateness)
+				stats.worstLateness = lateness;
+		}
+	}
+
+	if (run == m_Pending.length())
+	{
+		m_Pending.clear();
+		return;
+	}
+
+	for (size_t i = run; i < m_Pending.length(); ++i)
+		m_Pending[i - run] = m_Pending[i];
+
+	m_Pending.resize(m_Pending.length() - run);
+
+	++m_iOverBudgetFrames;
+
+	for (size_t i = 0; i < m_Pending.length(); ++i)
+	{
+		auto &task = m_Tasks[m_Pending[i].index];
+
+		if (!task->isFree())
+			++getStats(task->getPlugin()).deferrals;
+	}
+}
+
+CTaskMngr::PluginStats &CTaskMngr::getStats(CPluginMngr::CPlugin *pPlugin)
+{
+	size_t id = static_cast<size_t>(pPlugin->getId());
+
+	while (m_Stats.length() <= id)
+	{
+		PluginStats stats = { 0, 0, 0.0f };
+		m_Stats.append(stats);
+	}
+
+	return m_Stats[id];
 }
 
 void CTaskMngr::clear()
 {
 	m_Tasks.clear();
+	m_Pending.clear();
+	m_Stats.clear();
+
+	m_iOverBudgetFrames = 0;
+	m_iMostPending = 0;
+}
+
+void CTaskMngr::OnConsoleCommand()
+{
+	size_t active = 0, deferrable = 0;
+
+	for (auto &task : m_Tasks)
+	{
+		if (task->isFree())
+			continue;
+
+		++active;
+
+		if (task->isDeferrable())
+			++deferrable;
+	}
+
+	print_srvconsole("Tasks: %u active, %u deferrable, %u carried over (budget %.2f ms)\n",
+					 (unsigned int)active, (unsigned int)deferrable, (unsigned int)m_Pending.length(), amxmodx_taskbudget->value);
+	print_srvconsole("Frames over budget: %u, most tasks carried over: %u\n\n",
+					 (unsigned int)m_iOverBudgetFrames, (unsigned int)m_iMostPending);
+
+	print_srvconsole("Deferrable tasks:\n");
+	print_srvconsole("       %-24.23s %8s %10s %16s\n", "plugin", "runs", "deferrals", "worst late (ms)");
+
+	for (size_t i = 0; i < m_Stats.length(); ++i)
+	{
+		const PluginStats &stats = m_Stats[i];
+
+		if (!stats.runs && !stats.deferrals)
+			continue;
+
+		CPluginMngr::CPlugin *plugin = g_plugins.findPlugin(static_cast<int>(i));
+
+		print_srvconsole(" [%3u] %-24.23s %8u %10u %16.1f\n", (unsigned int)i, plugin ? plugin->getName() : "-",
+						 (unsigned int)stats.runs, (unsigned int)stats.deferrals, stats.worstLateness * 1000.0f);
+	}
 }
@@ -10,6 +10,16 @@
 #ifndef CTASK_H
 #define CTASK_H
 
+#include <chrono>
+
+/**
+ * Tasks flagged as deferrable ("e") don't all run in the frame they are due: only as many as
+ * fit in amx_task_budget_ms, measured with the steady clock from the start of the task frame,
+ * are executed, highest priority first then longest waiting first. The others are carried over
+ * to the next server frames. A deferred task stays due, so a repeating task is never run
+ * twice out of order, it only catches up.
+ */
+
 class CTaskMngr
 {
 private:
@@ -27,6 +37,8 @@ private:
 		bool m_bLoop;
 		bool m_bAfterStart;
 		bool m_bBeforeEnd;
+		bool m_bDeferrable;
+		int m_iPriority;
 		float m_fBase;		// for normal tasks, stores the interval, for the others, stores the amount of time before start / after end
 		int m_iParamLen;
 		
@@ -35,16 +47,22 @@ private:
 
 		// execution
 		float m_fNextExecTime;
+		float m_fDueSince;	// time the task was first found due while deferred, 0 otherwise
 	public:
-		void set(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat, float fCurrentTime);
+		void set(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat, int iPriority, float fCurrentTime);
 		void clear();
 		bool isFree() const;
 
 		inline CPluginMngr::CPlugin *getPlugin() const { return m_pPlugin; }
 		inline AMX *getAMX() const { return m_pPlugin->getAMX(); }
 		inline int getTaskId() const { return m_iId; }
+		inline bool isDeferrable() const { return m_bDeferrable; }
+		inline int getPriority() const { return m_iPriority; }
+		inline float getDueSince() const { return m_fDueSince; }
+		inline void setDueSince(float fTime) { m_fDueSince = fTime; }
 
-		void executeIfRequired(float fCurrentTime, float fTimeLimit, float fTimeLeft);	// also removes the task if needed
+		bool isDue(float fCurrentTime, float fTimeLimit, float fTimeLeft) const;
+		bool executeIfRequired(float fCurrentTime, float fTimeLimit, float fTimeLeft);	// also removes the task if needed
 
 		void changeBase(float fNewBase);
 		void resetNextExecTime(float fCurrentTime);
@@ -61,25 +79,50 @@ private:
 		~CTask();
 	};
 
+	// Due deferrable task waiting for its turn
+	struct Pending
+	{
+		size_t index;
+		int priority;
+		float since;
+	};
+
+	struct PluginStats
+	{
+		size_t runs;		// deferrable tasks executed
+		size_t deferrals;	// frames a due deferrable task was carried over
+		float worstLateness;
+	};
+
 	/*** CTaskMngr priv members ***/
 	ke::Vector<ke::AutoPtr<CTask>> m_Tasks;
+	ke::Vector<Pending> m_Pending;
+	ke::Vector<PluginStats> m_Stats;	// by plugin id
+
+	size_t m_iOverBudgetFrames;
+	size_t m_iMostPending;
 	
 	float *m_pTmr_CurrentTime;
 	float *m_pTmr_TimeLimit;
 	float *m_pTmr_TimeLeft;
+
+	void runPending(std::chrono::steady_clock::time_point start);
+	PluginStats &getStats(CPluginMngr::CPlugin *pPlugin);
 public:
 	CTaskMngr();
 	~CTaskMngr();
 
 	void registerTimers(float *pCurrentTime, float *pTimeLimit, float *pTimeLeft);	// The timers will always point to the right value
-	void registerTask(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat);
+	void registerTask(CPluginMngr::CPlugin *pPlugin, int iFunc, int iFlags, cell iId, float fBase, int iParamsLen, const cell *pParams, int iRepeat, int iPriority = 0);
 	
 	int removeTasks(int iId, AMX *pAmx);											// remove all tasks that match the id and amx
 	int changeTasks(int iId, AMX *pAmx, float fNewBase);							// change all tasks that match the id and amx
 	bool taskExists(int iId, AMX *pAmx);
 	
 	void startFrame();
+	void runDeferredTasks();	// runs the deferrable tasks left over by the last frames, if any
 	void clear();
+	void OnConsoleCommand();
 };
 
 #endif //CTASK_H
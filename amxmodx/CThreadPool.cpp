@@ -0,0 +1,471 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#include "amxmodx.h"
+#include "CThreadPool.h"
+#include <chrono>
+
+#if defined(__linux__) || defined(__APPLE__)
+	#include <signal.h>
+	#include <pthread.h>
+#endif
+
+CThreadPool g_ThreadPool;
+
+static const int MaxThreads = 16;
+
+CThreadPool::CThreadPool() : m_Stopping(false), m_NextId(0), m_Budget(2.0f),
+	m_Completed(0), m_Cancelled(0), m_OverBudgetFrames(0)
+{
+}
+
+CThreadPool::~CThreadPool()
+{
+	// Workers must not outlive the pool, whatever is left is dropped
+	if (!m_Threads.empty())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			m_Stopping = true;
+		}
+
+		m_WorkAdded.notify_all();
+
+		for (size_t i = 0; i < m_Threads.size(); ++i)
+		{
+			m_Threads[i].join();
+		}
+	}
+}
+
+bool CThreadPool::Start()
+{
+	int threads = atoi(get_localinfo("threadpool_size", "0"));
+
+	if (threads <= 0)
+	{
+		// Leaves a core to the game thread
+		threads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+	}
+
+	if (threads < 1)
+	{
+		threads = 1;
+	}
+	else if (threads > MaxThreads)
+	{
+		threads = MaxThreads;
+	}
+
+	m_Budget = static_cast<float>(atof(get_localinfo("threadpool_budget", "2.0")));
+
+	if (m_Budget < 0.0f)
+	{
+		m_Budget = 0.0f;
+	}
+
+	m_Stopping = false;
+
+#if defined(__linux__) || defined(__APPLE__)
+	// The profiler's timer is process wide, but its samples are only meant for the game
+	// thread. Workers inherit the signal mask, so they start with SIGPROF blocked.
+	sigset_t signals, oldSignals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGPROF);
+	pthread_sigmask(SIG_BLOCK, &signals, &oldSignals);
+#endif
+
+	for (int i = 0; i < threads; ++i)
+	{
+		m_Threads.emplace_back([this] { WorkerMain(); });
+	}
+
+#if defined(__linux__) || defined(__APPLE__)
+	pthread_sigmask(SIG_SETMASK, &oldSignals, nullptr);
+#endif
+
+	return true;
+}
+
+int CThreadPool::AddJob(AMX *owner, const void *queue, THREADJOB_RUN run, THREADJOB_DONE done, void *data)
+{
+	if (!run || !done)
+	{
+		return 0;
+	}
+
+	if (m_Threads.empty() && !Start())
+	{
+		return 0;
+	}
+
+	Job *job = new Job;
+
+	job->owner = owner;
+	job->queue = queue;
+	job->run = run;
+	job->done = done;
+	job->data = data;
+	job->cancelled = false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Lock);
+
+		if (++m_NextId <= 0)
+		{
+			m_NextId = 1;
+		}
+
+		job->id = m_NextId;
+		m_Pending.push_back(job);
+	}
+
+	m_WorkAdded.notify_one();
+
+	return job->id;
+}
+
+bool CThreadPool::CancelJob(int id)
+{
+	std::lock_guard<std::mutex> lock(m_Lock);
+
+	for (auto iter = m_Pending.begin(); iter != m_Pending.end(); ++iter)
+	{
+		Job *job = *iter;
+
+		if (job->id == id)
+		{
+			// Never runs, completed on the next frame
+			job->cancelled = true;
+
+			m_Pending.erase(iter);
+			m_Finished.push_back(job);
+
+			return true;
+		}
+	}
+
+	for (size_t i = 0; i < m_Running.size(); ++i)
+	{
+		if (m_Running[i]->id == id)
+		{
+			if (m_Running[i]->cancelled)
+			{
+				return false;
+			}
+
+			return m_Running[i]->cancelled = true;
+		}
+	}
+
+	for (size_t i = 0; i < m_Finished.size(); ++i)
+	{
+		if (m_Finished[i]->id == id)
+		{
+			if (m_Finished[i]->cancelled)
+			{
+				return false;
+			}
+
+			return m_Finished[i]->cancelled = true;
+		}
+	}
+
+	return false;
+}
+
+void CThreadPool::WaitJobs(const void *queue)
+{
+	if (m_Threads.empty())
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_Lock);
+
+	m_JobFinished.wait(lock, [this, queue]
+	{
+		for (size_t i = 0; i < m_Pending.size(); ++i)
+		{
+			if (m_Pending[i]->queue == queue)
+			{
+				return false;
+			}
+		}
+
+		return !IsQueueBusy(queue);
+	});
+
+	CompleteFinished(lock, [queue](Job *job) { return job->queue == queue; });
+}
+
+void CThreadPool::RunFrame()
+{
+	if (m_Threads.empty())
+	{
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::unique_lock<std::mutex> lock(m_Lock);
+
+	while (!m_Finished.empty())
+	{
+		Job *job = m_Finished.front();
+		m_Finished.pop_front();
+
+		lock.unlock();
+		Complete(job);
+
+		// At least one job is completed each frame
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		lock.lock();
+
+		if (elapsed.count() >= m_Budget && !m_Finished.empty())
+		{
+			++m_OverBudgetFrames;
+			break;
+		}
+	}
+}
+
+void CThreadPool::OnPluginsUnloading()
+{
+	if (m_Threads.empty())
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_Lock);
+
+	for (auto iter = m_Pending.begin(); iter != m_Pending.end(); )
+	{
+		Job *job = *iter;
+
+		if (job->owner)
+		{
+			job->cancelled = true;
+
+			iter = m_Pending.erase(iter);
+			m_Finished.push_back(job);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	for (size_t i = 0; i < m_Running.size(); ++i)
+	{
+		if (m_Running[i]->owner)
+		{
+			m_Running[i]->cancelled = true;
+		}
+	}
+
+	for (size_t i = 0; i < m_Finished.size(); ++i)
+	{
+		if (m_Finished[i]->owner)
+		{
+			m_Finished[i]->cancelled = true;
+		}
+	}
+
+	// Running jobs can't be interrupted, their plugins must stay until they are done
+	m_JobFinished.wait(lock, [this]
+	{
+		for (size_t i = 0; i < m_Running.size(); ++i)
+		{
+			if (m_Running[i]->owner)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	});
+
+	CompleteFinished(lock, [](Job *job) { return job->owner != nullptr; });
+}
+
+void CThreadPool::Shutdown()
+{
+	if (m_Threads.empty())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Lock);
+
+		m_Stopping = true;
+
+		while (!m_Pending.empty())
+		{
+			m_Finished.push_back(m_Pending.front());
+			m_Pending.pop_front();
+		}
+	}
+
+	m_WorkAdded.notify_all();
+
+	for (size_t i = 0; i < m_Threads.size(); ++i)
+	{
+		m_Threads[i].join();
+	}
+
+	m_Threads.clear();
+
+	std::unique_lock<std::mutex> lock(m_Lock);
+
+	for (size_t i = 0; i < m_Finished.size(); ++i)
+	{
+		m_Finished[i]->cancelled = true;
+	}
+
+	CompleteFinished(lock, [](Job *) { return true; });
+}
+
+void CThreadPool::WorkerMain()
+{
+	std::unique_lock<std::mutex> lock(m_Lock);
+
+	while (!m_Stopping)
+	{
+		Job *job = nullptr;
+
+		// The first job of a queue found is its oldest one
+		for (auto iter = m_Pending.begin(); iter != m_Pending.end(); ++iter)
+		{
+			if (!(*iter)->queue || !IsQueueBusy((*iter)->queue))
+			{
+				job = *iter;
+				m_Pending.erase(iter);
+				break;
+			}
+		}
+
+		if (!job)
+		{
+			m_WorkAdded.wait(lock);
+			continue;
+		}
+
+		m_Running.push_back(job);
+
+		lock.unlock();
+		job->run(job->data);
+		lock.lock();
+
+		for (size_t i = 0; i < m_Running.size(); ++i)
+		{
+			if (m_Running[i] == job)
+			{
+				m_Running.erase(m_Running.begin() + i);
+				break;
+			}
+		}
+
+		m_Finished.push_back(job);
+		m_JobFinished.notify_all();
+
+		if (job->queue)
+		{
+			// The next job of its queue can be taken by any worker now
+			m_WorkAdded.notify_all();
+		}
+	}
+}
+
+bool CThreadPool::IsQueueBusy(const void *queue) const
+{
+	for (size_t i = 0; i < m_Running.size(); ++i)
+	{
+		if (m_Running[i]->queue == queue)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void CThreadPool::Complete(Job *job)
+{
+	job->done(job->data, job->cancelled);
+
+	if (job->cancelled)
+	{
+		++m_Cancelled;
+	}
+	else
+	{
+		++m_Completed;
+	}
+
+	delete job;
+}
+
+template <typename F>
+void CThreadPool::CompleteFinished(std::unique_lock<std::mutex> &lock, F filter)
+{
+	std::vector<Job *> jobs;
+
+	for (auto iter = m_Finished.begin(); iter != m_Finished.end(); )
+	{
+		if (filter(*iter))
+		{
+			jobs.push_back(*iter);
+			iter = m_Finished.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	// Completion callbacks may add or wait for jobs
+	lock.unlock();
+
+	for (size_t i = 0; i < jobs.size(); ++i)
+	{
+		Complete(jobs[i]);
+	}
+
+	lock.lock();
+}
+
+void CThreadPool::OnConsoleCommand()
+{
+	size_t pending, running, finished;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Lock);
+
+		pending = m_Pending.size();
+		running = m_Running.size();
+		finished = m_Finished.size();
+	}
+
+	print_srvconsole("Thread pool:\n");
+
+	if (m_Threads.empty())
+	{
+		print_srvconsole(" not started, no module has added a job yet.\n");
+		return;
+	}
+
+	print_srvconsole(" %u workers, %.2f ms completion budget per frame.\n", (unsigned int)m_Threads.size(), m_Budget);
+	print_srvconsole(" %u jobs pending, %u running, %u waiting for completion.\n",
+					 (unsigned int)pending, (unsigned int)running, (unsigned int)finished);
+	print_srvconsole(" %u jobs completed, %u cancelled, %u frames over budget.\n",
+					 (unsigned int)m_Completed, (unsigned int)m_Cancelled, (unsigned int)m_OverBudgetFrames);
+}
@@ -0,0 +1,100 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_CTHREADPOOL_H_
+#define _INCLUDE_CTHREADPOOL_H_
+
+#include "amx.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef void (*THREADJOB_RUN)(void *data);
+typedef void (*THREADJOB_DONE)(void *data, bool cancelled);
+
+/**
+ * Worker threads shared by the modules, exposed as MF_AddThreadJob() and co.
+ *
+ * A job runs on a worker, then its completion callback runs on the main thread, from
+ * StartFrame, while the frame's budget (threadpool_budget in core.ini) isn't used up. Jobs
+ * added with the same queue key run one at a time in the order they were added, which keeps
+ * e.g. the queries of a database module ordered.
+ *
+ * Jobs owned by a plugin are cancelled when plugins are unloaded: those not started yet are
+ * dropped, the running ones are waited for, and all are completed as cancelled right away.
+ */
+class CThreadPool
+{
+public:
+	struct Job
+	{
+		int id;
+		AMX *owner;
+		const void *queue;
+		THREADJOB_RUN run;
+		THREADJOB_DONE done;
+		void *data;
+		bool cancelled;
+	};
+
+public:
+	CThreadPool();
+	~CThreadPool();
+
+public:
+	int AddJob(AMX *owner, const void *queue, THREADJOB_RUN run, THREADJOB_DONE done, void *data);
+	bool CancelJob(int id);
+
+	// Blocks until the jobs of a queue are finished, and completes them
+	void WaitJobs(const void *queue);
+
+	// Completes finished jobs within the frame budget
+	void RunFrame();
+
+	// Cancels and completes the jobs owned by plugins, before they are unloaded
+	void OnPluginsUnloading();
+
+	// Cancels all jobs and stops the workers
+	void Shutdown();
+
+	void OnConsoleCommand();
+
+private:
+	bool Start();
+	void WorkerMain();
+	bool IsQueueBusy(const void *queue) const;
+	void Complete(Job *job);
+
+	template <typename F>
+	void CompleteFinished(std::unique_lock<std::mutex> &lock, F filter);
+
+private:
+	std::vector<std::thread> m_Threads;
+	std::mutex m_Lock;
+	std::condition_variable m_WorkAdded;
+	std::condition_variable m_JobFinished;
+
+	std::deque<Job *> m_Pending;
+	std::vector<Job *> m_Running;
+	std::deque<Job *> m_Finished;
+
+	bool m_Stopping;
+	int m_NextId;
+	float m_Budget;					// In milliseconds
+
+	size_t m_Completed;
+	size_t m_Cancelled;
+	size_t m_OverBudgetFrames;
+};
+
+extern CThreadPool g_ThreadPool;
+
+#endif // _INCLUDE_CTHREADPOOL_H_
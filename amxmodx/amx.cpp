@@ -70,6 +70,11 @@
 #include <amxmodx.h>
 #include <CPlugin.h>
 
+/* Plugin whose public amx_ExecPerf is running, resolved there once for the memory peaks
+ * sampled on its native calls
+ */
+static CPluginMngr::CPlugin *g_ExecPlugin = NULL;
+
 /* When one or more of the AMX_funcname macris are defined, we want
  * to compile only those functions. However, when none of these macros
  * is present, we want to compile everything.
@@ -472,7 +477,24 @@ int AMXAPI amx_Callback(AMX *amx, cell index, cell *result, cell *params)
   }
 #endif //BINLOG_ENABLED
 
-  *result = f(amx,params);
+  /* Handles created by the native belong to this plugin */
+  AMX *caller = g_HandleStats.EnterNative(amx);
+
+  if (g_ExecPlugin && g_ExecPlugin->getAMX() == amx)
+    g_ExecPlugin->updateMemoryPeaks();
+
+  if (g_PerfStats.IsProfilingNatives())
+  {
+    uint64_t start = CPerfStats::Now();
+    *result = f(amx,params);
+    g_PerfStats.RecordNative(amx, index, CPerfStats::Now() - start);
+  }
+  else
+  {
+    *result = f(amx,params);
+  }
+
+  g_HandleStats.LeaveNative(caller);
 
 #if defined BINLOG_ENABLED
   if (logfuncs)
@@ -4177,9 +4199,40 @@ int AMXAPI amx_GetStringOld(char *dest,const cell *source,int use_wchar)
   return AMX_ERR_NONE;
 }
 
+static int amx_ExecStats(AMX* amx, cell* retval, int index, CPluginMngr::CPlugin* plugin)
+{
+    if (!plugin || index < 0 || amxmodx_perfstats->value <= 0.0f)
+        return amx_Exec(amx, retval, index);
+
+    uint64_t start = CPerfStats::Now();
+    int err = amx_Exec(amx, retval, index);
+    g_PerfStats.Record(plugin->getId(), index, CPerfStats::Now() - start);
+
+    return err;
+}
+
+class ExecPluginScope
+{
+public:
+    ExecPluginScope(CPluginMngr::CPlugin* plugin) : m_Previous(g_ExecPlugin)
+    {
+        g_ExecPlugin = plugin;
+    }
+    ~ExecPluginScope()
+    {
+        g_ExecPlugin = m_Previous;
+    }
+private:
+    CPluginMngr::CPlugin* m_Previous;
+};
+
 int AMXAPI amx_ExecPerf(AMX* amx, cell* retval, int index)
 {
+    ProfilerScope perf_Profile(amx, index);
+
     CPluginMngr::CPlugin* perf_Plug = g_plugins.findPluginFast(amx);
+    ExecPluginScope perf_Exec(perf_Plug);
+
     if (amxmodx_perflog->value > 0.0f && perf_Plug && (perf_Plug->isDebug() || (int)amxmodx_debug->value == 2))
     {
         char perf_funcname[sNAMEMAX + 1];
@@ -4198,7 +4251,7 @@ int AMXAPI amx_ExecPerf(AMX* amx, cell* retval, int index)
         using std::chrono::microseconds;
 
         auto t1 = steady_clock::now();
-        int err = amx_Exec(amx, retval, index);
+        int err = amx_ExecStats(amx, retval, index, perf_Plug);
 
         auto ms_int = duration_cast<microseconds>(steady_clock::now() - t1);
         auto ms_float = (float)(ms_int.count() / 1000.0f);
@@ -4208,5 +4261,5 @@ int AMXAPI amx_ExecPerf(AMX* amx, cell* retval, int index)
         }
         return err;
     }
-    return amx_Exec(amx, retval, index);
+    return amx_ExecStats(amx, retval, index, perf_Plug);
 }
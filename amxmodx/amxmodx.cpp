@@ -1636,6 +1636,64 @@ static cell AMX_NATIVE_CALL get_pluginsnum(AMX *amx, cell *params)
 	return g_plugins.getPluginsNum();
 }
 
+// native bool:get_public_perf(index, const function[], stats[PublicPerf]);
+static cell AMX_NATIVE_CALL get_public_perf(AMX *amx, cell *params)
+{
+	enum { arg_count, arg_plugin, arg_function, arg_stats };
+
+	enum
+	{
+		PublicPerf_Calls,
+		PublicPerf_Total,
+		PublicPerf_Average,
+		PublicPerf_P50,
+		PublicPerf_P99,
+		PublicPerf_Max
+	};
+
+	CPluginMngr::CPlugin *plugin;
+
+	if (params[arg_plugin] < 0)
+		plugin = g_plugins.findPluginFast(amx);
+	else
+		plugin = g_plugins.findPlugin(params[arg_plugin]);
+
+	if (!plugin)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid plugin id: %d", params[arg_plugin]);
+		return 0;
+	}
+
+	int len;
+	const char *function = get_amxstring(amx, params[arg_function], 0, len);
+
+	int index;
+	if (amx_FindPublic(plugin->getAMX(), function, &index) != AMX_ERR_NONE)
+	{
+		return 0;
+	}
+
+	const PublicLatency *latency = g_PerfStats.Find(plugin->getId(), index);
+
+	if (!latency || !latency->count)
+	{
+		return 0;
+	}
+
+	cell *stats = get_amxaddr(amx, params[arg_stats]);
+
+	REAL total = static_cast<REAL>(g_PerfStats.TicksToMicroseconds(latency->total));
+
+	stats[PublicPerf_Calls] = static_cast<cell>(latency->count);
+	stats[PublicPerf_Total] = amx_ftoc(total / 1000.0f);
+	stats[PublicPerf_Average] = amx_ftoc(total / latency->count);
+	stats[PublicPerf_P50] = amx_ftoc(static_cast<REAL>(g_PerfStats.TicksToMicroseconds(latency->Percentile(0.50))));
+	stats[PublicPerf_P99] = amx_ftoc(static_cast<REAL>(g_PerfStats.TicksToMicroseconds(latency->Percentile(0.99))));
+	stats[PublicPerf_Max] = amx_ftoc(static_cast<REAL>(g_PerfStats.TicksToMicroseconds(latency->max)));
+
+	return 1;
+}
+
 // native register_concmd(const cmd[], const function[], flags = -1, const info[] = "", FlagManager = -1, bool:info_ml = false);
 static cell AMX_NATIVE_CALL register_concmd(AMX *amx, cell *params)
 {
@@ -2610,6 +2668,11 @@ static cell AMX_NATIVE_CALL set_user_info(AMX *amx, cell *params) /* 3 param */
 
 	ENTITY_SET_KEYVALUE(pPlayer->pEdict, sptemp, szValue);
 
+	if (!strcmp(sptemp, "lang"))
+	{
+		pPlayer->InvalidateLanguage();
+	}
+
 	return 1;
 }
 
@@ -2708,7 +2771,10 @@ static cell AMX_NATIVE_CALL set_task(AMX *amx, cell *params) /* 2 param */
 
 	char* temp = get_amxstring(amx, params[6], 0, a);
 
-	g_tasksMngr.registerTask(plugin, iFunc, UTIL_ReadFlags(temp), params[3], base, params[5], get_amxaddr(amx, params[4]), params[7]);
+	// Priority was added in 1.10, plugins compiled before don't pass it
+	int priority = (params[0] / sizeof(cell)) >= 8 ? params[8] : 0;
+
+	g_tasksMngr.registerTask(plugin, iFunc, UTIL_ReadFlags(temp), params[3], base, params[5], get_amxaddr(amx, params[4]), params[7], priority);
 
 	return 1;
 }
@@ -4745,6 +4811,7 @@ AMX_NATIVE_INFO amxmodx_Natives[] =
 	{"get_playersnum",			get_playersnum},
 	{"get_plugin",				get_plugin},
 	{"get_pluginsnum",			get_pluginsnum},
+	{"get_public_perf",			get_public_perf},
 	{"get_srvcmd",				get_srvcmd},
 	{"get_srvcmdsnum",			get_srvcmdsnum},
 	{"get_systime",				get_systime},
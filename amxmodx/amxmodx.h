@@ -51,6 +51,10 @@
 #include "CvarManager.h"
 #include "CoreConfig.h"
 #include "CFrameAction.h"
+#include "CProfiler.h"
+#include "CPerfStats.h"
+#include "CHandleStats.h"
+#include "CThreadPool.h"
 #include <amxmodx_version.h>
 #include <HLTypeConversion.h>
 
@@ -135,6 +139,10 @@ unsigned int UTIL_GetUTF8CharBytes(const char *stream);
 size_t UTIL_ReplaceAll(char *subject, size_t maxlength, const char *search, const char *replace, bool caseSensitive);
 size_t UTIL_ReplaceAll(char *subject, size_t maxlength, const char *search, size_t searchLen, const char *replace, size_t replaceLen, bool caseSensitive);
 char *UTIL_ReplaceEx(char *subject, size_t maxLen, const char *search, size_t searchLen, const char *replace, size_t replaceLen, bool caseSensitive);
+template <typename T> const T *UTIL_FindString(const T *haystack, size_t haystackLen, const T *needle, size_t needleLen);
+const char *UTIL_FindStringI(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen);
+bool UTIL_IsAscii(const char *string, size_t length);
+size_t UTIL_CaseFold(const char *string, size_t length, char *buffer, size_t maxlength);
 void UTIL_TrimLeft(char *buffer);
 void UTIL_TrimRight(char *buffer);
 
@@ -199,6 +207,8 @@ extern cvar_t* amxmodx_version;
 extern cvar_t* amxmodx_debug;
 extern cvar_t* amxmodx_language;
 extern cvar_t* amxmodx_perflog;
+extern cvar_t* amxmodx_perfstats;
+extern cvar_t* amxmodx_taskbudget;
 extern cvar_t* hostname;
 extern cvar_t* mp_timelimit;
 extern fakecmd_t g_fakecmd;
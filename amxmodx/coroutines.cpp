@@ -0,0 +1,93 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#include "amxmodx.h"
+#include "CCoroutine.h"
+
+// native Coroutine:coroutine_start(const function[], const any:data[] = "", len = 0);
+static cell AMX_NATIVE_CALL coroutine_start(AMX *amx, cell *params)
+{
+	int length;
+	const char *function = get_amxstring(amx, params[1], 0, length);
+
+	int func;
+
+	if (amx_FindPublic(amx, function, &func) != AMX_ERR_NONE)
+	{
+		CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(amx);
+		LogError(amx, AMX_ERR_NATIVE, "Function is not present (function \"%s\") (plugin \"%s\")", function, plugin->getName());
+		return 0;
+	}
+
+	cell len = params[3];
+
+	if (len < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid data length (%d)", len);
+		return 0;
+	}
+
+	int id = g_Coroutines.Start(amx, func, get_amxaddr(amx, params[2]), len);
+
+	if (!id)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Could not create the coroutine stack");
+		return 0;
+	}
+
+	return id;
+}
+
+// native any:coroutine_yield(Float:delay = 0.0);
+static cell AMX_NATIVE_CALL coroutine_yield(AMX *amx, cell *params)
+{
+	float delay = amx_ctof(params[1]);
+
+	if (delay < 0.0f)
+	{
+		delay = 0.0f;
+	}
+
+	return g_Coroutines.Yield(amx, Coroutine_Sleeping, gpGlobals->time + delay);
+}
+
+// native any:coroutine_suspend();
+static cell AMX_NATIVE_CALL coroutine_suspend(AMX *amx, cell *params)
+{
+	return g_Coroutines.Yield(amx, Coroutine_Waiting, 0.0f);
+}
+
+// native bool:coroutine_resume(Coroutine:coroutine, any:value = 0);
+static cell AMX_NATIVE_CALL coroutine_resume(AMX *amx, cell *params)
+{
+	return g_Coroutines.Resume(params[1], params[2]);
+}
+
+// native bool:coroutine_cancel(Coroutine:coroutine);
+static cell AMX_NATIVE_CALL coroutine_cancel(AMX *amx, cell *params)
+{
+	return g_Coroutines.Cancel(params[1]);
+}
+
+// native Coroutine:coroutine_current();
+static cell AMX_NATIVE_CALL coroutine_current(AMX *amx, cell *params)
+{
+	return g_Coroutines.GetCurrent(amx);
+}
+
+AMX_NATIVE_INFO g_CoroutineNatives[] =
+{
+	{ "coroutine_start",   coroutine_start },
+	{ "coroutine_yield",   coroutine_yield },
+	{ "coroutine_suspend", coroutine_suspend },
+	{ "coroutine_resume",  coroutine_resume },
+	{ "coroutine_cancel",  coroutine_cancel },
+	{ "coroutine_current", coroutine_current },
+	{ nullptr,             nullptr }
+};
@@ -33,6 +33,19 @@ NativeHandle<CDataPack> DataPackHandles;
 
 static cell AMX_NATIVE_CALL CreateDataPack(AMX* amx, cell* params)
 {
+	cell reserve = params[0] / sizeof(cell) >= 1 ? params[1] : 0;
+
+	if (reserve < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid datapack reserve size (%d)", reserve);
+		return 0;
+	}
+
+	if (reserve > 0)
+	{
+		return static_cast<cell>(DataPackHandles.create(static_cast<size_t>(reserve)));
+	}
+
 	return static_cast<cell>(DataPackHandles.create());
 }
 
@@ -84,6 +97,86 @@ static cell AMX_NATIVE_CALL WritePackString(AMX* amx, cell* params)
 	return len;
 }
 
+static cell AMX_NATIVE_CALL WritePackArray(AMX* amx, cell* params, bool floats)
+{
+	CDataPack *d = DataPackHandles.lookup(params[1]);
+
+	if (!d)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid datapack handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	cell count = params[3];
+
+	if (count < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid array size (%d)", count);
+		return 0;
+	}
+
+	cell *cells = get_amxaddr(amx, params[2]);
+
+	if (floats)
+	{
+		d->PackFloatArray(cells, count);
+	}
+	else
+	{
+		d->PackCellArray(cells, count);
+	}
+
+	return count;
+}
+
+static cell AMX_NATIVE_CALL WritePackCellArray(AMX* amx, cell* params)
+{
+	return WritePackArray(amx, params, false);
+}
+
+static cell AMX_NATIVE_CALL WritePackFloatArray(AMX* amx, cell* params)
+{
+	return WritePackArray(amx, params, true);
+}
+
+static cell AMX_NATIVE_CALL WritePackStrings(AMX* amx, cell* params)
+{
+	CDataPack *d = DataPackHandles.lookup(params[1]);
+
+	if (!d)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid datapack handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	cell count = params[3];
+
+	if (count < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid array size (%d)", count);
+		return 0;
+	}
+
+	cell *rows = get_amxaddr(amx, params[2]);
+	size_t total = 0;
+	int len;
+
+	for (cell i = 0; i < count; ++i)
+	{
+		amx_StrLen(get_amxaddr(amx, params[2] + i * sizeof(cell) + rows[i]), &len);
+		total += len;
+	}
+
+	d->ReserveStrings(count, total);
+
+	for (cell i = 0; i < count; ++i)
+	{
+		d->PackString(get_amxstring(amx, params[2] + i * sizeof(cell) + rows[i], 0, len));
+	}
+
+	return count;
+}
+
 static cell AMX_NATIVE_CALL ReadPackCell(AMX* amx, cell* params)
 {
 	CDataPack *d = DataPackHandles.lookup(params[1]);
@@ -146,6 +239,84 @@ static cell AMX_NATIVE_CALL ReadPackString(AMX* amx, cell* params)
 	return set_amxstring_utf8(amx, params[2], str, len, params[3]);
 }
 
+static cell AMX_NATIVE_CALL ReadPackArray(AMX* amx, cell* params, bool floats)
+{
+	CDataPack *d = DataPackHandles.lookup(params[1]);
+
+	if (!d)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid datapack handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	size_t count;
+
+	if (!(floats ? d->CanReadFloatArray(&count) : d->CanReadCellArray(&count)))
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Datapack operation is invalid.");
+		return 0;
+	}
+
+	if (params[3] < 0 || count > static_cast<size_t>(params[3]))
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Buffer too small to read array (%d < %d)", params[3], static_cast<cell>(count));
+		return 0;
+	}
+
+	const cell *cells = floats ? d->ReadFloatArray(NULL) : d->ReadCellArray(NULL);
+
+	memcpy(get_amxaddr(amx, params[2]), cells, sizeof(cell) * count);
+
+	return static_cast<cell>(count);
+}
+
+static cell AMX_NATIVE_CALL ReadPackCellArray(AMX* amx, cell* params)
+{
+	return ReadPackArray(amx, params, false);
+}
+
+static cell AMX_NATIVE_CALL ReadPackFloatArray(AMX* amx, cell* params)
+{
+	return ReadPackArray(amx, params, true);
+}
+
+static cell AMX_NATIVE_CALL ReadPackStrings(AMX* amx, cell* params)
+{
+	CDataPack *d = DataPackHandles.lookup(params[1]);
+
+	if (!d)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid datapack handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	cell count = params[3];
+
+	if (count < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid array size (%d)", count);
+		return 0;
+	}
+
+	// All or nothing, so a failed read doesn't leave the position halfway through.
+	if (!d->CanReadStrings(count))
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Datapack operation is invalid.");
+		return 0;
+	}
+
+	cell *rows = get_amxaddr(amx, params[2]);
+	size_t len;
+
+	for (cell i = 0; i < count; ++i)
+	{
+		const char *str = d->ReadString(&len);
+		set_amxstring_utf8(amx, params[2] + i * sizeof(cell) + rows[i], str, len, params[4]);
+	}
+
+	return count;
+}
+
 static cell AMX_NATIVE_CALL ResetPack(AMX* amx, cell* params)
 {
 	CDataPack *d = DataPackHandles.lookup(params[1]);
@@ -231,6 +402,31 @@ static cell AMX_NATIVE_CALL DestroyDataPack(AMX* amx, cell* params)
 	return 0;
 }
 
+static cell AMX_NATIVE_CALL MoveDataPack(AMX* amx, cell* params)
+{
+	cell *ptr = get_amxaddr(amx, params[1]);
+
+	CDataPack *d = DataPackHandles.lookup(*ptr);
+
+	if (!d)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid datapack handle provided (%d)", *ptr);
+		return 0;
+	}
+
+	size_t handle = DataPackHandles.clone(new CDataPack(ke::Move(*d)));
+
+	if (!handle)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Failed to move datapack (%d)", *ptr);
+		return 0;
+	}
+
+	DataPackHandles.destroy(*ptr);
+	*ptr = 0;
+
+	return static_cast<cell>(handle);
+}
 
 AMX_NATIVE_INFO g_DatapackNatives[] = 
 {
@@ -238,13 +434,20 @@ AMX_NATIVE_INFO g_DatapackNatives[] =
 	{ "WritePackCell"  , WritePackCell },
 	{ "WritePackFloat" , WritePackFloat },
 	{ "WritePackString", WritePackString },
+	{ "WritePackCellArray" , WritePackCellArray },
+	{ "WritePackFloatArray", WritePackFloatArray },
+	{ "WritePackStrings"   , WritePackStrings },
 	{ "ReadPackCell"   , ReadPackCell },
 	{ "ReadPackFloat"  , ReadPackFloat },
 	{ "ReadPackString" , ReadPackString },
+	{ "ReadPackCellArray"  , ReadPackCellArray },
+	{ "ReadPackFloatArray" , ReadPackFloatArray },
+	{ "ReadPackStrings"    , ReadPackStrings },
 	{ "ResetPack"      , ResetPack },
 	{ "GetPackPosition", GetPackPosition },
 	{ "SetPackPosition", SetPackPosition },
 	{ "IsPackEnded"    , IsPackEnded },
 	{ "DestroyDataPack", DestroyDataPack },
+	{ "MoveDataPack"   , MoveDataPack },
 	{ nullptr          , nullptr}
 };
@@ -9,9 +9,12 @@
 
 #include "amxmodx.h"
 #include "datastructs.h"
+#include "sorting.h"
+#include "trie_natives.h"
 #include <amtl/am-utility.h>
 
 NativeHandle<CellArray> ArrayHandles;
+DataStructManager DataStructs;
 
 // Array:ArrayCreate(cellsize=1, reserved=32);
 static cell AMX_NATIVE_CALL ArrayCreate(AMX* amx, cell* params)
@@ -256,6 +259,8 @@ static cell AMX_NATIVE_CALL ArraySetArray(AMX* amx, cell* params)
 
 	memcpy(blk, addr, sizeof(cell) * indexes);
 
+	vec->touch(idx);
+
 	return indexes;
 }
 
@@ -279,11 +284,13 @@ static cell AMX_NATIVE_CALL ArraySetCell(AMX* amx, cell* params)
 	}
 
 	cell *blk = vec->at(idx);
+	size_t item = idx;
 	idx = (size_t)params[4];
 
 	if (*params / sizeof(cell) <= 3)
 	{
 		*blk = params[3];
+		vec->touch(item);
 		return 1;
 	}
 
@@ -295,6 +302,7 @@ static cell AMX_NATIVE_CALL ArraySetCell(AMX* amx, cell* params)
 			return 0;
 		}
 		blk[idx] = params[3];
+		vec->touch(item, idx);
 	}
 	else 
 	{
@@ -304,6 +312,7 @@ static cell AMX_NATIVE_CALL ArraySetCell(AMX* amx, cell* params)
 			return 0;
 		}
 		*((char *)blk + idx) = (char)params[3];
+		vec->touch(item, idx / sizeof(cell));
 	}
 
 	return 1;
@@ -332,8 +341,11 @@ static cell AMX_NATIVE_CALL ArraySetString(AMX* amx, cell* params)
 
 	int len;
 	char *str = get_amxstring(amx, params[3], 0, len);
+	cell written = strncopy(blk, str, ke::Min((size_t)len + 1, vec->blocksize()));
+
+	vec->touch(idx);
 
-	return strncopy(blk, str, ke::Min((size_t)len + 1, vec->blocksize()));
+	return written;
 }
 
 // native ArrayPushArray(Array:which, const any:input[], size = -1);
@@ -673,33 +685,64 @@ static cell AMX_NATIVE_CALL ArrayDestroy(AMX* amx, cell* params)
 }
 
 
-struct ArraySort_s
+// Sorts the blocks of the array through a list of indices, moving each block once at the end.
+template <typename Compare>
+static void SortArrayIndices(CellArray *vec, Compare &compare)
 {
-	int   func;
-	cell  array_hndl;
-	cell* array_base;
-	cell  array_bsize;
-	cell  data;
-	cell  size;
-	cell  addr1;
-	cell  addr2;
-	AMX  *amx;
-};
+	size_t arraysize = vec->size();
+	size_t blocksize = vec->blocksize();
+
+	if (arraysize < 2)
+	{
+		return;
+	}
 
-ArraySort_s SortInfo;
+	cell *order = new cell[arraysize];
 
-int SortArrayList(const void *elem1, const void *elem2)
-{
-	return executeForwards(
-		SortInfo.func,
-		SortInfo.array_hndl,
-		((cell)((cell *)elem1 - SortInfo.array_base)) / SortInfo.array_bsize,
-		((cell)((cell *)elem2 - SortInfo.array_base)) / SortInfo.array_bsize,
-		SortInfo.data,
-		SortInfo.size
-	);
+	for (size_t i = 0; i < arraysize; ++i)
+	{
+		order[i] = static_cast<cell>(i);
+	}
+
+	MergeInsertionSort(order, order + arraysize, compare);
+
+	if (vec->size() != arraysize)
+	{
+		// The comparator resized the array, the order no longer applies.
+		delete [] order;
+		return;
+	}
+
+	vec->invalidate_index();
+
+	cell *array = vec->base();
+	cell *sorted = new cell[arraysize * blocksize];
+
+	for (size_t i = 0; i < arraysize; ++i)
+	{
+		memcpy(&sorted[i * blocksize], &array[order[i] * blocksize], blocksize * sizeof(cell));
+	}
+
+	memcpy(array, sorted, arraysize * blocksize * sizeof(cell));
+
+	delete [] sorted;
+	delete [] order;
 }
 
+struct ArraySortCompare
+{
+	SortComparator *comparator;
+	cell handle;
+	cell data;
+	cell size;
+
+	cell operator()(cell index1, cell index2)
+	{
+		// Blocks don't move until the sort is done, so indices are the current positions.
+		return comparator->Call(handle, index1, index2, data, size);
+	}
+};
+
 // native ArraySort(Array:array, const comparefunc[], data[]="", data_size=0);
 static cell AMX_NATIVE_CALL ArraySort(AMX* amx, cell* params)
 {
@@ -716,71 +759,47 @@ static cell AMX_NATIVE_CALL ArraySort(AMX* amx, cell* params)
 	char* funcName = get_amxstring(amx, params[2], 0, len);
 	
 	// MySortFunc(Array:array, item1, item2, const data[], data_size)
-	int func = registerSPForwardByName(amx, funcName, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_DONE);
-	if (func < 0)
+	SortComparator comparator(amx);
+
+	if (!comparator.Begin(funcName))
 	{
 		LogError(amx, AMX_ERR_NATIVE, "The public function \"%s\" was not found.", funcName);
 		return 0;
 	}
 
-	size_t arraysize = vec->size();
-	size_t blocksize = vec->blocksize();
-	cell *array = vec->base();
-
-	ArraySort_s oldinfo = SortInfo;
-
-	SortInfo.func        = func;
-	SortInfo.array_base  = array;
-	SortInfo.array_bsize = static_cast<cell>(blocksize);
-	SortInfo.array_hndl  = handle;
-	SortInfo.data        = params[3];
-	SortInfo.size        = params[4];
-
-	qsort(array, arraysize, blocksize * sizeof(cell), SortArrayList);
-
-	SortInfo = oldinfo;
-
-	unregisterSPForward(func);
+	ArraySortCompare compare = { &comparator, handle, params[3], params[4] };
+	SortArrayIndices(vec, compare);
 
 	return 1;
 }
 
-
-int SortArrayListExCell(const void *elem1, const void *elem2)
+struct ArraySortExCompare
 {
-	size_t index1 = ((cell)((cell *)elem1 - SortInfo.array_base)) / SortInfo.array_bsize;
-	size_t index2 = ((cell)((cell *)elem2 - SortInfo.array_base)) / SortInfo.array_bsize;
+	SortComparator *comparator;
+	CellArray *vec;
+	cell handle;
+	cell data;
+	cell size;
+	cell addr1;
+	cell addr2;
+	cell *phys1;
+	cell *phys2;
 
-	return executeForwards(
-		SortInfo.func,
-		SortInfo.array_hndl,
-		*&SortInfo.array_base[index1 * SortInfo.array_bsize], 
-		*&SortInfo.array_base[index2 * SortInfo.array_bsize],
-		SortInfo.data,
-		SortInfo.size
-	);
-}
-
-int SortArrayListExArray(const void *elem1, const void *elem2)
-{
-	size_t index1 = ((cell)((cell *)elem1 - SortInfo.array_base)) / SortInfo.array_bsize;
-	size_t index2 = ((cell)((cell *)elem2 - SortInfo.array_base)) / SortInfo.array_bsize;
+	cell operator()(cell index1, cell index2)
+	{
+		size_t blocksize = vec->blocksize();
 
-	cell *addr1 = get_amxaddr(SortInfo.amx, SortInfo.addr1);
-	cell *addr2 = get_amxaddr(SortInfo.amx, SortInfo.addr2);
+		if (blocksize == 1)
+		{
+			return comparator->Call(handle, *vec->at(index1), *vec->at(index2), data, size);
+		}
 
-	memcpy(addr1, &SortInfo.array_base[index1 * SortInfo.array_bsize], SortInfo.array_bsize * sizeof(cell));
-	memcpy(addr2, &SortInfo.array_base[index2 * SortInfo.array_bsize], SortInfo.array_bsize * sizeof(cell));
+		memcpy(phys1, vec->at(index1), blocksize * sizeof(cell));
+		memcpy(phys2, vec->at(index2), blocksize * sizeof(cell));
 
-	return executeForwards(
-		SortInfo.func,
-		SortInfo.array_hndl,
-		SortInfo.addr1,
-		SortInfo.addr2,
-		SortInfo.data,
-		SortInfo.size
-	);
-}
+		return comparator->Call(handle, addr1, addr2, data, size);
+	}
+};
 
 // native ArraySortEx(Array:array, const comparefunc[], data[]="", data_size=0);
 static cell AMX_NATIVE_CALL ArraySortEx(AMX* amx, cell* params)
@@ -796,45 +815,30 @@ static cell AMX_NATIVE_CALL ArraySortEx(AMX* amx, cell* params)
 	int len;
 	char* funcName = get_amxstring(amx, params[2], 0, len);
 
-	int func = registerSPForwardByName(amx, funcName, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_DONE);
+	SortComparator comparator(amx);
 
-	if (!func)
+	if (!comparator.Begin(funcName))
 	{
 		LogError(amx, AMX_ERR_NATIVE, "The public function \"%s\" was not found.", funcName);
 		return 0;
 	}
 
-	size_t arraysize = vec->size();
 	size_t blocksize = vec->blocksize();
-	cell *array = vec->base();
-	cell amx_addr1 = 0, amx_addr2 = 0, *phys_addr = NULL;
+	cell amx_addr1 = 0, amx_addr2 = 0, *phys_addr1 = NULL, *phys_addr2 = NULL;
 
 	if (blocksize > 1)
 	{
 		int err;
-		if ((err = amx_Allot(amx, blocksize, &amx_addr1, &phys_addr)) != AMX_ERR_NONE
-		|| ( err = amx_Allot(amx, blocksize, &amx_addr2, &phys_addr)) != AMX_ERR_NONE)
+		if ((err = amx_Allot(amx, blocksize, &amx_addr1, &phys_addr1)) != AMX_ERR_NONE
+		|| ( err = amx_Allot(amx, blocksize, &amx_addr2, &phys_addr2)) != AMX_ERR_NONE)
 		{
 			LogError(amx, err, "Ran out of memory");
 			return 0;
 		}
 	}
 
-	ArraySort_s oldinfo = SortInfo;
-
-	SortInfo.func        = func;
-	SortInfo.array_base  = array;
-	SortInfo.array_bsize = static_cast<cell>(blocksize);
-	SortInfo.array_hndl  = params[1];
-	SortInfo.data        = params[3];
-	SortInfo.size        = params[4];
-	SortInfo.amx         = amx;
-	SortInfo.addr1       = amx_addr1;
-	SortInfo.addr2       = amx_addr2;
-
-	qsort(array, arraysize, blocksize * sizeof(cell), blocksize > 1 ? SortArrayListExArray : SortArrayListExCell);
-
-	SortInfo = oldinfo;
+	ArraySortExCompare compare = { &comparator, vec, params[1], params[3], params[4], amx_addr1, amx_addr2, phys_addr1, phys_addr2 };
+	SortArrayIndices(vec, compare);
 
 	if (blocksize > 1)
 	{
@@ -842,14 +846,165 @@ static cell AMX_NATIVE_CALL ArraySortEx(AMX* amx, cell* params)
 		amx_Release(amx, amx_addr2);
 	}
 
-	unregisterSPForward(func);
-
 	return 1;
 }
 
 extern bool fastcellcmp(cell *a, cell *b, cell len);
 extern int amxstring_len(cell* a);
 
+static const size_t InvalidIndexEntry = static_cast<size_t>(-1);
+
+uint32_t CellArrayIndex::hash(const cell *key) const
+{
+	uint32_t hash = 2166136261u;
+
+	for (size_t i = 0; i < m_Prefix; ++i)
+	{
+		hash = (hash ^ static_cast<uint32_t>(key[i])) * 16777619u;
+	}
+
+	return hash;
+}
+
+void CellArrayIndex::add(const CellArray *array, size_t position)
+{
+	Entry &entry = m_Entries[m_Count];
+
+	entry.hash = hash(array->at(position));
+	entry.position = position;
+
+	size_t &bucket = m_Buckets[entry.hash & (m_Capacity - 1)];
+
+	entry.next = bucket;
+	bucket = m_Count++;
+}
+
+void CellArrayIndex::rebuild(const CellArray *array)
+{
+	size_t capacity = 16;
+
+	while (capacity < array->size() * 2)
+	{
+		capacity *= 2;
+	}
+
+	if (capacity != m_Capacity)
+	{
+		delete [] m_Entries;
+		delete [] m_Buckets;
+
+		m_Entries = new Entry[capacity];
+		m_Buckets = new size_t[capacity];
+		m_Capacity = capacity;
+	}
+
+	for (size_t i = 0; i < m_Capacity; ++i)
+	{
+		m_Buckets[i] = InvalidIndexEntry;
+	}
+
+	m_Count = 0;
+	m_Indexed = 0;
+}
+
+void CellArrayIndex::sync(const CellArray *array)
+{
+	size_t size = array->size();
+
+	// Rebuild when dropped, when appended blocks don't fit anymore, or when
+	// entries left behind by writes outnumber half of the live ones.
+	if (!m_Indexed || m_Indexed > size
+		|| m_Count + (size - m_Indexed) > m_Capacity
+		|| m_Count - m_Indexed > m_Indexed / 2 + 64)
+	{
+		rebuild(array);
+	}
+
+	while (m_Indexed < size)
+	{
+		add(array, m_Indexed++);
+	}
+}
+
+void CellArrayIndex::touch(const CellArray *array, size_t index)
+{
+	if (index >= m_Indexed)
+	{
+		// Not hashed yet, the next lookup will.
+		return;
+	}
+
+	if (m_Count == m_Capacity)
+	{
+		invalidate();
+		return;
+	}
+
+	add(array, index);
+}
+
+cell CellArrayIndex::find(const CellArray *array, const cell *key, size_t length)
+{
+	sync(array);
+
+	uint32_t keyHash = hash(key);
+	size_t size = array->size();
+	size_t found = InvalidIndexEntry;
+
+	for (size_t i = m_Buckets[keyHash & (m_Capacity - 1)]; i != InvalidIndexEntry; i = m_Entries[i].next)
+	{
+		const Entry &entry = m_Entries[i];
+
+		if (entry.hash == keyHash && entry.position < found && entry.position < size
+			&& fastcellcmp(const_cast<cell *>(key), array->at(entry.position), length))
+		{
+			found = entry.position;
+		}
+	}
+
+	return found == InvalidIndexEntry ? -1 : static_cast<cell>(found);
+}
+
+// native bool:ArrayCreateIndex(Array:which, prefix = 1);
+static cell AMX_NATIVE_CALL ArrayCreateIndex(AMX* amx, cell* params)
+{
+	CellArray* vec = ArrayHandles.lookup(params[1]);
+
+	if (!vec)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid array handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	cell prefix = params[2];
+
+	if (prefix <= 0 || (size_t)prefix > vec->blocksize())
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid prefix length %d (blocksize: %d)", prefix, vec->blocksize());
+		return 0;
+	}
+
+	vec->create_index(prefix);
+
+	return 1;
+}
+
+// native ArrayDestroyIndex(Array:which);
+static cell AMX_NATIVE_CALL ArrayDestroyIndex(AMX* amx, cell* params)
+{
+	CellArray* vec = ArrayHandles.lookup(params[1]);
+
+	if (!vec)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid array handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	vec->destroy_index();
+
+	return 1;
+}
+
 // native ArrayFindString(Array:which, const item[]);
 static cell AMX_NATIVE_CALL ArrayFindString(AMX* amx, cell* params)
 {
@@ -866,6 +1021,13 @@ static cell AMX_NATIVE_CALL ArrayFindString(AMX* amx, cell* params)
 	size_t a_len = ke::Max(1, amxstring_len(a));
 	size_t len = a_len > cellcount ? cellcount : a_len;
 
+	CellArrayIndex *index = vec->index();
+
+	if (index && len >= index->prefix())
+	{
+		return index->find(vec, a, len);
+	}
+
 	for (size_t i = 0; i < vec->size(); i++)
 	{	
 		b = vec->at(i);
@@ -890,6 +1052,13 @@ static cell AMX_NATIVE_CALL ArrayFindValue(AMX* amx, cell* params)
 		return -1;
 	}
 
+	CellArrayIndex *index = vec->index();
+
+	if (index && index->prefix() == 1)
+	{
+		return index->find(vec, &params[2], 1);
+	}
+
 	for (size_t i = 0; i < vec->size(); i++)
 	{
 		if (params[2] == *vec->at(i))
@@ -931,5 +1100,123 @@ AMX_NATIVE_INFO g_DataStructNatives[] =
 	{ "ArraySortEx"            , ArraySortEx },
 	{ "ArrayFindString"        , ArrayFindString },
 	{ "ArrayFindValue"         , ArrayFindValue },
+	{ "ArrayCreateIndex"       , ArrayCreateIndex },
+	{ "ArrayDestroyIndex"      , ArrayDestroyIndex },
 	{ nullptr                  , nullptr }
 };
+
+bool DataStructManager::ArrayGetInfo(cell handle, size_t *blocksize, size_t *count)
+{
+	CellArray *vec = ArrayHandles.lookup(handle);
+
+	if (!vec)
+	{
+		return false;
+	}
+
+	*blocksize = vec->blocksize();
+	*count = vec->size();
+
+	return true;
+}
+
+cell *DataStructManager::ArrayPush(cell handle)
+{
+	CellArray *vec = ArrayHandles.lookup(handle);
+
+	if (!vec)
+	{
+		return nullptr;
+	}
+
+	cell *blk = vec->push();
+
+	if (blk)
+	{
+		memset(blk, 0, sizeof(cell) * vec->blocksize());
+	}
+
+	return blk;
+}
+
+const cell *DataStructManager::ArrayAt(cell handle, size_t index)
+{
+	CellArray *vec = ArrayHandles.lookup(handle);
+
+	if (!vec || index >= vec->size())
+	{
+		return nullptr;
+	}
+
+	return vec->at(index);
+}
+
+bool DataStructManager::TrieIsValid(cell handle)
+{
+	return TrieHandles.lookup(handle) != nullptr;
+}
+
+static Entry *FindTrieEntryForSet(cell handle, const char *key, bool replace)
+{
+	CellTrie *t = TrieHandles.lookup(handle);
+
+	if (!t)
+	{
+		return nullptr;
+	}
+
+	StringHashMap<Entry>::Insert i = t->map.findForAdd(key);
+
+	if (!i.found())
+	{
+		if (!t->map.add(i, key))
+		{
+			return nullptr;
+		}
+	}
+	else if (!replace)
+	{
+		return nullptr;
+	}
+
+	return &i->value;
+}
+
+bool DataStructManager::TrieSetCell(cell handle, const char *key, cell value, bool replace)
+{
+	Entry *entry = FindTrieEntryForSet(handle, key, replace);
+
+	if (!entry)
+	{
+		return false;
+	}
+
+	entry->setCell(value);
+	return true;
+}
+
+bool DataStructManager::TrieSetString(cell handle, const char *key, const char *value, bool replace)
+{
+	Entry *entry = FindTrieEntryForSet(handle, key, replace);
+
+	if (!entry)
+	{
+		return false;
+	}
+
+	entry->setString(value);
+	return true;
+}
+
+bool DataStructManager::TrieSetArray(cell handle, const char *key, const cell *values, size_t count, bool replace)
+{
+	Entry *entry = FindTrieEntryForSet(handle, key, replace);
+
+	if (!entry)
+	{
+		return false;
+	}
+
+	entry->setArray(const_cast<cell *>(values), count);
+	return true;
+}
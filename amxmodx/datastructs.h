@@ -11,17 +11,79 @@
 #define DATASTRUCTS_H
 
 #include "natives_handles.h"
+#include <IDataStructs.h>
+
+class CellArray;
+
+/**
+ * Optional lookup index over the first cells of each block of a CellArray.
+ *
+ * Blocks are hashed by their first prefix cells, so a lookup whose key is at least that
+ * long only compares the blocks sharing its hash. Pushed blocks are hashed on the next
+ * lookup, blocks written in place are added again through touch(), and anything moving
+ * blocks around drops the index until the next lookup rebuilds it. Entries left behind
+ * by a write are harmless since every candidate is compared against the block itself.
+ */
+class CellArrayIndex
+{
+public:
+	CellArrayIndex(size_t prefix) : m_Prefix(prefix), m_Entries(nullptr), m_Buckets(nullptr), m_Capacity(0), m_Count(0), m_Indexed(0)
+	{
+	}
+
+	~CellArrayIndex()
+	{
+		delete [] m_Entries;
+		delete [] m_Buckets;
+	}
+
+	size_t prefix() const
+	{
+		return m_Prefix;
+	}
+
+	void invalidate()
+	{
+		m_Count = 0;
+		m_Indexed = 0;
+	}
+
+	void touch(const CellArray *array, size_t index);
+	cell find(const CellArray *array, const cell *key, size_t length);
+
+private:
+	struct Entry
+	{
+		uint32_t hash;
+		size_t position;
+		size_t next;
+	};
+
+	uint32_t hash(const cell *key) const;
+	void add(const CellArray *array, size_t position);
+	void rebuild(const CellArray *array);
+	void sync(const CellArray *array);
+
+private:
+	size_t m_Prefix;
+	Entry *m_Entries;
+	size_t *m_Buckets;
+	size_t m_Capacity;
+	size_t m_Count;
+	size_t m_Indexed;
+};
 
 class CellArray
 {
 public:
-	CellArray(size_t blocksize, size_t basesize = 0) : m_Data(nullptr), m_BlockSize(blocksize), m_AllocSize(0), m_BaseSize(basesize > 0 ? basesize : 8), m_Size(0)
+	CellArray(size_t blocksize, size_t basesize = 0) : m_Data(nullptr), m_BlockSize(blocksize), m_AllocSize(0), m_BaseSize(basesize > 0 ? basesize : 8), m_Size(0), m_Index(nullptr)
 	{
 	}
 
 	~CellArray()
 	{
 		free(m_Data);
+		delete m_Index;
 	}
 
 	size_t size() const
@@ -53,6 +115,7 @@ public:
 	void clear()
 	{
 		m_Size = 0;
+		invalidate_index();
 	}
 
 	bool swap(size_t item1, size_t item2)
@@ -73,11 +136,16 @@ public:
 		memcpy(pri, alt, sizeof(cell)* m_BlockSize);
 		memcpy(alt, temp, sizeof(cell)* m_BlockSize);
 
+		touch(item1);
+		touch(item2);
+
 		return true;
 	}
 
 	void remove(size_t index)
 	{
+		invalidate_index();
+
 		/* If we're at the end, take the easy way out */
 		if (index == m_Size - 1)
 		{
@@ -102,6 +170,8 @@ public:
 			return nullptr;
 		}
 
+		invalidate_index();
+
 		/* move everything up */
 		cell *src = at(index);
 		cell *dst = at(index + 1);
@@ -117,6 +187,7 @@ public:
 		if (count <= m_Size)
 		{
 			m_Size = count;
+			invalidate_index();
 			return true;
 		}
 
@@ -156,6 +227,41 @@ public:
 		return m_AllocSize * m_BlockSize * sizeof(cell);
 	}
 
+	CellArrayIndex *index() const
+	{
+		return m_Index;
+	}
+
+	void create_index(size_t prefix)
+	{
+		delete m_Index;
+		m_Index = new CellArrayIndex(prefix);
+	}
+
+	void destroy_index()
+	{
+		delete m_Index;
+		m_Index = nullptr;
+	}
+
+	/* Call after writing to a block in place, offset being the first cell written */
+	void touch(size_t index, size_t offset = 0)
+	{
+		if (m_Index && offset < m_Index->prefix())
+		{
+			m_Index->touch(this, index);
+		}
+	}
+
+	/* Call after moving blocks around through base() */
+	void invalidate_index()
+	{
+		if (m_Index)
+		{
+			m_Index->invalidate();
+		}
+	}
+
 private:
 	bool GrowIfNeeded(size_t count)
 	{
@@ -190,8 +296,24 @@ private:
 	size_t m_AllocSize;
 	size_t m_BaseSize;
 	size_t m_Size;
+	CellArrayIndex *m_Index;
 };
 
 extern NativeHandle<CellArray> ArrayHandles;
 
+class DataStructManager : public IDataStructManager
+{
+public:
+	bool ArrayGetInfo(cell handle, size_t *blocksize, size_t *count) override;
+	cell *ArrayPush(cell handle) override;
+	const cell *ArrayAt(cell handle, size_t index) override;
+
+	bool TrieIsValid(cell handle) override;
+	bool TrieSetCell(cell handle, const char *key, cell value, bool replace) override;
+	bool TrieSetString(cell handle, const char *key, const char *value, bool replace) override;
+	bool TrieSetArray(cell handle, const char *key, const cell *values, size_t count, bool replace) override;
+};
+
+extern DataStructManager DataStructs;
+
 #endif
@@ -278,6 +278,35 @@ void Debugger::EndExec()
 	m_Top--;
 }
 
+Debugger::Tracer *Debugger::SuspendExec()
+{
+	assert(m_Top >= 0 && m_Top < (int)m_pCalls.length());
+
+	Tracer *pTracer = m_pCalls[m_Top];
+	m_pCalls[m_Top] = new Tracer();
+
+	m_Top--;
+
+	return pTracer;
+}
+
+void Debugger::ResumeExec(Tracer *pTracer)
+{
+	m_Top++;
+	assert(m_Top >= 0);
+
+	if (m_Top >= (int)m_pCalls.length())
+	{
+		m_pCalls.append(pTracer);
+		assert(m_Top == static_cast<int>(m_pCalls.length() - 1));
+	}
+	else
+	{
+		delete m_pCalls[m_Top];
+		m_pCalls[m_Top] = pTracer;
+	}
+}
+
 void Debugger::StepI()
 {
 	assert(m_Top >= 0 && m_Top < (int)m_pCalls.length());
@@ -516,6 +545,8 @@ int AMXAPI Debugger::DebugHook(AMX *amx)
 
 	pDebugger->StepI();
 
+	g_Profiler.OnDebugStep(pDebugger);
+
 	return AMX_ERR_NONE;
 }
 
@@ -93,6 +93,12 @@ public:
 	//End a trace
 	void EndExec();
 
+	//Detach the current trace, for a coroutine being suspended
+	Tracer *SuspendExec();
+
+	//Reattach the trace of a resumed coroutine
+	void ResumeExec(Tracer *pTracer);
+
 	//Reset the internal states as if the debugger was inactive
 	void Reset();
 
@@ -10,6 +10,8 @@
 #include "amxmodx.h"
 #include "CFileSystem.h"
 #include "CLibrarySys.h"
+#include "CAsyncFile.h"
+#include "datastructs.h"
 
 using namespace ke;
 
@@ -1174,6 +1176,162 @@ static cell File_WriteTyped(AMX *amx, cell *params)
 	return !!(fp->Write(&value, sizeof(value)) == sizeof(value));
 }
 
+// Registers the public called once an asynchronous job is done, -1 if none is given and it's optional
+static bool RegisterAsyncCallback(AMX *amx, cell param, bool required, int &forward)
+{
+	int length;
+	const char *function = get_amxstring(amx, param, 1, length);
+
+	forward = -1;
+
+	if (!*function && !required)
+	{
+		return true;
+	}
+
+	forward = registerSPForwardByName(amx, function, FP_CELL, FP_STRING, FP_CELL, FP_ARRAY, FP_CELL, FP_DONE);
+
+	if (forward == -1)
+	{
+		CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(amx);
+		LogError(amx, AMX_ERR_NATIVE, "Function is not present (function \"%s\") (plugin \"%s\")", function, plugin->getName());
+		return false;
+	}
+
+	return true;
+}
+
+// native file_read_async(const file[], const callback[], linelen = 256, const data[] = "", len = 0, bool:use_valve_fs = false, const valve_path_id[] = "GAME");
+static cell AMX_NATIVE_CALL file_read_async(AMX *amx, cell *params)
+{
+	if (params[3] <= 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid line length (%d)", params[3]);
+		return 0;
+	}
+
+	if (params[5] < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid data length (%d)", params[5]);
+		return 0;
+	}
+
+	int forward;
+
+	if (!RegisterAsyncCallback(amx, params[2], true, forward))
+	{
+		return 0;
+	}
+
+	int length;
+	const char *file = get_amxstring(amx, params[1], 0, length);
+
+	bool valvefs = params[6] > 0;
+	const char *pathID = valvefs ? get_amxstring_null(amx, params[7], 2, length) : nullptr;
+
+	return g_AsyncFiles.Read(amx, forward, file, params[3], get_amxaddr(amx, params[4]), params[5], valvefs, pathID);
+}
+
+static cell AsyncWrite(AMX *amx, cell *params, ke::Vector<char> &buffer)
+{
+	if (params[6] < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid data length (%d)", params[6]);
+		return 0;
+	}
+
+	int forward;
+
+	if (!RegisterAsyncCallback(amx, params[4], false, forward))
+	{
+		return 0;
+	}
+
+	if (!g_AsyncFiles.Reserve(buffer.length()))
+	{
+		if (forward != -1)
+		{
+			unregisterSPForward(forward);
+		}
+
+		LogError(amx, AMX_ERR_NATIVE, "Too much data is waiting to be written (%u bytes), see asyncfile_maxsize", static_cast<unsigned int>(buffer.length()));
+		return 0;
+	}
+
+	int length;
+	const char *file = get_amxstring(amx, params[1], 0, length);
+
+	return g_AsyncFiles.Write(amx, forward, file, ke::Move(buffer), params[3] != 0, get_amxaddr(amx, params[5]), params[6]);
+}
+
+// native file_write_async(const file[], const text[], bool:append = true, const callback[] = "", const data[] = "", len = 0);
+static cell AMX_NATIVE_CALL file_write_async(AMX *amx, cell *params)
+{
+	cell *text = get_amxaddr(amx, params[2]);
+
+	ke::Vector<char> buffer;
+
+	while (*text)
+	{
+		buffer.append(static_cast<char>(*text++));
+	}
+
+	return AsyncWrite(amx, params, buffer);
+}
+
+// native file_write_lines_async(const file[], Array:lines, bool:append = true, const callback[] = "", const data[] = "", len = 0);
+static cell AMX_NATIVE_CALL file_write_lines_async(AMX *amx, cell *params)
+{
+	CellArray *lines = ArrayHandles.lookup(params[2]);
+
+	if (!lines)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid array handle provided (%d)", params[2]);
+		return 0;
+	}
+
+	ke::Vector<char> buffer;
+
+	for (size_t i = 0; i < lines->size(); ++i)
+	{
+		cell *line = lines->at(i);
+
+		for (size_t j = 0; j < lines->blocksize() && line[j]; ++j)
+		{
+			buffer.append(static_cast<char>(line[j]));
+		}
+
+		buffer.append('\n');
+	}
+
+	return AsyncWrite(amx, params, buffer);
+}
+
+// native dir_list_async(const dir[], const callback[], const data[] = "", len = 0, bool:use_valve_fs = false, const valve_path_id[] = "GAME");
+static cell AMX_NATIVE_CALL dir_list_async(AMX *amx, cell *params)
+{
+	if (params[4] < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid data length (%d)", params[4]);
+		return 0;
+	}
+
+	int forward;
+
+	if (!RegisterAsyncCallback(amx, params[2], true, forward))
+	{
+		return 0;
+	}
+
+	int length;
+	const char *path = get_amxstring(amx, params[1], 0, length);
+
+	bool valvefs = params[5] > 0;
+	const char *pathID = valvefs ? get_amxstring_null(amx, params[6], 2, length) : nullptr;
+
+	return g_AsyncFiles.List(amx, forward, path, get_amxaddr(amx, params[3]), params[4], valvefs, pathID);
+}
+
 AMX_NATIVE_INFO file_Natives[] =
 {
 	{"read_dir",		read_dir},
@@ -1230,5 +1388,10 @@ AMX_NATIVE_INFO file_Natives[] =
 	{"FileWriteInt16",		File_WriteTyped<int16_t>},
 	{"FileWriteInt32",		File_WriteTyped<int32_t>},
 
+	{"file_read_async",			file_read_async},
+	{"file_write_async",		file_write_async},
+	{"file_write_lines_async",	file_write_lines_async},
+	{"dir_list_async",			dir_list_async},
+
 	{NULL,				NULL}
 };
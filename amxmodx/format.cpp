@@ -91,6 +91,16 @@ const char *playerlang(const cell index)
 	return pLangName;
 }
 
+static bool mldebug_enabled()
+{
+	if (!amx_mldebug)
+	{
+		amx_mldebug = CVAR_GET_POINTER("amx_mldebug");
+	}
+
+	return amx_mldebug && amx_mldebug->string && (amx_mldebug->string[0] != '\0');
+}
+
 const char *translate(AMX *amx, const char *lang, const char *key)
 {
 	auto pLangName = lang;
@@ -102,13 +112,7 @@ const char *translate(AMX *amx, const char *lang, const char *key)
 	}
 
 	auto def = g_langMngr.GetDef(pLangName, key, status);
-
-	if (!amx_mldebug)
-	{
-		amx_mldebug = CVAR_GET_POINTER("amx_mldebug");
-	}
-
-	auto debug = (amx_mldebug && amx_mldebug->string && (amx_mldebug->string[0] != '\0'));
+	auto debug = mldebug_enabled();
 
 	if (debug)
 	{
@@ -159,6 +163,161 @@ const char *translate(AMX *amx, const char *lang, const char *key)
 	return def;
 }
 
+/**
+ * Interned counterparts of playerlang() and translate().
+ *
+ * Language names are resolved to dictionary indexes only when they change (client setinfo,
+ * server cvar or dictionary reload), and keys are resolved once per plugin string address,
+ * so translating a message for every player boils down to a few array lookups.
+ */
+
+static int serverlangid()
+{
+	static ke::AString name;
+	static unsigned int generation = 0;
+	static int id = -1;
+
+	const char *lang = amxmodx_language->string;
+
+	if (generation != g_langMngr.GetGeneration() || name.compare(lang) != 0)
+	{
+		name = lang;
+		id = g_langMngr.GetLangId(lang);
+		generation = g_langMngr.GetGeneration();
+	}
+
+	return id;
+}
+
+static int englishlangid()
+{
+	static unsigned int generation = 0;
+	static int id = -1;
+
+	if (generation != g_langMngr.GetGeneration())
+	{
+		id = g_langMngr.GetLangId("en");
+		generation = g_langMngr.GetGeneration();
+	}
+
+	return id;
+}
+
+// Returns false if index is neither a player nor LANG_PLAYER/LANG_SERVER
+static bool playerlangid(const cell index, int &langId)
+{
+	if (index == LANG_SERVER)
+	{
+		langId = serverlangid();
+		return true;
+	}
+
+	if (index != LANG_PLAYER && (index < 1 || index > gpGlobals->maxClients))
+	{
+		return false;
+	}
+
+	if (!amx_cl_langs)
+	{
+		amx_cl_langs = CVAR_GET_POINTER("amx_client_languages");
+	}
+
+	auto client = (index == LANG_PLAYER) ? g_langMngr.GetDefLang() : index;
+
+	if (static_cast<int>(amx_cl_langs->value) == 0 || client < 1 || client > gpGlobals->maxClients)
+	{
+		langId = serverlangid();
+	}
+	else
+	{
+		langId = GET_PLAYER_POINTER_I(client)->GetLanguageId();
+	}
+
+	return true;
+}
+
+struct TranslationKeyCache
+{
+	AMX *amx;
+	cell address;
+	int key;
+	unsigned int generation;
+};
+
+static TranslationKeyCache KeyCache[512];
+
+static int translationkey(AMX *amx, cell address)
+{
+	auto hash = (reinterpret_cast<uintptr_t>(amx) >> 4) ^ (static_cast<ucell>(address) / sizeof(cell));
+	auto &entry = KeyCache[hash & (ARRAY_LENGTH(KeyCache) - 1)];
+
+	if (entry.amx == amx && entry.address == address && entry.generation == g_langMngr.GetGeneration())
+	{
+		// The key may live in a non-constant buffer, make sure it is still the same.
+		auto source = get_amxaddr(amx, address);
+		auto key = g_langMngr.GetKey(entry.key);
+
+		while (*key != '\0' && static_cast<char>(*source) == *key)
+		{
+			++source;
+			++key;
+		}
+
+		if (*key == '\0' && *source == 0)
+		{
+			return entry.key;
+		}
+	}
+
+	int len;
+	auto key = g_langMngr.GetKeyEntry(get_amxstring(amx, address, 3, len));
+
+	// Misses aren't cached, the key may be added by a dictionary loaded later.
+	if (key >= 0)
+	{
+		entry.amx = amx;
+		entry.address = address;
+		entry.key = key;
+		entry.generation = g_langMngr.GetGeneration();
+	}
+
+	return key;
+}
+
+static const char *translate(int langId, int key)
+{
+	int status;
+
+	if (key < 0)
+	{
+		return nullptr;
+	}
+
+	auto def = g_langMngr.GetDef(langId, key, status);
+
+	if (!def)
+	{
+		auto serverId = serverlangid();
+
+		if (serverId != langId)
+		{
+			def = g_langMngr.GetDef(serverId, key, status);
+		}
+
+		if (!def)
+		{
+			auto englishId = englishlangid();
+
+			if (englishId != langId && englishId != serverId)
+			{
+				def = g_langMngr.GetDef(englishId, key, status);
+			}
+		}
+	}
+
+	return def;
+}
+
 template <typename U, typename S>
 void AddString(U **buf_p, size_t &maxlen, const S *string, int width, int prec)
 {
@@ -545,51 +704,100 @@ void AddHex(U **buf_p, size_t &maxlen, unsigned int val, int width, int flags)
 	*buf_p = buf;
 }
 
+/**
+ * Format strings are parsed once into a list of segments (literal runs and conversion
+ * specifiers) which are cached per (plugin, format address). Later calls only have to
+ * check the cached text is still the same and run the emit loop.
+ */
+
+struct FormatSegment
+{
+	int		conversion;	// '\0' for a literal run
+	size_t	offset;		// literal run position in the format
+	size_t	length;		// literal run length
+	int		flags;
+	int		width;
+	int		prec;
+};
+
+template <typename S>
+struct FormatProgram
+{
+	FormatProgram() : amx(nullptr), format(nullptr), busy(0)
+	{
+	}
+
+	AMX *amx;
+	const S *format;
+	ke::Vector<S> text;	// format elements read by the parser, terminator included
+	ke::Vector<FormatSegment> segments;
+	int busy;
+};
+
 template <typename D, typename S>
-size_t atcprintf(D *buffer, size_t maxlen, const S *format, AMX *amx, cell *params, int *param)
+struct FormatCache
 {
-	int		arg;
-	int		args = params[0] / sizeof(cell);
-	D		*buf_p;
+	static FormatProgram<S> Programs[256];
+};
+
+template <typename D, typename S>
+FormatProgram<S> FormatCache<D, S>::Programs[256];
+
+template <typename S>
+static void AddLiteralSegment(FormatProgram<S> &program, const S *start, size_t length)
+{
+	FormatSegment segment;
+	segment.conversion = '\0';
+	segment.offset = start - program.format;
+	segment.length = length;
+
+	program.segments.append(segment);
+}
+
+template <typename D, typename S>
+static void CompileFormat(FormatProgram<S> &program, const S *format)
+{
+	const S	*fmt = format;
+	const S	*start;
 	D		ch;
 	int		flags;
 	int		width;
 	int		prec;
 	int		n;
-	//char	sign;
-	const S	*fmt;
-	size_t	llen = maxlen;
 
-	buf_p = buffer;
-	arg = *param;
-	fmt = format;
+	program.format = format;
+	program.segments.clear();
 
 	while (true)
 	{
 		// run through the format string until we hit a '%' or '\0'
-		for (ch = static_cast<D>(*fmt); 
-			llen && ((ch = static_cast<D>(*fmt)) != '\0' && ch != '%');
-			fmt++)
+		for (start = fmt; (ch = static_cast<D>(*fmt)) != '\0' && ch != '%'; fmt++)
 		{
-			*buf_p++ = static_cast<D>(ch);
-			llen--;
 		}
-		if (ch == '\0' || llen <= 0)
-			goto done;
+
+		if (fmt != start)
+		{
+			AddLiteralSegment(program, start, fmt - start);
+		}
+
+		if (ch == '\0')
+		{
+			fmt++;
+			break;
+		}
 
 		// skip over the '%'
-		fmt++;
+		start = fmt++;
 
 		// reset formatting state
 		flags = 0;
 		width = 0;
 		prec = -1;
-		//sign = '\0';
 
 rflag:
 		ch = static_cast<D>(*fmt++);
 reswitch:
-		switch(ch)
+		switch (ch)
 		{
 		case '-':
 			flags |= LADJUST;
@@ -619,6 +827,161 @@ reswitch:
 			} while( is_digit( ch ) );
 			width = n;
 			goto reswitch;
+		case 'X':
+			flags |= UPPERDIGITS;
+			// fall through
+		case 'c':
+		case 'b':
+		case 'd':
+		case 'i':
+		case 'u':
+		case 'f':
+		case 'x':
+		case 'a':
+		case 's':
+		case 'L':
+		case 'l':
+		case 'N':
+		case 'n':
+			{
+				FormatSegment segment;
+				segment.conversion = ch;
+				segment.offset = 0;
+				segment.length = 0;
+				segment.flags = flags;
+				segment.width = width;
+				segment.prec = prec;
+
+				program.segments.append(segment);
+				break;
+			}
+		case '\0':
+			// a trailing '%' is written as is
+			AddLiteralSegment(program, start, 1);
+			goto finished;
+		default:
+			// '%%' and unknown specifiers write the character itself
+			AddLiteralSegment(program, fmt - 1, 1);
+			break;
+		}
+	}
+
+finished:
+	program.text.clear();
+	for (const S *iter = format; iter != fmt; iter++)
+	{
+		program.text.append(*iter);
+	}
+}
+
+template <typename S>
+static bool IsSameFormat(const FormatProgram<S> &program, const S *format)
+{
+	const S *text = program.text.buffer();
+	size_t length = program.text.length();
+
+	for (size_t i = 0; i < length; i++)
+	{
+		if (text[i] != format[i])
+		{
+			return false;
+		}
+	}
+
+	return length != 0;
+}
+
+template <typename D, typename S>
+static FormatProgram<S> *GetFormatProgram(AMX *amx, const S *format, FormatProgram<S> &local)
+{
+	auto hash = (reinterpret_cast<uintptr_t>(format) / sizeof(S)) ^ (reinterpret_cast<uintptr_t>(amx) >> 4);
+	auto &programs = FormatCache<D, S>::Programs;
+	auto &program = programs[hash & (ARRAY_LENGTH(programs) - 1)];
+
+	if (program.amx == amx && program.format == format && IsSameFormat(program, format))
+	{
+		return &program;
+	}
+
+	// The slot is being emitted further up the stack (e.g. %L definitions), don't pull it from under it.
+	if (program.busy)
+	{
+		CompileFormat<D>(local, format);
+		return &local;
+	}
+
+	program.amx = amx;
+	CompileFormat<D>(program, format);
+
+	return &program;
+}
+
+template <typename S>
+class AutoFormatProgram
+{
+public:
+	AutoFormatProgram(FormatProgram<S> *program) : m_Program(program)
+	{
+		m_Program->busy++;
+	}
+	~AutoFormatProgram()
+	{
+		m_Program->busy--;
+	}
+	FormatProgram<S> *operator ->() const
+	{
+		return m_Program;
+	}
+private:
+	FormatProgram<S> *m_Program;
+};
+
+template <typename D, typename S>
+inline void CopyLiteral(D *dest, const S *src, size_t count)
+{
+	while (count--)
+		*dest++ = static_cast<D>(*src++);
+}
+
+template <typename T>
+inline void CopyLiteral(T *dest, const T *src, size_t count)
+{
+	memmove(dest, src, count * sizeof(T));
+}
+
+template <typename D, typename S>
+size_t atcprintf(D *buffer, size_t maxlen, const S *format, AMX *amx, cell *params, int *param)
+{
+	int		arg;
+	int		args = params[0] / sizeof(cell);
+	D		*buf_p;
+	size_t	llen = maxlen;
+	FormatProgram<S> local;
+	AutoFormatProgram<S> program(GetFormatProgram<D>(amx, format, local));
+
+	buf_p = buffer;
+	arg = *param;
+
+	for (size_t i = 0; i < program->segments.length(); i++)
+	{
+		if (llen <= 0)
+			goto done;
+
+		const FormatSegment &segment = program->segments[i];
+		int flags = segment.flags;
+		int width = segment.width;
+		int prec = segment.prec;
+
+		switch (segment.conversion)
+		{
+		case '\0':
+			{
+				size_t length = segment.length < llen ? segment.length : llen;
+				CopyLiteral(buf_p, format + segment.offset, length);
+				buf_p += length;
+				llen -= length;
+				break;
+			}
 		case 'c':
 			CHECK_ARGS(0);
 			*buf_p++ = static_cast<D>(*get_amxaddr(amx, params[arg]));
@@ -647,11 +1010,6 @@ reswitch:
 			arg++;
 			break;
 		case 'X':
-			CHECK_ARGS(0);
-			flags |= UPPERDIGITS;
-			AddHex(&buf_p, llen, static_cast<unsigned int>(*get_amxaddr(amx, params[arg])), width, flags);
-			arg++;
-			break;
 		case 'x':
 			CHECK_ARGS(0);
 			AddHex(&buf_p, llen, static_cast<unsigned int>(*get_amxaddr(amx, params[arg])), width, flags);
@@ -680,29 +1038,55 @@ reswitch:
 		case 'L':
 		case 'l':
 			{
-				const char *lang;
+				const char *def;
 				int len;
-				if (ch == 'L')
+				if (mldebug_enabled())
 				{
-					CHECK_ARGS(1);
-					auto currParam = params[arg++];
-					lang = playerlang(*get_amxaddr(amx, currParam));
-					if (!lang)
-						lang = get_amxstring(amx, currParam, 2, len);
+					const char *lang;
+					if (segment.conversion == 'L')
+					{
+						CHECK_ARGS(1);
+						auto currParam = params[arg++];
+						lang = playerlang(*get_amxaddr(amx, currParam));
+						if (!lang)
+							lang = get_amxstring(amx, currParam, 2, len);
+					}
+					else
+					{
+						CHECK_ARGS(0);
+						lang = playerlang(g_langMngr.GetDefLang());
+					}
+					const char *key = get_amxstring(amx, params[arg], 3, len);
+					def = translate(amx, lang, key);
 				}
 				else
 				{
-					CHECK_ARGS(0);
-					lang = playerlang(g_langMngr.GetDefLang());
+					int langId = -1;
+					if (segment.conversion == 'L')
+					{
+						CHECK_ARGS(1);
+						auto currParam = params[arg++];
+						if (!playerlangid(*get_amxaddr(amx, currParam), langId))
+						{
+							const char *lang = get_amxstring(amx, currParam, 2, len);
+							if (isalpha(lang[0]))
+								langId = g_langMngr.GetLangId(lang);
+						}
+					}
+					else
+					{
+						CHECK_ARGS(0);
+						playerlangid(g_langMngr.GetDefLang(), langId);
+					}
+					def = translate(langId, translationkey(amx, params[arg]));
 				}
-				const char *key = get_amxstring(amx, params[arg++], 3, len);
-				const char *def = translate(amx, lang, key);
 				if (!def)
 				{
 					static char buf[255];
-					ke::SafeSprintf(buf, sizeof(buf), "ML_NOTFOUND: %s", key);
+					ke::SafeSprintf(buf, sizeof(buf), "ML_NOTFOUND: %s", get_amxstring(amx, params[arg], 3, len));
 					def = buf;
 				}
+				arg++;
 				size_t written = atcprintf(buf_p, llen, def, amx, params, &arg);
 				buf_p += written;
 				llen -= written;
@@ -774,25 +1158,6 @@ reswitch:
 				arg++;
 				break;
 			}
-		case '%':
-			*buf_p++ = static_cast<D>(ch);
-			if (!llen)
-				goto done;
-			llen--;
-			break;
-		case '\0':
-			*buf_p++ = static_cast<D>('%');
-			if (!llen)
-				goto done;
-			llen--;
-			goto done;
-			break;
-		default:
-			*buf_p++ = static_cast<D>(ch);
-			if (!llen)
-				goto done;
-			llen--;
-			break;
 		}
 	}
 
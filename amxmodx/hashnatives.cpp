@@ -0,0 +1,153 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#include "amxmodx.h"
+#include "hashnatives.h"
+#include "CAsyncFile.h"
+
+NativeHandle<Hasher> HashHandles;
+
+static bool IsValidHashType(AMX *amx, cell type)
+{
+	if (type < Hash_Crc32 || type > Hash_Keccak_512)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid hash type (%d)", type);
+		return false;
+	}
+
+	return true;
+}
+
+// native Hash:hash_create(HashType:type);
+static cell AMX_NATIVE_CALL hash_create(AMX *amx, cell *params)
+{
+	if (!IsValidHashType(amx, params[1]))
+	{
+		return 0;
+	}
+
+	return static_cast<cell>(HashHandles.create(static_cast<HashType>(params[1])));
+}
+
+// native hash_update(Hash:handle, const data[], len = -1);
+static cell AMX_NATIVE_CALL hash_update(AMX *amx, cell *params)
+{
+	Hasher *hasher = HashHandles.lookup(params[1]);
+
+	if (!hasher)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid hash handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	cell *data = get_amxaddr(amx, params[2]);
+	cell length = params[3];
+
+	if (length < 0)
+	{
+		for (length = 0; data[length]; ++length) {}
+	}
+
+	// A byte per cell, as with strings
+	unsigned char bytes[1024];
+
+	while (length > 0)
+	{
+		size_t count = ke::Min(static_cast<size_t>(length), sizeof(bytes));
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			bytes[i] = static_cast<unsigned char>(data[i]);
+		}
+
+		hasher->add(bytes, count);
+
+		data += count;
+		length -= static_cast<cell>(count);
+	}
+
+	return 1;
+}
+
+// native hash_final(Hash:handle, output[], maxlength);
+static cell AMX_NATIVE_CALL hash_final(AMX *amx, cell *params)
+{
+	Hasher *hasher = HashHandles.lookup(params[1]);
+
+	if (!hasher)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid hash handle provided (%d)", params[1]);
+		return 0;
+	}
+
+	char hash[MaxHashLength + 1];
+	hasher->finish(hash);
+
+	return set_amxstring(amx, params[2], hash, params[3]);
+}
+
+// native hash_destroy(&Hash:handle);
+static cell AMX_NATIVE_CALL hash_destroy(AMX *amx, cell *params)
+{
+	cell *ptr = get_amxaddr(amx, params[1]);
+
+	if (!HashHandles.lookup(*ptr))
+	{
+		return 0;
+	}
+
+	if (HashHandles.destroy(*ptr))
+	{
+		*ptr = 0;
+		return 1;
+	}
+
+	return 0;
+}
+
+// native hash_file_async(const file[], HashType:type, const callback[], const data[] = "", len = 0);
+static cell AMX_NATIVE_CALL hash_file_async(AMX *amx, cell *params)
+{
+	if (!IsValidHashType(amx, params[2]))
+	{
+		return 0;
+	}
+
+	if (params[5] < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid data length (%d)", params[5]);
+		return 0;
+	}
+
+	int length;
+	const char *function = get_amxstring(amx, params[3], 0, length);
+
+	int forward = registerSPForwardByName(amx, function, FP_CELL, FP_STRING, FP_STRING, FP_ARRAY, FP_CELL, FP_DONE);
+
+	if (forward == -1)
+	{
+		CPluginMngr::CPlugin *plugin = g_plugins.findPluginFast(amx);
+		LogError(amx, AMX_ERR_NATIVE, "Function is not present (function \"%s\") (plugin \"%s\")", function, plugin->getName());
+		return 0;
+	}
+
+	const char *file = get_amxstring(amx, params[1], 0, length);
+
+	return g_AsyncFiles.Hash(amx, forward, file, static_cast<HashType>(params[2]), get_amxaddr(amx, params[4]), params[5]);
+}
+
+AMX_NATIVE_INFO g_HashNatives[] =
+{
+	{ "hash_create",		hash_create },
+	{ "hash_update",		hash_update },
+	{ "hash_final",			hash_final },
+	{ "hash_destroy",		hash_destroy },
+	{ "hash_file_async",	hash_file_async },
+	{ nullptr,				nullptr },
+};
@@ -7,13 +7,13 @@
 // Additional exceptions apply. For full license details, see LICENSE.txt or visit:
 //     https://alliedmods.net/amxmodx-license
 
-#ifndef _INCLUDE_SOURCEMOD_THREAD_SUPPORT_H
-#define _INCLUDE_SOURCEMOD_THREAD_SUPPORT_H
+#ifndef _INCLUDE_HASHNATIVES_H_
+#define _INCLUDE_HASHNATIVES_H_
 
-#if defined __linux__ || defined __APPLE__
-#include "PosixThreads.h"
-#elif defined WIN32
-#include "WinThreads.h"
-#endif
+#include "hasher.h"
+#include "natives_handles.h"
 
-#endif //_INCLUDE_SOURCEMOD_THREAD_SUPPORT_H
+extern NativeHandle<Hasher> HashHandles;
+extern AMX_NATIVE_INFO g_HashNatives[];
+
+#endif // _INCLUDE_HASHNATIVES_H_
@@ -32,6 +32,9 @@
 #include <engine_strucs.h>
 #include <CDetour/detours.h>
 #include "CoreConfig.h"
+#include "CCoroutine.h"
+#include "CAsyncFile.h"
+#include "hashnatives.h"
 #include <resdk/mod_rehlds_api.h>
 #include <amtl/am-utility.h>
 
@@ -136,12 +139,16 @@ cvar_t init_amxmodx_mldebug = {"amx_mldebug", "", FCVAR_SPONLY};
 cvar_t init_amxmodx_language = {"amx_language", "en", FCVAR_SERVER};
 cvar_t init_amxmodx_cl_langs = {"amx_client_languages", "1", FCVAR_SERVER};
 cvar_t init_amxmodx_perflog = { "amx_perflog_ms", "1.0", FCVAR_SPONLY };
+cvar_t init_amxmodx_perfstats = { "amx_perfstats", "1", FCVAR_SPONLY };
+cvar_t init_amxmodx_taskbudget = { "amx_task_budget_ms", "2.0", FCVAR_SPONLY };
 
 cvar_t* amxmodx_version = NULL;
 cvar_t* amxmodx_modules = NULL;
 cvar_t* amxmodx_debug = NULL;
 cvar_t* amxmodx_language = NULL;
 cvar_t* amxmodx_perflog = NULL;
+cvar_t* amxmodx_perfstats = NULL;
+cvar_t* amxmodx_taskbudget = NULL;
 
 cvar_t* hostname = NULL;
 cvar_t* mp_timelimit = NULL;
@@ -432,6 +439,7 @@ int	C_Spawn(edict_t *pent)
 	DataPackHandles.clear();
 	TextParsersHandles.clear();
 	GameConfigHandle.clear();
+	HashHandles.clear();
 
 	char map_pluginsfile_path[256];
 	char prefixed_map_pluginsfile[256];
@@ -760,8 +768,26 @@ void C_ServerDeactivate_Post()
 	if (!g_initialized)
 		RETURN_META(MRES_IGNORED);
 
+	// Writes made in plugin_end() are still done, and reported
+	g_AsyncFiles.OnPluginsUnloading();
+
+	// Unwinds suspended coroutines while their plugins are still there
+	g_Coroutines.Clear();
+
+	// Before modules free their handles on unload
+	g_HandleStats.OnMapEnd();
+
 	modules_callPluginsUnloading();
 
+	// Modules have flushed what they needed, the rest is cancelled
+	g_ThreadPool.OnPluginsUnloading();
+
+	// Samples still point to the plugins
+	g_Profiler.Drain();
+
+	// Plugin ids are given again on the next map
+	g_PerfStats.Clear();
+
 	CoreCfg.Clear();
 
 	g_auth.clear();
@@ -1019,6 +1045,7 @@ void C_ClientPutInServer_Post(edict_t *pEntity)
 void C_ClientUserInfoChanged_Post(edict_t *pEntity, char *infobuffer)
 {
 	CPlayer *pPlayer = GET_PLAYER_POINTER(pEntity);
+	pPlayer->InvalidateLanguage();
 	executeForwards(FF_ClientInfoChanged, static_cast<cell>(pPlayer->index));
 	const char* name = INFOKEY_VALUE(infobuffer, "name");
 
@@ -1218,6 +1245,11 @@ void C_ClientCommand(edict_t *pEntity)
 
 void C_StartFrame_Post(void)
 {
+	if (g_Profiler.IsRunning())
+	{
+		g_Profiler.Drain();
+	}
+
 	if (g_auth_time < gpGlobals->time)
 	{
 		g_auth_time = gpGlobals->time + 0.7f;
@@ -1313,8 +1345,17 @@ void C_StartFrame_Post(void)
 
 	g_frameActionMngr.ExecuteFrameCallbacks();
 
+	// Before coroutines, which completed jobs may have resumed
+	g_ThreadPool.RunFrame();
+
+	g_Coroutines.RunFrame(gpGlobals->time);
+
 	if (g_task_time > gpGlobals->time)
+	{
+		// Deferrable tasks over the last frame's budget don't wait for the next task frame
+		g_tasksMngr.runDeferredTasks();
 		RETURN_META(MRES_IGNORED);
+	}
 
 	g_task_time = gpGlobals->time + 0.1f;
 	g_tasksMngr.startFrame();
@@ -1633,11 +1674,15 @@ C_DLLEXPORT	int	Meta_Attach(PLUG_LOADTIME now, META_FUNCTIONS *pFunctionTable, m
 	CVAR_REGISTER(&init_amxmodx_language);
 	CVAR_REGISTER(&init_amxmodx_cl_langs);
 	CVAR_REGISTER(&init_amxmodx_perflog);
+	CVAR_REGISTER(&init_amxmodx_perfstats);
+	CVAR_REGISTER(&init_amxmodx_taskbudget);
 
 	amxmodx_version = CVAR_GET_POINTER(init_amxmodx_version.name);
 	amxmodx_debug = CVAR_GET_POINTER(init_amxmodx_debug.name);
 	amxmodx_language = CVAR_GET_POINTER(init_amxmodx_language.name);
 	amxmodx_perflog = CVAR_GET_POINTER(init_amxmodx_perflog.name);
+	amxmodx_perfstats = CVAR_GET_POINTER(init_amxmodx_perfstats.name);
+	amxmodx_taskbudget = CVAR_GET_POINTER(init_amxmodx_taskbudget.name);
 
 	REG_SVR_COMMAND("amxx", amx_command);
 
@@ -1728,8 +1773,16 @@ C_DLLEXPORT	int	Meta_Detach(PLUG_LOADTIME now, PL_UNLOAD_REASON	reason)
 		return (FALSE);
 	}
 
+	g_AsyncFiles.OnPluginsUnloading();
+
+	g_Coroutines.Clear();
+
 	modules_callPluginsUnloading();
 
+	g_ThreadPool.Shutdown();
+
+	g_Profiler.Stop();
+
 	g_auth.clear();
 	g_forwards.clear();
 	g_commands.clear();
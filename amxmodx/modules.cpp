@@ -31,6 +31,9 @@
 #include "trie_natives.h"
 #include "CDataPack.h"
 #include "CGameConfigs.h"
+#include "datastructs.h"
+#include "CCoroutine.h"
+#include "hashnatives.h"
 #include <amtl/os/am-path.h>
 
 ke::InlineList<CModule> g_modules;
@@ -532,6 +535,8 @@ int set_amxnatives(AMX* amx, char error[128])
 	amx_Register(amx, g_TextParserNatives, -1);
 	amx_Register(amx, g_CvarNatives, -1);
 	amx_Register(amx, g_GameConfigNatives, -1);
+	amx_Register(amx, g_CoroutineNatives, -1);
+	amx_Register(amx, g_HashNatives, -1);
 
 	//we're not actually gonna check these here anymore
 	amx->flags |= AMX_FLAG_PRENIT;
@@ -1751,6 +1756,31 @@ IGameConfigManager *MNF_GetConfigManager()
 	return &ConfigManager;
 }
 
+IDataStructManager *MNF_GetDataStructManager()
+{
+	return &DataStructs;
+}
+
+IHandleStats *MNF_GetHandleStats()
+{
+	return &g_HandleStats;
+}
+
+int MNF_AddThreadJob(AMX *owner, const void *queue, THREADJOB_RUN run, THREADJOB_DONE done, void *data)
+{
+	return g_ThreadPool.AddJob(owner, queue, run, done, data);
+}
+
+int MNF_CancelThreadJob(int job)
+{
+	return g_ThreadPool.CancelJob(job) ? 1 : 0;
+}
+
+void MNF_WaitThreadJobs(const void *queue)
+{
+	g_ThreadPool.WaitJobs(queue);
+}
+
 void Module_CacheFunctions()
 {
 	REGISTER_FUNC("BuildPathname", build_pathname)
@@ -1764,6 +1794,8 @@ void Module_CacheFunctions()
 	REGISTER_FUNC("RegisterFunction", MNF_RegisterFunction);
 	REGISTER_FUNC("RegisterFunctionEx", MNF_RegisterFunctionEx);
 	REGISTER_FUNC("GetConfigManager", MNF_GetConfigManager);
+	REGISTER_FUNC(DATASTRUCTS_FUNC, MNF_GetDataStructManager);
+	REGISTER_FUNC(HANDLESTATS_FUNC, MNF_GetHandleStats);
 
 	// Amx scripts loading / unloading / managing
 	REGISTER_FUNC("GetAmxScript", MNF_GetAmxScript)
@@ -1848,6 +1880,10 @@ void Module_CacheFunctions()
 
 	REGISTER_FUNC("MessageBlock", MNF_MessageBlock);
 
+	REGISTER_FUNC("AddThreadJob", MNF_AddThreadJob);
+	REGISTER_FUNC("CancelThreadJob", MNF_CancelThreadJob);
+	REGISTER_FUNC("WaitThreadJobs", MNF_WaitThreadJobs);
+
 #ifdef MEMORY_TEST
 	REGISTER_FUNC("Allocator", m_allocator)
 	REGISTER_FUNC("Deallocator", m_deallocator)
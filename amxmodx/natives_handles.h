@@ -12,22 +12,48 @@
 
 #include <amtl/am-vector.h>
 #include <amtl/am-autoptr.h>
+#include "CHandleStats.h"
 
 // Note: All handles start at 1. 0 and below are invalid handles.
 //       This way, a plugin that doesn't initialize a vector or
 //       string will not be able to modify another plugin's data
 //       on accident.
+//
+//       The low bits of a handle hold its slot (plus one), the high bits
+//       the generation of that slot, bumped each time an object is destroyed.
+//       Handles stay positive and those of never reused slots are the same
+//       as before (1, 2, 3...), while a handle kept after its object was
+//       destroyed no longer resolves once the slot is reused.
+//       Freed slots are reused in FIFO order to delay generation wrapping.
+//
+//       Each object records the plugin whose native created it, for "amxx handles".
 
 template <typename T>
 class NativeHandle
 {
 	private:
 
-		ke::Vector<ke::AutoPtr<T>> m_handles;
+		static const size_t SlotBits = 20;
+		static const size_t SlotMask = (1 << SlotBits) - 1;
+		static const size_t MaxSlots = SlotMask;
+		static const size_t GenerationMask = (1 << (31 - SlotBits)) - 1;
+		static const size_t InvalidSlot = static_cast<size_t>(-1);
+
+		struct Slot
+		{
+			ke::AutoPtr<T> object;
+			size_t generation;
+			size_t nextFree;
+			int owner;
+		};
+
+		ke::Vector<Slot> m_handles;
+		size_t m_freeHead;
+		size_t m_freeTail;
 
 	public:
 
-		NativeHandle() {}
+		NativeHandle() : m_freeHead(InvalidSlot), m_freeTail(InvalidSlot) {}
 		~NativeHandle()
 		{
 			this->clear();
@@ -36,78 +62,133 @@ class NativeHandle
 		void clear()
 		{
 			m_handles.clear();
+
+			m_freeHead = InvalidSlot;
+			m_freeTail = InvalidSlot;
 		}
 
+		// Number of slots, valid or not. Use with slot() to walk every object.
 		size_t size()
 		{
 			return m_handles.length();
 		}
 
-		T *lookup(size_t handle)
+		T *slot(size_t index)
 		{
-			--handle;
-
-			if (handle >= m_handles.length())
+			if (index >= m_handles.length())
 			{
 				return nullptr;
 			}
 
-			return m_handles[handle].get();
+			return m_handles[index].object.get();
 		}
 
-		template <typename... Targs>
-		size_t create(Targs... Fargs)
+		// Plugin id of the creator of a slot's object, -1 if not created from a native.
+		int owner(size_t index)
 		{
-			for (size_t i = 0; i < m_handles.length(); ++i)
+			if (index >= m_handles.length())
 			{
-				if (!m_handles[i])
-				{
-					m_handles[i] = ke::AutoPtr<T>(new T(Fargs...));
-
-					return i + 1;
-				}
+				return -1;
 			}
 
-			m_handles.append(ke::AutoPtr<T>(new T(Fargs...)));
-
-			return m_handles.length();
+			return m_handles[index].owner;
 		}
 
-		size_t clone(T *data)
+		T *lookup(size_t handle)
 		{
-			for (size_t i = 0; i < m_handles.length(); ++i)
+			size_t index = (handle & SlotMask) - 1;
+
+			if (handle > (GenerationMask << SlotBits | SlotMask) || index >= m_handles.length())
 			{
-				if (!m_handles[i])
-				{
-					m_handles[i] = ke::AutoPtr<T>(data);
+				return nullptr;
+			}
 
-					return i + 1;
-				}
+			Slot &entry = m_handles[index];
+
+			if (entry.generation != handle >> SlotBits)
+			{
+				return nullptr;
 			}
 
-			m_handles.append(ke::AutoPtr<T>(data));
+			return entry.object.get();
+		}
 
-			return m_handles.length();
+		template <typename... Targs>
+		size_t create(Targs... Fargs)
+		{
+			return store(new T(Fargs...));
 		}
 
-		bool destroy(size_t handle)
+		size_t clone(T *data)
 		{
-			--handle;
+			return store(data);
+		}
 
-			if (handle >= m_handles.length())
+		bool destroy(size_t handle)
+		{
+			if (!lookup(handle))
 			{
 				return false;
 			}
 
-			if (!m_handles[handle])
+			size_t index = (handle & SlotMask) - 1;
+			Slot &entry = m_handles[index];
+
+			entry.object = nullptr;
+			entry.generation = (entry.generation + 1) & GenerationMask;
+			entry.nextFree = InvalidSlot;
+
+			if (m_freeTail != InvalidSlot)
 			{
-				return false;
+				m_handles[m_freeTail].nextFree = index;
+			}
+			else
+			{
+				m_freeHead = index;
 			}
 
-			m_handles[handle] = nullptr;
+			m_freeTail = index;
 
 			return true;
 		}
+
+	private:
+
+		size_t store(T *data)
+		{
+			size_t index = m_freeHead;
+
+			if (index != InvalidSlot)
+			{
+				m_freeHead = m_handles[index].nextFree;
+
+				if (m_freeHead == InvalidSlot)
+				{
+					m_freeTail = InvalidSlot;
+				}
+			}
+			else
+			{
+				if (m_handles.length() >= MaxSlots)
+				{
+					delete data;
+					return 0;
+				}
+
+				Slot entry;
+				entry.generation = 0;
+				entry.nextFree = InvalidSlot;
+
+				m_handles.append(ke::Move(entry));
+				index = m_handles.length() - 1;
+			}
+
+			Slot &entry = m_handles[index];
+			entry.object = ke::AutoPtr<T>(data);
+			entry.owner = g_HandleStats.GetCallingPlugin();
+
+			return (entry.generation << SlotBits) | (index + 1);
+		}
 };
 
 enum ForwardState
@@ -8,9 +8,11 @@
 //     https://alliedmods.net/amxmodx-license
 
 #include "amxmodx.h"
+#include "debugger.h"
 #include <stdlib.h>
 #include <time.h>
 #include "datastructs.h"
+#include "sorting.h"
 
 /***********************************
  *   About the double array hack   *
@@ -65,14 +67,220 @@ enum SortOrder
 	Sort_Random = 2,
 };
 
-int sort_ints_asc(const void *int1, const void *int2)
+/**
+ * Radix sorting
+ *
+ * Integers map to unsigned keys by flipping the sign bit. Floats map by flipping the sign bit
+ * of positive values and all bits of negative values, so -1.0 < -0.0 < 0.0 < 1.0 holds for keys.
+ * Small inputs go through pdqsort, larger ones through four 8-bit LSD passes where passes
+ * with a single populated bucket are skipped.
+ */
+
+static const size_t RadixSortThreshold = 64;
+
+static inline ucell sort_key(cell value, bool floats, bool descending)
+{
+	ucell key = static_cast<ucell>(value);
+
+	if (floats)
+	{
+		key = (key & 0x80000000) ? ~key : (key | 0x80000000);
+	}
+	else
+	{
+		key ^= 0x80000000;
+	}
+
+	return descending ? ~key : key;
+}
+
+static inline cell sort_value(ucell key, bool floats, bool descending)
+{
+	if (descending)
+	{
+		key = ~key;
+	}
+
+	if (floats)
+	{
+		key = (key & 0x80000000) ? (key & 0x7FFFFFFF) : ~key;
+	}
+	else
+	{
+		key ^= 0x80000000;
+	}
+
+	return static_cast<cell>(key);
+}
+
+struct RadixItem
+{
+	ucell key;
+	ucell index;
+};
+
+static inline ucell radix_key(ucell key)
 {
-	return (*(int *)int1) - (*(int *)int2);
+	return key;
 }
 
-int sort_ints_desc(const void *int1, const void *int2)
+static inline ucell radix_key(const RadixItem &item)
+{
+	return item.key;
+}
+
+struct RadixKeyLess
+{
+	bool operator()(ucell a, ucell b) const
+	{
+		return a < b;
+	}
+
+	bool operator()(const RadixItem &a, const RadixItem &b) const
+	{
+		return a.key < b.key || (a.key == b.key && a.index < b.index);
+	}
+};
+
+// Sorts by key, keeping equal keys in their original order. Returns the buffer holding the result.
+template <typename T>
+static T *radix_sort(T *array, T *temp, size_t count)
 {
-	return (*(int *)int2) - (*(int *)int1);
+	size_t histogram[4][256];
+	memset(histogram, 0, sizeof(histogram));
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		ucell key = radix_key(array[i]);
+
+		++histogram[0][key & 0xFF];
+		++histogram[1][(key >> 8) & 0xFF];
+		++histogram[2][(key >> 16) & 0xFF];
+		++histogram[3][key >> 24];
+	}
+
+	T *source = array;
+	T *dest = temp;
+
+	for (size_t pass = 0; pass < 4; ++pass)
+	{
+		size_t *buckets = histogram[pass];
+		size_t shift = pass * 8;
+
+		if (buckets[(radix_key(source[0]) >> shift) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		for (size_t i = 0, offset = 0; i < 256; ++i)
+		{
+			size_t bucket = buckets[i];
+			buckets[i] = offset;
+			offset += bucket;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			dest[buckets[(radix_key(source[i]) >> shift) & 0xFF]++] = source[i];
+		}
+
+		T *swap = source;
+		source = dest;
+		dest = swap;
+	}
+
+	return source;
+}
+
+void RadixSortCells(cell *array, size_t count, bool floats, bool descending)
+{
+	if (count < 2)
+	{
+		return;
+	}
+
+	ucell *keys = reinterpret_cast<ucell *>(array);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = sort_key(array[i], floats, descending);
+	}
+
+	if (count < RadixSortThreshold)
+	{
+		pdqsort(keys, keys + count, RadixKeyLess());
+	}
+	else
+	{
+		ucell *temp = new ucell[count];
+
+		if (radix_sort(keys, temp, count) == temp)
+		{
+			memcpy(keys, temp, count * sizeof(ucell));
+		}
+
+		delete [] temp;
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		array[i] = sort_value(keys[i], floats, descending);
+	}
+}
+
+// Reorders blocks of blocksize cells so that the block at order[i] ends up at position i.
+static void gather_blocks(cell *base, size_t count, size_t blocksize, const RadixItem *order)
+{
+	cell *temp = new cell[count * blocksize];
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		memcpy(&temp[i * blocksize], &base[order[i].index * blocksize], blocksize * sizeof(cell));
+	}
+
+	memcpy(base, temp, count * blocksize * sizeof(cell));
+
+	delete [] temp;
+}
+
+void RadixSortBlocks(cell *base, size_t count, size_t blocksize, size_t column, bool floats, bool descending)
+{
+	if (blocksize == 1)
+	{
+		RadixSortCells(base, count, floats, descending);
+		return;
+	}
+
+	if (count < 2)
+	{
+		return;
+	}
+
+	RadixItem *items = new RadixItem[count];
+	RadixItem *order = items;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		items[i].key = sort_key(base[i * blocksize + column], floats, descending);
+		items[i].index = static_cast<ucell>(i);
+	}
+
+	RadixItem *temp = NULL;
+
+	if (count < RadixSortThreshold)
+	{
+		pdqsort(items, items + count, RadixKeyLess());
+	}
+	else
+	{
+		temp = new RadixItem[count];
+		order = radix_sort(items, temp, count);
+	}
+
+	gather_blocks(base, count, blocksize, order);
+
+	delete [] temp;
+	delete [] items;
 }
 
 void sort_random(cell *array, cell size)
@@ -98,14 +306,15 @@ static cell AMX_NATIVE_CALL SortIntegers(AMX *amx, cell *params)
 	cell array_size = params[2];
 	cell type = params[3];
 
-	if (type == Sort_Ascending) 
+	if (array_size < 2)
 	{
-		qsort(array, array_size, sizeof(cell), sort_ints_asc);
-	} 
-	else if (type == Sort_Descending) 
+		return 1;
+	}
+
+	if (type == Sort_Ascending || type == Sort_Descending)
 	{
-		qsort(array, array_size, sizeof(cell), sort_ints_desc);
-	} 
+		RadixSortCells(array, array_size, false, type == Sort_Descending);
+	}
 	else
 	{
 		sort_random(array, array_size);
@@ -114,49 +323,20 @@ static cell AMX_NATIVE_CALL SortIntegers(AMX *amx, cell *params)
 	return 1;
 }
 
-int sort_floats_asc(const void *float1, const void *float2)
-{
-	REAL r1 = *(REAL *)float1;
-	REAL r2 = *(REAL *)float2;
-	
-	if (r1 < r2)
-	{
-		return -1;
-	} else if (r2 < r1) {
-		return 1;
-	} else {
-		return 0;
-	}
-}
-
-int sort_floats_desc(const void *float1, const void *float2)
-{
-	REAL r1 = *(REAL *)float1;
-	REAL r2 = *(REAL *)float2;
-
-	if (r1 < r2)
-	{
-		return 1;
-	} else if (r2 < r1) {
-		return -1;
-	} else {
-		return 0;
-	}
-}
-
 static cell AMX_NATIVE_CALL SortFloats(AMX *amx, cell *params)
 {
 	cell *array = get_amxaddr(amx, params[1]);
 	cell array_size = params[2];
 	cell type = params[3];
 
-	if (type == Sort_Ascending)
+	if (array_size < 2)
 	{
-		qsort(array, array_size, sizeof(cell), sort_floats_asc);
-	} 
-	else if (type == Sort_Descending)
+		return 1;
+	}
+
+	if (type == Sort_Ascending || type == Sort_Descending)
 	{
-		qsort(array, array_size, sizeof(cell), sort_floats_desc);
+		RadixSortCells(array, array_size, true, type == Sort_Descending);
 	}
 	else
 	{
@@ -207,6 +387,16 @@ int sort_strings_desc(const void *blk1, const void *blk2)
 	return (*(str2 - 1) - *str1);
 }
 
+struct StringIndexLess
+{
+	bool descending;
+
+	bool operator()(cell reloc1, cell reloc2) const
+	{
+		return (descending ? sort_strings_desc(&reloc1, &reloc2) : sort_strings_asc(&reloc1, &reloc2)) < 0;
+	}
+};
+
 static cell AMX_NATIVE_CALL SortStrings(AMX *amx, cell *params)
 {
 	cell *array = get_amxaddr(amx, params[1]);
@@ -231,13 +421,10 @@ static cell AMX_NATIVE_CALL SortStrings(AMX *amx, cell *params)
 		array[i] = i;
 	}
 
-	if (type == Sort_Ascending)
+	if (type == Sort_Ascending || type == Sort_Descending)
 	{
-		qsort(array, array_size, sizeof(cell), sort_strings_asc);
-	} 
-	else if (type == Sort_Descending)
-	{
-		qsort(array, array_size, sizeof(cell), sort_strings_desc);
+		StringIndexLess less = { type == Sort_Descending };
+		pdqsort(array, array + array_size, less);
 	}
 	else
 	{
@@ -263,28 +450,90 @@ static cell AMX_NATIVE_CALL SortStrings(AMX *amx, cell *params)
 	return 1;
 }
 
-struct sort_info
+SortComparator::SortComparator(AMX *amx) : m_Amx(amx), m_Func(-1), m_Debugger(NULL), m_Running(false), m_Failed(false)
 {
-	int pfn;
-	cell data_addr;
-	cell data_size;
-	cell array_addr;
-	cell *array_base;
-	cell *array_remap;
-	AMX *amx;
-};
+}
+
+SortComparator::~SortComparator()
+{
+	if (m_Running && m_Debugger)
+	{
+		m_Debugger->EndExec();
+	}
+}
+
+bool SortComparator::Begin(const char *funcName)
+{
+	if (amx_FindPublic(m_Amx, funcName, &m_Func) != AMX_ERR_NONE)
+	{
+		return false;
+	}
+
+	CPluginMngr::CPlugin *pPlugin = g_plugins.findPluginFast(m_Amx);
+
+	// Same as a forward to a paused plugin: every comparison yields 0.
+	m_Failed = !pPlugin || !pPlugin->isExecutable(m_Func);
+	m_Debugger = (Debugger *)m_Amx->userdata[UD_DEBUGGER];
 
-static CStack<sort_info *> g_AMXSortStack;
+	if (m_Debugger)
+	{
+		m_Debugger->BeginExec();
+	}
 
-int sort1d_amx_custom(const void *elem1, const void *elem2)
+	m_Running = true;
+
+	return true;
+}
+
+cell SortComparator::Call(cell param1, cell param2, cell param3, cell param4, cell param5)
 {
-	cell c1 = *(cell *)elem1;
-	cell c2 = *(cell *)elem2;
-	sort_info *pInfo = g_AMXSortStack.front();
+	if (m_Failed)
+	{
+		return 0;
+	}
+
+	amx_Push(m_Amx, param5);
+	amx_Push(m_Amx, param4);
+	amx_Push(m_Amx, param3);
+	amx_Push(m_Amx, param2);
+	amx_Push(m_Amx, param1);
+
+	cell retVal = 0;
+	int err = amx_Exec(m_Amx, &retVal, m_Func);
+
+	if (err != AMX_ERR_NONE)
+	{
+		if (m_Debugger && m_Debugger->ErrorExists())
+		{
+			// Already logged.
+		}
+		else if (err != -1)
+		{
+			LogError(m_Amx, err, NULL);
+		}
+
+		m_Amx->error = AMX_ERR_NONE;
+		m_Failed = true;
+
+		return 0;
+	}
 
-	return executeForwards(pInfo->pfn, c1, c2, pInfo->array_addr, pInfo->data_addr, pInfo->data_size);
+	return retVal;
 }
 
+struct Custom1DCompare
+{
+	SortComparator *comparator;
+	cell array_addr;
+	cell data_addr;
+	cell data_size;
+
+	cell operator()(cell elem1, cell elem2)
+	{
+		return comparator->Call(elem1, elem2, array_addr, data_addr, data_size);
+	}
+};
+
 static cell AMX_NATIVE_CALL SortCustom1D(AMX *amx, cell *params)
 {
 	cell *array = get_amxaddr(amx, params[1]);
@@ -292,46 +541,41 @@ static cell AMX_NATIVE_CALL SortCustom1D(AMX *amx, cell *params)
 	int len;
 	const char *funcname = get_amxstring(amx, params[3], 0, len);
 
-	int pfn = registerSPForwardByName(amx, funcname, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_DONE);
-	if (pfn < 0)
+	SortComparator comparator(amx);
+
+	if (!comparator.Begin(funcname))
 	{
 		LogError(amx, AMX_ERR_NATIVE, "The public function \"%s\" was not found.", funcname);
 		return 0;
 	}
 
-	sort_info *pInfo = new sort_info;
-
-	pInfo->pfn = pfn;
-	pInfo->data_addr = params[4];
-	pInfo->data_size = params[5];
-	pInfo->array_addr = params[1];
-	pInfo->array_remap = NULL;
-	pInfo->array_base = NULL;
-
-	g_AMXSortStack.push(pInfo);
-	qsort(array, array_size, sizeof(cell), sort1d_amx_custom);
-	g_AMXSortStack.pop();
+	if (array_size < 2)
+	{
+		return 1;
+	}
 
-	unregisterSPForward(pfn);
-	delete pInfo;
+	Custom1DCompare compare = { &comparator, params[1], params[4], params[5] };
+	MergeInsertionSort(array, array + array_size, compare);
 
 	return 1;
 }
 
-int sort2d_amx_custom(const void *elem1, const void *elem2)
+struct Custom2DCompare
 {
-	cell c1 = *(cell *)elem1;
-	cell c2 = *(cell *)elem2;
-	sort_info *pInfo = g_AMXSortStack.front();
-
-	cell c1_addr = pInfo->array_addr + (c1 * sizeof(cell)) + pInfo->array_remap[c1];
-	cell c2_addr = pInfo->array_addr + (c2 * sizeof(cell)) + pInfo->array_remap[c2];
+	SortComparator *comparator;
+	cell array_addr;
+	cell *array_remap;
+	cell data_addr;
+	cell data_size;
 
-	//cell *c1_r = get_amxaddr(pInfo->amx, c1_addr);
-	//cell *c2_r = get_amxaddr(pInfo->amx, c2_addr);
+	cell operator()(cell c1, cell c2)
+	{
+		cell c1_addr = array_addr + (c1 * sizeof(cell)) + array_remap[c1];
+		cell c2_addr = array_addr + (c2 * sizeof(cell)) + array_remap[c2];
 
-	return executeForwards(pInfo->pfn, c1_addr, c2_addr, pInfo->array_addr, pInfo->data_addr, pInfo->data_size);
-}
+		return comparator->Call(c1_addr, c2_addr, array_addr, data_addr, data_size);
+	}
+};
 
 static cell AMX_NATIVE_CALL SortCustom2D(AMX *amx, cell *params)
 {
@@ -340,6 +584,19 @@ static cell AMX_NATIVE_CALL SortCustom2D(AMX *amx, cell *params)
 	int len;
 	const char *funcname = get_amxstring(amx, params[3], 0, len);
 
+	SortComparator comparator(amx);
+
+	if (!comparator.Begin(funcname))
+	{
+		LogError(amx, AMX_ERR_NATIVE, "The public function \"%s\" was not found.", funcname);
+		return 0;
+	}
+
+	if (array_size < 2)
+	{
+		return 1;
+	}
+
 	/** back up the old indices, replace the indices with something easier */
 	cell amx_addr, *phys_addr;
 	int err;
@@ -349,35 +606,15 @@ static cell AMX_NATIVE_CALL SortCustom2D(AMX *amx, cell *params)
 		return 0;
 	}
 
-	int pfn = registerSPForwardByName(amx, funcname, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_CELL, FP_DONE);
-	if (pfn < 0)
-	{
-		amx_Release(amx, amx_addr);
-		LogError(amx, AMX_ERR_NATIVE, "The public function \"%s\" was not found.", funcname);
-		return 0;
-	}
-
-	sort_info *pInfo = new sort_info;
-
-	pInfo->pfn = pfn;
-	pInfo->data_addr = params[4];
-	pInfo->data_size = params[5];
-	pInfo->array_addr = params[1];
-	pInfo->amx = amx;
-
 	/** Same process as in strings, back up the old indices for later fixup */
-	pInfo->array_base = array;
-	pInfo->array_remap = phys_addr;
-	
 	for (int i=0; i<array_size; i++)
 	{
 		phys_addr[i] = array[i];
 		array[i] = i;
 	}
 
-	g_AMXSortStack.push(pInfo);
-	qsort(array, array_size, sizeof(cell), sort2d_amx_custom);
-	g_AMXSortStack.pop();
+	Custom2DCompare compare = { &comparator, params[1], phys_addr, params[4], params[5] };
+	MergeInsertionSort(array, array + array_size, compare);
 
 	/** Fixup process! */
 	for (int i=0; i<array_size; i++)
@@ -389,8 +626,6 @@ static cell AMX_NATIVE_CALL SortCustom2D(AMX *amx, cell *params)
 	}
 
 	amx_Release(amx, amx_addr);
-	unregisterSPForward(pInfo->pfn);
-	delete pInfo;
 
 	return 1;
 }
@@ -415,15 +650,24 @@ int strcellcmp(cell *s1, cell *s2)
 	return (*(byte *)s1 < *(byte *)s2) ? -1 : +1;
 }
 
-int sort_adtarray_strings_asc(const void *str1, const void *str2)
+// Orders block indices by the string starting at the given column, ties keep their original order.
+struct BlockStringLess
 {
-	return strcellcmp((cell *)str1, (cell *)str2);
-}
+	cell *base;
+	size_t blocksize;
+	size_t column;
+	bool descending;
 
-int sort_adtarray_strings_desc(const void *str1, const void *str2)
-{
-	return strcellcmp((cell *)str2, (cell *)str1);
-}
+	bool operator()(const RadixItem &a, const RadixItem &b) const
+	{
+		cell *str1 = &base[a.index * blocksize + column];
+		cell *str2 = &base[b.index * blocksize + column];
+
+		int result = descending ? strcellcmp(str2, str1) : strcellcmp(str1, str2);
+
+		return result < 0 || (result == 0 && a.index < b.index);
+	}
+};
 
 void sort_adt_random(CellArray *cArray)
 {
@@ -439,6 +683,53 @@ void sort_adt_random(CellArray *cArray)
 	}
 }
 
+void sort_adt_strings(CellArray *cArray, size_t column, bool descending)
+{
+	size_t arraysize = cArray->size();
+
+	if (arraysize < 2)
+	{
+		return;
+	}
+
+	RadixItem *order = new RadixItem[arraysize];
+
+	for (size_t i = 0; i < arraysize; ++i)
+	{
+		order[i].key = 0;
+		order[i].index = static_cast<ucell>(i);
+	}
+
+	BlockStringLess less = { cArray->base(), cArray->blocksize(), column, descending };
+	pdqsort(order, order + arraysize, less);
+
+	gather_blocks(cArray->base(), arraysize, cArray->blocksize(), order);
+
+	delete [] order;
+}
+
+void sort_adt_column(CellArray *cArray, size_t column, cell order, cell type)
+{
+	if (order == Sort_Random)
+	{
+		sort_adt_random(cArray);
+		return;
+	}
+
+	bool descending = order == Sort_Descending;
+
+	cArray->invalidate_index();
+
+	if (type == Sort_String)
+	{
+		sort_adt_strings(cArray, column, descending);
+	}
+	else if (type == Sort_Integer || type == Sort_Float)
+	{
+		RadixSortBlocks(cArray->base(), cArray->size(), cArray->blocksize(), column, type == Sort_Float, descending);
+	}
+}
+
 static cell AMX_NATIVE_CALL SortADTArray(AMX *amx, cell *params)
 {
 	CellArray* vec = ArrayHandles.lookup(params[1]);
@@ -449,58 +740,43 @@ static cell AMX_NATIVE_CALL SortADTArray(AMX *amx, cell *params)
 		return 0;
 	}
 
-	cell order = params[2];
-
-	if (order == Sort_Random)
-	{
-		sort_adt_random(vec);
+	sort_adt_column(vec, 0, params[2], params[3]);
 
-		return 1;
-	}
+	return 1;
+}
 
-	cell type = params[3];
-	size_t arraysize = vec->size();
-	size_t blocksize = vec->blocksize();
-	cell *array = vec->base();
+// native SortADTArrayByColumn(Array:array, column, SortMethod:order, SortType:type);
+static cell AMX_NATIVE_CALL SortADTArrayByColumn(AMX *amx, cell *params)
+{
+	CellArray* vec = ArrayHandles.lookup(params[1]);
 
-	if (type == Sort_Integer)
+	if (!vec)
 	{
-		if (order == Sort_Ascending)
-		{
-			qsort(array, arraysize, blocksize * sizeof(cell), sort_ints_asc);
-		}
-		else
-		{
-			qsort(array, arraysize, blocksize * sizeof(cell), sort_ints_desc);
-		}
+		LogError(amx, AMX_ERR_NATIVE, "Invalid array handle provided (%d)", params[1]);
+		return 0;
 	}
-	else if (type == Sort_Float)
+
+	cell column = params[2];
+
+	if (column < 0 || (size_t)column >= vec->blocksize())
 	{
-		if (order == Sort_Ascending)
-		{
-			qsort(array, arraysize, blocksize * sizeof(cell), sort_floats_asc);
-		}
-		else 
-		{
-			qsort(array, arraysize, blocksize * sizeof(cell), sort_floats_desc);
-		}
+		LogError(amx, AMX_ERR_NATIVE, "Invalid column %d (block size %d)", column, vec->blocksize());
+		return 0;
 	}
-	else if (type == Sort_String)
+
+	cell type = params[4];
+
+	if (type < Sort_Integer || type > Sort_String)
 	{
-		if (order == Sort_Ascending)
-		{
-			qsort(array, arraysize, blocksize * sizeof(cell), sort_adtarray_strings_asc);
-		}
-		else 
-		{
-			qsort(array, arraysize, blocksize * sizeof(cell), sort_adtarray_strings_desc);
-		}
+		LogError(amx, AMX_ERR_NATIVE, "Invalid sort type %d", type);
+		return 0;
 	}
 
+	sort_adt_column(vec, column, params[3], type);
+
 	return 1;
 }
 
-
 AMX_NATIVE_INFO g_SortNatives[] = 
 {
 	{"SortIntegers",			SortIntegers},
@@ -509,6 +785,7 @@ AMX_NATIVE_INFO g_SortNatives[] =
 	{"SortCustom1D",			SortCustom1D},
 	{"SortCustom2D",			SortCustom2D},
 	{"SortADTArray",			SortADTArray},
+	{"SortADTArrayByColumn",	SortADTArrayByColumn},
 
 	{NULL,						NULL},
 };
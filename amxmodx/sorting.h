@@ -0,0 +1,539 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_SORTING_H
+#define _INCLUDE_SORTING_H
+
+class Debugger;
+
+/**
+ * Pattern-defeating quicksort (after Orson Peters' pdqsort).
+ *
+ * Introsort with median-of-3/ninther pivots, a partition for runs of equal elements,
+ * early exit on already sorted partitions and a heapsort fallback when too many
+ * partitions are unbalanced. Less(a, b) must return true when a goes before b.
+ */
+
+namespace pdqsort_detail
+{
+	static const size_t InsertionSortThreshold = 24;
+	static const size_t NintherThreshold = 128;
+	static const size_t PartialInsertionSortLimit = 8;
+
+	template <typename T>
+	inline void Swap(T &a, T &b)
+	{
+		T temp = a;
+		a = b;
+		b = temp;
+	}
+
+	template <typename T, typename Less>
+	inline void Sort2(T *a, T *b, Less &less)
+	{
+		if (less(*b, *a))
+		{
+			Swap(*a, *b);
+		}
+	}
+
+	template <typename T, typename Less>
+	inline void Sort3(T *a, T *b, T *c, Less &less)
+	{
+		Sort2(a, b, less);
+		Sort2(b, c, less);
+		Sort2(a, b, less);
+	}
+
+	template <typename T, typename Less>
+	void InsertionSort(T *begin, T *end, Less &less)
+	{
+		if (begin == end)
+		{
+			return;
+		}
+
+		for (T *cur = begin + 1; cur != end; ++cur)
+		{
+			T *sift = cur;
+			T *sift_1 = cur - 1;
+
+			if (less(*sift, *sift_1))
+			{
+				T temp = *sift;
+
+				do
+				{
+					*sift-- = *sift_1;
+				} while (sift != begin && less(temp, *--sift_1));
+
+				*sift = temp;
+			}
+		}
+	}
+
+	// Assumes *(begin - 1) is not greater than any element of the range.
+	template <typename T, typename Less>
+	void UnguardedInsertionSort(T *begin, T *end, Less &less)
+	{
+		if (begin == end)
+		{
+			return;
+		}
+
+		for (T *cur = begin + 1; cur != end; ++cur)
+		{
+			T *sift = cur;
+			T *sift_1 = cur - 1;
+
+			if (less(*sift, *sift_1))
+			{
+				T temp = *sift;
+
+				do
+				{
+					*sift-- = *sift_1;
+				} while (less(temp, *--sift_1));
+
+				*sift = temp;
+			}
+		}
+	}
+
+	// Gives up and returns false once too many elements had to be moved.
+	template <typename T, typename Less>
+	bool PartialInsertionSort(T *begin, T *end, Less &less)
+	{
+		if (begin == end)
+		{
+			return true;
+		}
+
+		size_t limit = 0;
+
+		for (T *cur = begin + 1; cur != end; ++cur)
+		{
+			T *sift = cur;
+			T *sift_1 = cur - 1;
+
+			if (less(*sift, *sift_1))
+			{
+				T temp = *sift;
+
+				do
+				{
+					*sift-- = *sift_1;
+				} while (sift != begin && less(temp, *--sift_1));
+
+				*sift = temp;
+				limit += cur - sift;
+			}
+
+			if (limit > PartialInsertionSortLimit)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename T, typename Less>
+	void SiftDown(T *base, size_t root, size_t size, Less &less)
+	{
+		T value = base[root];
+
+		while (true)
+		{
+			size_t child = root * 2 + 1;
+
+			if (child >= size)
+			{
+				break;
+			}
+
+			if (child + 1 < size && less(base[child], base[child + 1]))
+			{
+				++child;
+			}
+
+			if (!less(value, base[child]))
+			{
+				break;
+			}
+
+			base[root] = base[child];
+			root = child;
+		}
+
+		base[root] = value;
+	}
+
+	template <typename T, typename Less>
+	void HeapSort(T *begin, T *end, Less &less)
+	{
+		size_t size = end - begin;
+
+		for (size_t i = size / 2; i-- > 0; )
+		{
+			SiftDown(begin, i, size, less);
+		}
+
+		for (size_t i = size; i-- > 1; )
+		{
+			Swap(begin[0], begin[i]);
+			SiftDown(begin, 0, i, less);
+		}
+	}
+
+	// Partitions around *begin, elements equal to the pivot go to the right.
+	// Returns the pivot position, sets alreadyPartitioned if no element had to be swapped.
+	template <typename T, typename Less>
+	T *PartitionRight(T *begin, T *end, Less &less, bool &alreadyPartitioned)
+	{
+		T pivot = *begin;
+		T *first = begin;
+		T *last = end;
+
+		while (less(*++first, pivot));
+
+		if (first - 1 == begin)
+		{
+			while (first < last && !less(*--last, pivot));
+		}
+		else
+		{
+			while (!less(*--last, pivot));
+		}
+
+		alreadyPartitioned = first >= last;
+
+		while (first < last)
+		{
+			Swap(*first, *last);
+			while (less(*++first, pivot));
+			while (!less(*--last, pivot));
+		}
+
+		T *pivotPos = first - 1;
+		*begin = *pivotPos;
+		*pivotPos = pivot;
+
+		return pivotPos;
+	}
+
+	// Partitions around *begin, elements equal to the pivot go to the left.
+	template <typename T, typename Less>
+	T *PartitionLeft(T *begin, T *end, Less &less)
+	{
+		T pivot = *begin;
+		T *first = begin;
+		T *last = end;
+
+		while (less(pivot, *--last));
+
+		if (last + 1 == end)
+		{
+			while (first < last && !less(pivot, *++first));
+		}
+		else
+		{
+			while (!less(pivot, *++first));
+		}
+
+		while (first < last)
+		{
+			Swap(*first, *last);
+			while (less(pivot, *--last));
+			while (!less(pivot, *++first));
+		}
+
+		T *pivotPos = last;
+		*begin = *pivotPos;
+		*pivotPos = pivot;
+
+		return pivotPos;
+	}
+
+	template <typename T, typename Less>
+	void Loop(T *begin, T *end, Less &less, int badAllowed, bool leftmost)
+	{
+		while (true)
+		{
+			size_t size = end - begin;
+
+			if (size < InsertionSortThreshold)
+			{
+				if (leftmost)
+				{
+					InsertionSort(begin, end, less);
+				}
+				else
+				{
+					UnguardedInsertionSort(begin, end, less);
+				}
+				return;
+			}
+
+			// Move the chosen pivot to *begin.
+			size_t half = size / 2;
+
+			if (size > NintherThreshold)
+			{
+				Sort3(begin, begin + half, end - 1, less);
+				Sort3(begin + 1, begin + (half - 1), end - 2, less);
+				Sort3(begin + 2, begin + (half + 1), end - 3, less);
+				Sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+				Swap(*begin, *(begin + half));
+			}
+			else
+			{
+				Sort3(begin + half, begin, end - 1, less);
+			}
+
+			// The predecessor is never greater than the range, if it's equal to the pivot
+			// the range holds many equal elements: put them all on the left and skip them.
+			if (!leftmost && !less(*(begin - 1), *begin))
+			{
+				begin = PartitionLeft(begin, end, less) + 1;
+				continue;
+			}
+
+			bool alreadyPartitioned;
+			T *pivotPos = PartitionRight(begin, end, less, alreadyPartitioned);
+
+			size_t leftSize = pivotPos - begin;
+			size_t rightSize = end - (pivotPos + 1);
+
+			if (leftSize < size / 8 || rightSize < size / 8)
+			{
+				// Unbalanced partition, shuffle some elements around to break patterns.
+				if (--badAllowed == 0)
+				{
+					HeapSort(begin, end, less);
+					return;
+				}
+
+				if (leftSize >= InsertionSortThreshold)
+				{
+					Swap(*begin, *(begin + leftSize / 4));
+					Swap(*(pivotPos - 1), *(pivotPos - leftSize / 4));
+
+					if (leftSize > NintherThreshold)
+					{
+						Swap(*(begin + 1), *(begin + (leftSize / 4 + 1)));
+						Swap(*(begin + 2), *(begin + (leftSize / 4 + 2)));
+						Swap(*(pivotPos - 2), *(pivotPos - (leftSize / 4 + 1)));
+						Swap(*(pivotPos - 3), *(pivotPos - (leftSize / 4 + 2)));
+					}
+				}
+
+				if (rightSize >= InsertionSortThreshold)
+				{
+					Swap(*(pivotPos + 1), *(pivotPos + (1 + rightSize / 4)));
+					Swap(*(end - 1), *(end - rightSize / 4));
+
+					if (rightSize > NintherThreshold)
+					{
+						Swap(*(pivotPos + 2), *(pivotPos + (2 + rightSize / 4)));
+						Swap(*(pivotPos + 3), *(pivotPos + (3 + rightSize / 4)));
+						Swap(*(end - 2), *(end - (1 + rightSize / 4)));
+						Swap(*(end - 3), *(end - (2 + rightSize / 4)));
+					}
+				}
+			}
+			else if (alreadyPartitioned
+				&& PartialInsertionSort(begin, pivotPos, less)
+				&& PartialInsertionSort(pivotPos + 1, end, less))
+			{
+				// Both sides were (nearly) sorted already.
+				return;
+			}
+
+			Loop(begin, pivotPos, less, badAllowed, leftmost);
+
+			begin = pivotPos + 1;
+			leftmost = false;
+		}
+	}
+}
+
+template <typename T, typename Less>
+void pdqsort(T *begin, T *end, Less less)
+{
+	if (end - begin < 2)
+	{
+		return;
+	}
+
+	int badAllowed = 0;
+
+	for (size_t size = end - begin; size > 1; size >>= 1)
+	{
+		++badAllowed;
+	}
+
+	pdqsort_detail::Loop(begin, end, less, badAllowed, true);
+}
+
+/**
+ * Merge-insertion sort for user-supplied comparators.
+ *
+ * Calling a plugin comparator costs far more than moving elements, so this trades moves
+ * for comparisons: runs are built with binary insertion and merged with a stable merge
+ * that skips runs which are already in order. Compare(a, b) returns a negative value
+ * when a goes before b, 0 when equal and a positive value otherwise.
+ */
+
+namespace mergesort_detail
+{
+	static const size_t InsertionRunLength = 16;
+
+	template <typename T, typename Compare>
+	void BinaryInsertionSort(T *begin, T *end, Compare &compare)
+	{
+		for (T *cur = begin + 1; cur < end; ++cur)
+		{
+			T value = *cur;
+			T *low = begin;
+			T *high = cur;
+
+			// Insert after equal elements to keep the sort stable.
+			while (low < high)
+			{
+				T *middle = low + (high - low) / 2;
+
+				if (compare(value, *middle) < 0)
+				{
+					high = middle;
+				}
+				else
+				{
+					low = middle + 1;
+				}
+			}
+
+			if (low != cur)
+			{
+				memmove(low + 1, low, (cur - low) * sizeof(T));
+				*low = value;
+			}
+		}
+	}
+
+	template <typename T, typename Compare>
+	void Merge(T *begin, T *middle, T *end, T *temp, Compare &compare)
+	{
+		if (compare(*(middle - 1), *middle) <= 0)
+		{
+			return;
+		}
+
+		size_t leftSize = middle - begin;
+		memcpy(temp, begin, leftSize * sizeof(T));
+
+		T *left = temp;
+		T *leftEnd = temp + leftSize;
+		T *right = middle;
+		T *dest = begin;
+
+		while (left < leftEnd && right < end)
+		{
+			if (compare(*right, *left) < 0)
+			{
+				*dest++ = *right++;
+			}
+			else
+			{
+				*dest++ = *left++;
+			}
+		}
+
+		if (left < leftEnd)
+		{
+			memcpy(dest, left, (leftEnd - left) * sizeof(T));
+		}
+	}
+
+	template <typename T, typename Compare>
+	void Sort(T *begin, T *end, T *temp, Compare &compare)
+	{
+		size_t size = end - begin;
+
+		if (size <= InsertionRunLength)
+		{
+			BinaryInsertionSort(begin, end, compare);
+			return;
+		}
+
+		T *middle = begin + size / 2;
+
+		Sort(begin, middle, temp, compare);
+		Sort(middle, end, temp, compare);
+		Merge(begin, middle, end, temp, compare);
+	}
+}
+
+template <typename T, typename Compare>
+void MergeInsertionSort(T *begin, T *end, Compare &compare)
+{
+	size_t size = end - begin;
+
+	if (size < 2)
+	{
+		return;
+	}
+
+	if (size <= mergesort_detail::InsertionRunLength)
+	{
+		mergesort_detail::BinaryInsertionSort(begin, end, compare);
+		return;
+	}
+
+	T *temp = new T[size / 2 + 1];
+	mergesort_detail::Sort(begin, end, temp, compare);
+	delete [] temp;
+}
+
+/**
+ * Calls a plugin's comparison function directly.
+ *
+ * The public is looked up once and each comparison pushes its arguments straight onto
+ * the plugin stack and runs amx_Exec, skipping the generic forward machinery.
+ * After a runtime error the error is reported once and further comparisons return 0.
+ */
+class SortComparator
+{
+public:
+	SortComparator(AMX *amx);
+	~SortComparator();
+
+public:
+	bool Begin(const char *funcName);
+	cell Call(cell param1, cell param2, cell param3, cell param4, cell param5);
+
+private:
+	AMX *m_Amx;
+	int m_Func;
+	Debugger *m_Debugger;
+	bool m_Running;
+	bool m_Failed;
+};
+
+/**
+ * LSD radix sorts used by the integer and float sorts.
+ *
+ * Cells are mapped to unsigned keys which sort in the same order as the values,
+ * descending orders use the complemented key so equal values keep their relative order.
+ */
+
+void RadixSortCells(cell *array, size_t count, bool floats, bool descending);
+void RadixSortBlocks(cell *base, size_t count, size_t blocksize, size_t column, bool floats, bool descending);
+
+#endif // _INCLUDE_SORTING_H
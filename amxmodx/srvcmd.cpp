@@ -9,6 +9,7 @@
 
 #include "amxmodx.h"
 #include <amxmodx_version.h>
+#include "CAsyncFile.h"
 #include <string>
 
 void amx_command()
@@ -170,6 +171,27 @@ void amx_command()
 	{
 		g_CvarManager.OnConsoleCommand();
 	}
+	else if (!strcmp(cmd, "profile"))
+	{
+		g_Profiler.OnConsoleCommand();
+	}
+	else if (!strcmp(cmd, "perf"))
+	{
+		g_PerfStats.OnConsoleCommand();
+	}
+	else if (!strcmp(cmd, "handles"))
+	{
+		g_HandleStats.OnConsoleCommand();
+	}
+	else if (!strcmp(cmd, "tasks"))
+	{
+		g_tasksMngr.OnConsoleCommand();
+	}
+	else if (!strcmp(cmd, "threads"))
+	{
+		g_ThreadPool.OnConsoleCommand();
+		g_AsyncFiles.OnConsoleCommand();
+	}
 	else if (!strcmp(cmd, "cmds"))
 	{
 		print_srvconsole("Registered commands:\n");
@@ -297,6 +319,12 @@ void amx_command()
 		print_srvconsole("   cmds [ plugin ]            - list commands registered by plugins\n");
 		print_srvconsole("   pause < plugin >           - pause a running plugin\n");
 		print_srvconsole("   unpause < plugin >         - unpause a previously paused plugin\n");
+		print_srvconsole("   profile [ action ]         - start, stop or dump the sampling profiler\n");
+		print_srvconsole("   perf [ plugin | reset ]    - show the publics taking the most time\n");
+		print_srvconsole("   perf natives [ action ]    - start, stop or dump the native call profiler\n");
+		print_srvconsole("   handles [ plugin ]         - list live handles and memory peaks of plugins\n");
+		print_srvconsole("   tasks                      - show deferred task statistics\n");
+		print_srvconsole("   threads                    - show the thread pool and async file statistics\n");
 	}
 }
 
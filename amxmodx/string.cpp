@@ -297,23 +297,17 @@ static cell AMX_NATIVE_CALL replace(AMX *amx, cell *params) /* 4 param */
 		return 0;
 	}
 
-	cell browsed = 0;
-	while (*text && (browsed <= (textLen-whatLen)))
+	text = const_cast<cell *>(UTIL_FindString<cell>(text, textLen, what, whatLen));
+
+	if (text)
 	{
-		if (*text == *what)
-		{
-			if (fastcellcmp(text, what, whatLen))
-			{
-				cell *saveptr = text + whatLen;
-				cell restlen = textLen - (browsed + whatLen);
-				textptr = text + withLen;
-				memmove(textptr, saveptr, (restlen + 1) * sizeof(cell));
-				memcpy(text, with, withLen * sizeof(cell));
-				return (textLen - whatLen + withLen);
-			}
-		}
-		text++;
-		browsed++;
+		cell browsed = text - textptr;
+		cell *saveptr = text + whatLen;
+		cell restlen = textLen - (browsed + whatLen);
+		textptr = text + withLen;
+		memmove(textptr, saveptr, (restlen + 1) * sizeof(cell));
+		memcpy(text, with, withLen * sizeof(cell));
+		return (textLen - whatLen + withLen);
 	}
 	
 	return 0;
@@ -387,25 +381,24 @@ static cell AMX_NATIVE_CALL replace_stringex(AMX *amx, cell *params)
 
 static cell AMX_NATIVE_CALL contain(AMX *amx, cell *params) /* 2 param */
 {
-	register cell *a = get_amxaddr(amx, params[2]);
-	register cell *b = get_amxaddr(amx, params[1]);
-	register cell *c = b;
-	cell* str = b;
-	cell* substr = a;
-	
-	while (*c)
+	cell *str = get_amxaddr(amx, params[1]);
+	cell *substr = get_amxaddr(amx, params[2]);
+
+	int strLen = amxstring_len(str);
+	int substrLen = amxstring_len(substr);
+
+	if (!substrLen)
 	{
-		if (*c == *a)
-		{
-			c++;
-			if (!*++a)
-				return b - str;
-		} else {
-			c = ++b;
-			a = substr;
-		}
+		return -1;
 	}
-	
+
+	auto result = UTIL_FindString<cell>(str, strLen, substr, substrLen);
+
+	if (result)
+	{
+		return result - str;
+	}
+
 	return -1;
 }
 
@@ -425,13 +418,13 @@ static cell AMX_NATIVE_CALL containi(AMX *amx, cell *params)
 		auto sourceFolded = get_amxbuffer(2);
 		auto searchFolded = get_amxbuffer(3);
 
-		sourceLength = utf8casefold(source, sourceLength, sourceFolded, MAX_BUFFER_LENGTH - 1, UTF8_LOCALE_DEFAULT, nullptr, TRUE);
-		searchLength = utf8casefold(search, searchLength, searchFolded, MAX_BUFFER_LENGTH - 1, UTF8_LOCALE_DEFAULT, nullptr, TRUE);
+		sourceLength = UTIL_CaseFold(source, sourceLength, sourceFolded, MAX_BUFFER_LENGTH - 1);
+		searchLength = UTIL_CaseFold(search, searchLength, searchFolded, MAX_BUFFER_LENGTH - 1);
 
 		sourceFolded[sourceLength] = '\0';
 		searchFolded[searchLength] = '\0';
 
-		auto result = strstr(sourceFolded, searchFolded);
+		auto result = UTIL_FindString(sourceFolded, sourceLength, searchFolded, searchLength);
 
 		if (result)
 		{
@@ -1511,8 +1504,8 @@ static cell AMX_NATIVE_CALL n_strfind(AMX *amx, cell *params)
 		auto sourceFolded = get_amxbuffer(2);
 		auto searchFolded = get_amxbuffer(3);
 
-		sourceLength = utf8casefold(source, sourceLength, sourceFolded, MAX_BUFFER_LENGTH - 1, UTF8_LOCALE_DEFAULT, nullptr, TRUE);
-		searchLength = utf8casefold(search, searchLength, searchFolded, MAX_BUFFER_LENGTH - 1, UTF8_LOCALE_DEFAULT, nullptr, TRUE);
+		sourceLength = UTIL_CaseFold(source, sourceLength, sourceFolded, MAX_BUFFER_LENGTH - 1);
+		searchLength = UTIL_CaseFold(search, searchLength, searchFolded, MAX_BUFFER_LENGTH - 1);
 
 		sourceFolded[sourceLength] = '\0';
 		searchFolded[searchLength] = '\0';
@@ -1528,7 +1521,7 @@ static cell AMX_NATIVE_CALL n_strfind(AMX *amx, cell *params)
 		return -1;
 	}
 
-	auto find = strstr(source + position, search);
+	auto find = UTIL_FindString(source + position, sourceLength - position, search, searchLength);
 
 	if (!find)
 	{
@@ -346,9 +346,9 @@ static cell AMX_NATIVE_CALL TrieDestroy(AMX *amx, cell *params)
 	}
 
 	CellTrieIter *iter;
- 	for (size_t index = 1; index <= TrieIterHandles.size(); index++)
+ 	for (size_t index = 0; index < TrieIterHandles.size(); index++)
  	{
- 		if ((iter = TrieIterHandles.lookup(index)))
+ 		if ((iter = TrieIterHandles.slot(index)))
  		{
 			if (iter->trie == t)
 			{
@@ -702,6 +702,369 @@ static cell AMX_NATIVE_CALL TrieIterDestroy(AMX *amx, cell *params)
 }
 
 
+// Keys of a Pawn 2D array argument, row by row.
+static const char *GetBatchKey(AMX *amx, cell keys_addr, cell *keys, cell index, int &len)
+{
+	return get_amxstring(amx, keys_addr + index * sizeof(cell) + keys[index], 0, len);
+}
+
+// native TrieGetCells(Trie:handle, const keys[][], any:values[], count, any:defaultValue = 0);
+static cell AMX_NATIVE_CALL TrieGetCells(AMX *amx, cell *params)
+{
+	enum args { arg_count, arg_handle, arg_keys, arg_values, arg_num, arg_default };
+
+	CellTrie *t = TrieHandles.lookup(params[arg_handle]);
+
+	if (!t)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid trie handle provided (%d)", params[arg_handle]);
+		return 0;
+	}
+
+	cell count = params[arg_num];
+
+	if (count < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid key count (%d)", count);
+		return 0;
+	}
+
+	cell *keys = get_amxaddr(amx, params[arg_keys]);
+	cell *values = get_amxaddr(amx, params[arg_values]);
+	cell found = 0;
+
+	for (cell i = 0; i < count; ++i)
+	{
+		int len;
+		const char *key = GetBatchKey(amx, params[arg_keys], keys, i, len);
+
+		StringHashMap<Entry>::Result r = t->map.find(key);
+
+		if (r.found() && r->value.isCell())
+		{
+			values[i] = r->value.cell_();
+			++found;
+		}
+		else
+		{
+			values[i] = params[arg_default];
+		}
+	}
+
+	return found;
+}
+
+// native TrieSetCells(Trie:handle, const keys[][], const any:values[], count, bool:replace = true);
+static cell AMX_NATIVE_CALL TrieSetCells(AMX *amx, cell *params)
+{
+	enum args { arg_count, arg_handle, arg_keys, arg_values, arg_num, arg_replace };
+
+	CellTrie *t = TrieHandles.lookup(params[arg_handle]);
+
+	if (!t)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid trie handle provided (%d)", params[arg_handle]);
+		return 0;
+	}
+
+	cell count = params[arg_num];
+
+	if (count < 0)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid key count (%d)", count);
+		return 0;
+	}
+
+	cell *keys = get_amxaddr(amx, params[arg_keys]);
+	cell *values = get_amxaddr(amx, params[arg_values]);
+	cell set = 0;
+
+	for (cell i = 0; i < count; ++i)
+	{
+		int len;
+		const char *key = GetBatchKey(amx, params[arg_keys], keys, i, len);
+
+		StringHashMap<Entry>::Insert insert = t->map.findForAdd(key);
+
+		if (!insert.found())
+		{
+			if (!t->map.add(insert, key))
+			{
+				continue;
+			}
+		}
+		else if (!params[arg_replace])
+		{
+			continue;
+		}
+
+		insert->value.setCell(values[i]);
+		++set;
+	}
+
+	return set;
+}
+
+/**
+ * Binary trie files
+ *
+ * "AMXXTRIE", version and entry count, then for each entry its type, key length and key,
+ * followed by the cell, or the length and bytes of a string, or the length and cells of
+ * an array. Integers are stored little-endian and 32 bits wide like cells.
+ */
+
+static const char TrieFileMagic[] = "AMXXTRIE";
+static const uint32_t TrieFileVersion = 1;
+static const uint32_t TrieFileMaxLength = 1 << 24;
+
+static bool TrieFileWrite(FILE *fp, uint32_t value)
+{
+	uint8_t bytes[4] = { uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24) };
+
+	return fwrite(bytes, sizeof(bytes), 1, fp) == 1;
+}
+
+static bool TrieFileRead(FILE *fp, uint32_t &value)
+{
+	uint8_t bytes[4];
+
+	if (fread(bytes, sizeof(bytes), 1, fp) != 1)
+	{
+		return false;
+	}
+
+	value = uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+
+	return true;
+}
+
+static bool TrieFileWriteEntry(FILE *fp, const ke::AString &key, const Entry &value)
+{
+	uint32_t type = value.isCell() ? EntryType_Cell : (value.isString() ? EntryType_String : EntryType_CellArray);
+
+	if (!TrieFileWrite(fp, type) || !TrieFileWrite(fp, key.length())
+		|| (key.length() && fwrite(key.chars(), key.length(), 1, fp) != 1))
+	{
+		return false;
+	}
+
+	if (value.isCell())
+	{
+		return TrieFileWrite(fp, value.cell_());
+	}
+
+	if (value.isString())
+	{
+		size_t length = strlen(value.chars());
+
+		return TrieFileWrite(fp, length) && (!length || fwrite(value.chars(), length, 1, fp) == 1);
+	}
+
+	size_t length = value.arrayLength();
+	cell *cells = value.array();
+
+	if (!TrieFileWrite(fp, length))
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		if (!TrieFileWrite(fp, cells[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// native TrieSaveToFile(Trie:handle, const file[]);
+static cell AMX_NATIVE_CALL TrieSaveToFile(AMX *amx, cell *params)
+{
+	CellTrie *t = TrieHandles.lookup(params[1]);
+
+	if (!t)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid trie handle provided (%d)", params[1]);
+		return -1;
+	}
+
+	int len;
+	const char *file = get_amxstring(amx, params[2], 0, len);
+
+	FILE *fp = fopen(build_pathname("%s", file), "wb");
+
+	if (!fp)
+	{
+		return -1;
+	}
+
+	bool ok = fwrite(TrieFileMagic, sizeof(TrieFileMagic) - 1, 1, fp) == 1
+		&& TrieFileWrite(fp, TrieFileVersion)
+		&& TrieFileWrite(fp, t->map.elements());
+
+	cell count = 0;
+
+	for (StringHashMap<Entry>::iterator iter = t->map.iter(); ok && !iter.empty(); iter.next(), ++count)
+	{
+		ok = TrieFileWriteEntry(fp, iter->key, iter->value);
+	}
+
+	if (fclose(fp) != 0 || !ok)
+	{
+		return -1;
+	}
+
+	return count;
+}
+
+// native TrieLoadFromFile(Trie:handle, const file[], bool:replace = true);
+static cell AMX_NATIVE_CALL TrieLoadFromFile(AMX *amx, cell *params)
+{
+	CellTrie *t = TrieHandles.lookup(params[1]);
+
+	if (!t)
+	{
+		LogError(amx, AMX_ERR_NATIVE, "Invalid trie handle provided (%d)", params[1]);
+		return -1;
+	}
+
+	int len;
+	const char *file = get_amxstring(amx, params[2], 0, len);
+	bool replace = params[3] != 0;
+
+	FILE *fp = fopen(build_pathname("%s", file), "rb");
+
+	if (!fp)
+	{
+		return -1;
+	}
+
+	char magic[sizeof(TrieFileMagic) - 1];
+	uint32_t version, elements;
+
+	if (fread(magic, sizeof(magic), 1, fp) != 1 || memcmp(magic, TrieFileMagic, sizeof(magic))
+		|| !TrieFileRead(fp, version) || version != TrieFileVersion
+		|| !TrieFileRead(fp, elements))
+	{
+		fclose(fp);
+		return -1;
+	}
+
+	char *key = nullptr;
+	cell *cells = nullptr;
+	cell loaded = 0;
+
+	for (uint32_t i = 0; i < elements; ++i)
+	{
+		uint32_t type, length, value;
+
+		if (!TrieFileRead(fp, type) || type > EntryType_String
+			|| !TrieFileRead(fp, length) || length > TrieFileMaxLength)
+		{
+			break;
+		}
+
+		// On failure the old buffers are kept, and freed below
+		char *newKey = (char *)realloc(key, length + 1);
+
+		if (!newKey)
+		{
+			break;
+		}
+
+		key = newKey;
+
+		if (length && fread(key, length, 1, fp) != 1)
+		{
+			break;
+		}
+
+		key[length] = '\0';
+
+		if (!TrieFileRead(fp, value) || (type != EntryType_Cell && value > TrieFileMaxLength))
+		{
+			break;
+		}
+
+		if (type == EntryType_String)
+		{
+			cell *newCells = (cell *)realloc(cells, value + 1);
+
+			if (!newCells)
+			{
+				break;
+			}
+
+			cells = newCells;
+			char *chars = reinterpret_cast<char *>(cells);
+
+			if (value && fread(chars, value, 1, fp) != 1)
+			{
+				break;
+			}
+
+			chars[value] = '\0';
+		}
+		else if (type == EntryType_CellArray)
+		{
+			cell *newCells = (cell *)realloc(cells, (value + 1) * sizeof(cell));
+
+			if (!newCells)
+			{
+				break;
+			}
+
+			cells = newCells;
+
+			uint32_t j;
+			for (j = 0; j < value && TrieFileRead(fp, reinterpret_cast<uint32_t &>(cells[j])); ++j) {}
+
+			if (j != value)
+			{
+				break;
+			}
+		}
+
+		StringHashMap<Entry>::Insert insert = t->map.findForAdd(key);
+
+		if (!insert.found())
+		{
+			if (!t->map.add(insert, key))
+			{
+				continue;
+			}
+		}
+		else if (!replace)
+		{
+			continue;
+		}
+
+		if (type == EntryType_Cell)
+		{
+			insert->value.setCell(value);
+		}
+		else if (type == EntryType_String)
+		{
+			insert->value.setString(reinterpret_cast<char *>(cells));
+		}
+		else
+		{
+			insert->value.setArray(cells, value);
+		}
+
+		++loaded;
+	}
+
+	free(key);
+	free(cells);
+	fclose(fp);
+
+	return loaded;
+}
+
+
 AMX_NATIVE_INFO trie_Natives[] =
 {
 	{ "TrieCreate"               ,	TrieCreate },
@@ -720,6 +1083,11 @@ AMX_NATIVE_INFO trie_Natives[] =
 	{ "TrieDestroy"              ,	TrieDestroy },
 	{ "TrieGetSize"              ,	TrieGetSize },
 
+	{ "TrieGetCells"             ,	TrieGetCells },
+	{ "TrieSetCells"             ,	TrieSetCells },
+	{ "TrieSaveToFile"           ,	TrieSaveToFile },
+	{ "TrieLoadFromFile"         ,	TrieLoadFromFile },
+
 	{ "TrieSnapshotCreate"       ,	TrieSnapshotCreate },
 	{ "TrieSnapshotLength"       ,	TrieSnapshotLength },
 	{ "TrieSnapshotKeyBufferSize",	TrieSnapshotKeyBufferSize },
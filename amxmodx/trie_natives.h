@@ -160,6 +160,11 @@ public:
 		return internal_.elements();
 	}
 
+	size_t mem_usage() const
+	{
+		return internal_.mem_usage();
+	}
+
 	iterator iter()
 	{
 		return internal_.iter();
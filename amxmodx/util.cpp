@@ -499,8 +499,337 @@ int utf8strcasecmp(const char *string1, const char *string2)
 	return utf8strncasecmp(string1, string2, 0);
 }
 
+/**
+ * Substring search kernel shared by the string natives.
+ *
+ * Short needles are located by testing the first and last needle characters at each
+ * position before comparing the rest (16 positions at a time when SSE2 is available),
+ * longer needles use Boyer-Moore-Horspool. Both work on char and cell strings.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define SEARCH_USE_SSE2
+#endif
+
+static const size_t SearchHorspoolMinLength = 16;
+
+static const unsigned char AsciiLowerTable[256] =
+{
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+	0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+	0x40, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+	0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+	0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+	0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+	0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+	0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+	0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+	0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+	0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+	0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+	0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+	0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF,
+};
+
+static inline unsigned char AsciiLower(char c)
+{
+	return AsciiLowerTable[static_cast<unsigned char>(c)];
+}
+
+template <typename T>
+static const T *FindHorspool(const T *haystack, size_t haystackLen, const T *needle, size_t needleLen)
+{
+	size_t shift[256];
+	size_t last = needleLen - 1;
+
+	for (size_t i = 0; i < ARRAY_LENGTH(shift); ++i)
+	{
+		shift[i] = needleLen;
+	}
+
+	// Cells are bucketed by their low byte, keeping the smallest shift of each bucket.
+	for (size_t i = 0; i < last; ++i)
+	{
+		shift[static_cast<unsigned char>(needle[i])] = last - i;
+	}
+
+	size_t position = 0;
+	size_t end = haystackLen - needleLen;
+
+	while (position <= end)
+	{
+		T tail = haystack[position + last];
+
+		if (tail == needle[last] && !memcmp(haystack + position, needle, last * sizeof(T)))
+		{
+			return haystack + position;
+		}
+
+		position += shift[static_cast<unsigned char>(tail)];
+	}
+
+	return nullptr;
+}
+
+template <typename T>
+static const T *FindFirstLast(const T *haystack, size_t haystackLen, const T *needle, size_t needleLen, size_t position)
+{
+	size_t last = needleLen - 1;
+	size_t count = haystackLen - needleLen + 1;
+
+	for (; position < count; ++position)
+	{
+		if (haystack[position] == needle[0] && haystack[position + last] == needle[last]
+			&& !memcmp(haystack + position + 1, needle + 1, (needleLen > 1 ? needleLen - 2 : 0) * sizeof(T)))
+		{
+			return haystack + position;
+		}
+	}
+
+	return nullptr;
+}
+
+#if defined SEARCH_USE_SSE2
+static inline unsigned int CountTrailingZeros(unsigned int value)
+{
+#if defined _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return index;
+#else
+	return __builtin_ctz(value);
+#endif
+}
+
+static const char *FindFirstLast(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen, size_t position)
+{
+	size_t last = needleLen - 1;
+	size_t count = haystackLen - needleLen + 1;
+
+	const __m128i first = _mm_set1_epi8(needle[0]);
+	const __m128i lastChar = _mm_set1_epi8(needle[last]);
+
+	for (; position + 16 <= count; position += 16)
+	{
+		__m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + position));
+		__m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + position + last));
+
+		unsigned int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, lastChar)));
+
+		while (mask)
+		{
+			size_t candidate = position + CountTrailingZeros(mask);
+
+			if (needleLen < 3 || !memcmp(haystack + candidate + 1, needle + 1, needleLen - 2))
+			{
+				return haystack + candidate;
+			}
+
+			mask &= mask - 1;
+		}
+	}
+
+	return FindFirstLast<char>(haystack, haystackLen, needle, needleLen, position);
+}
+#endif
+
+template <typename T>
+const T *UTIL_FindString(const T *haystack, size_t haystackLen, const T *needle, size_t needleLen)
+{
+	if (!needleLen)
+	{
+		return haystack;
+	}
+
+	if (needleLen > haystackLen)
+	{
+		return nullptr;
+	}
+
+	if (needleLen >= SearchHorspoolMinLength)
+	{
+		return FindHorspool(haystack, haystackLen, needle, needleLen);
+	}
+
+	return FindFirstLast(haystack, haystackLen, needle, needleLen, 0);
+}
+
+template const char *UTIL_FindString<char>(const char *, size_t, const char *, size_t);
+template const cell *UTIL_FindString<cell>(const cell *, size_t, const cell *, size_t);
+
+// Both strings are expected to be ASCII, see UTIL_IsAscii().
+const char *UTIL_FindStringI(const char *haystack, size_t haystackLen, const char *needle, size_t needleLen)
+{
+	if (!needleLen)
+	{
+		return haystack;
+	}
+
+	if (needleLen > haystackLen)
+	{
+		return nullptr;
+	}
+
+	size_t last = needleLen - 1;
+	size_t count = haystackLen - needleLen + 1;
+
+	unsigned char first = AsciiLower(needle[0]);
+	unsigned char lastChar = AsciiLower(needle[last]);
+
+	for (size_t position = 0; position < count; ++position)
+	{
+		if (AsciiLower(haystack[position]) != first || AsciiLower(haystack[position + last]) != lastChar)
+		{
+			continue;
+		}
+
+		size_t i = 1;
+
+		while (i < last && AsciiLower(haystack[position + i]) == AsciiLower(needle[i]))
+		{
+			++i;
+		}
+
+		if (i >= last)
+		{
+			return haystack + position;
+		}
+	}
+
+	return nullptr;
+}
+
+bool UTIL_IsAscii(const char *string, size_t length)
+{
+	unsigned char bits = 0;
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		bits |= static_cast<unsigned char>(string[i]);
+	}
+
+	return !(bits & 0x80);
+}
+
+// Same result as utf8casefold() with its default locale, without the decoding cost for ASCII strings.
+size_t UTIL_CaseFold(const char *string, size_t length, char *buffer, size_t maxlength)
+{
+	if (!UTIL_IsAscii(string, length))
+	{
+		return utf8casefold(string, length, buffer, maxlength, UTF8_LOCALE_DEFAULT, nullptr, TRUE);
+	}
+
+	if (length > maxlength)
+	{
+		length = maxlength;
+	}
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		buffer[i] = AsciiLower(string[i]);
+	}
+
+	return length;
+}
+
+// Whether the first match of search can be located with the search kernel, with the same result
+// as the strncmp()/utf8strncasecmp() scan below.
+static bool CanUseSearchKernel(const char *subject, size_t textLen, const char *search, size_t searchLen, bool caseSensitive)
+{
+	if (!searchLen || searchLen > strlen(search))
+	{
+		return false;
+	}
+
+	return caseSensitive || (UTIL_IsAscii(subject, textLen) && UTIL_IsAscii(search, searchLen));
+}
+
+static const char *FindReplaceSearch(const char *subject, size_t textLen, const char *search, size_t searchLen, bool caseSensitive)
+{
+	return caseSensitive ? UTIL_FindString(subject, textLen, search, searchLen) : UTIL_FindStringI(subject, textLen, search, searchLen);
+}
+
 size_t UTIL_ReplaceAll(char *subject, size_t maxlength, const char *search, size_t searchLen, const char *replace, size_t replaceLen, bool caseSensitive)
 {
+	size_t textLen = strlen(subject);
+
+	/* Rewrite the string in a single pass when every replacement fits in the buffer.
+	 * Otherwise, let UTIL_ReplaceEx() cut the string off the way it always did.
+	 */
+	if (maxlength > 1 && searchLen <= textLen && CanUseSearchKernel(subject, textLen, search, searchLen, caseSensitive))
+	{
+		ke::Vector<size_t> matches;
+		const char *ptr = subject;
+		const char *end = subject + textLen;
+
+		while ((ptr = FindReplaceSearch(ptr, end - ptr, search, searchLen, caseSensitive)) != NULL)
+		{
+			matches.append(ptr - subject);
+			ptr += searchLen;
+		}
+
+		size_t total = matches.length();
+
+		if (!total)
+		{
+			return 0;
+		}
+
+		size_t newLen = textLen - total * searchLen + total * replaceLen;
+
+		if (newLen < maxlength)
+		{
+			if (replaceLen <= searchLen)
+			{
+				/* The string shrinks: move each kept run down, left to right. */
+				char *dest = subject;
+				size_t from = 0;
+
+				for (size_t i = 0; i < total; i++)
+				{
+					size_t keep = matches[i] - from;
+
+					memmove(dest, subject + from, keep);
+					dest += keep;
+
+					memcpy(dest, replace, replaceLen);
+					dest += replaceLen;
+
+					from = matches[i] + searchLen;
+				}
+
+				memmove(dest, subject + from, textLen - from);
+			}
+			else
+			{
+				/* The string grows: move each kept run up, right to left. */
+				char *dest = subject + newLen;
+				size_t to = textLen;
+
+				for (size_t i = total; i-- > 0; )
+				{
+					size_t from = matches[i] + searchLen;
+					size_t keep = to - from;
+
+					dest -= keep;
+					memmove(dest, subject + from, keep);
+
+					dest -= replaceLen;
+					memcpy(dest, replace, replaceLen);
+
+					to = matches[i];
+				}
+			}
+
+			subject[newLen] = '\0';
+
+			return total;
+		}
+	}
+
 	char *newptr, *ptr = subject;
 	unsigned int total = 0;
 	while ((newptr = UTIL_ReplaceEx(ptr, maxlength, search, searchLen, replace, replaceLen, caseSensitive)) != NULL)
@@ -595,112 +924,65 @@ char *UTIL_ReplaceEx(char *subject, size_t maxLen, const char *search, size_t se
 	/* Subtract one off the maxlength so we can include the null terminator */
 	maxLen--;
 
-	while (*ptr != '\0' && (browsed <= textLen - searchLen))
+	/* Find the first match */
+	if (CanUseSearchKernel(subject, textLen, search, searchLen, caseSensitive))
 	{
-		/* See if we get a comparison */
-		if ((caseSensitive ? strncmp(ptr, search, searchLen) : utf8strncasecmp(ptr, search, searchLen)) == 0)
+		ptr = const_cast<char *>(FindReplaceSearch(subject, textLen, search, searchLen, caseSensitive));
+
+		if (!ptr)
 		{
-			if (replaceLen > searchLen)
+			return NULL;
+		}
+
+		browsed = ptr - subject;
+	}
+	else
+	{
+		while (*ptr != '\0' && (browsed <= textLen - searchLen))
+		{
+			/* See if we get a comparison */
+			if ((caseSensitive ? strncmp(ptr, search, searchLen) : utf8strncasecmp(ptr, search, searchLen)) == 0)
 			{
-				/* First, see if we have enough space to do this operation */
-				if (maxLen - textLen < replaceLen - searchLen)
-				{
-					/* First, see if the replacement length goes out of bounds. */
-					if (browsed + replaceLen >= maxLen)
-					{
-						/* EXAMPLE CASE:
-						* Subject: AABBBCCC
-						* Buffer : 12 bytes
-						* Search : BBB
-						* Replace: DDDDDDDDDD
-						* OUTPUT : AADDDDDDDDD
-						* POSITION:           ^
-						*/
-						/* If it does, we'll just bound the length and do a strcpy. */
-						replaceLen = maxLen - browsed;
-
-						/* Note, we add one to the final result for the null terminator */
-						strncopy(ptr, replace, replaceLen + 1);
-
-						/* Don't truncate a multi-byte character */
-						if (*(ptr + replaceLen - 1) & 1 << 7)
-						{
-							replaceLen -= UTIL_CheckValidChar(ptr + replaceLen - 1);
-							*(ptr + replaceLen) = '\0';
-						}
-					}
-					else
-					{
-						/* EXAMPLE CASE:
-						* Subject: AABBBCCC
-						* Buffer : 12 bytes
-						* Search : BBB
-						* Replace: DDDDDDD
-						* OUTPUT : AADDDDDDDCC
-						* POSITION:         ^
-						*/
-						/* We're going to have some bytes left over... */
-						size_t origBytesToCopy = (textLen - (browsed + searchLen)) + 1;
-						size_t realBytesToCopy = (maxLen - (browsed + replaceLen)) + 1;
-						char *moveFrom = ptr + searchLen + (origBytesToCopy - realBytesToCopy);
-						char *moveTo = ptr + replaceLen;
-
-						/* First, move our old data out of the way. */
-						memmove(moveTo, moveFrom, realBytesToCopy);
-
-						/* Now, do our replacement. */
-						memcpy(ptr, replace, replaceLen);
-					}
-				}
-				else
-				{
-					/* EXAMPLE CASE:
-					* Subject: AABBBCCC
-					* Buffer : 12 bytes
-					* Search : BBB
-					* Replace: DDDD
-					* OUTPUT : AADDDDCCC
-					* POSITION:      ^
-					*/
-					/* Yes, we have enough space.  Do a normal move operation. */
-					char *moveFrom = ptr + searchLen;
-					char *moveTo = ptr + replaceLen;
-
-					/* First move our old data out of the way. */
-					size_t bytesToCopy = (textLen - (browsed + searchLen)) + 1;
-					memmove(moveTo, moveFrom, bytesToCopy);
-
-					/* Now do our replacement. */
-					memcpy(ptr, replace, replaceLen);
-				}
+				break;
 			}
-			else if (replaceLen < searchLen)
+			ptr++;
+			browsed++;
+		}
+
+		if (*ptr == '\0' || browsed > textLen - searchLen)
+		{
+			return NULL;
+		}
+	}
+
+	if (replaceLen > searchLen)
+	{
+		/* First, see if we have enough space to do this operation */
+		if (maxLen - textLen < replaceLen - searchLen)
+		{
+			/* First, see if the replacement length goes out of bounds. */
+			if (browsed + replaceLen >= maxLen)
 			{
 				/* EXAMPLE CASE:
 				* Subject: AABBBCCC
 				* Buffer : 12 bytes
 				* Search : BBB
-				* Replace: D
-				* OUTPUT : AADCCC
-				* POSITION:   ^
+				* Replace: DDDDDDDDDD
+				* OUTPUT : AADDDDDDDDD
+				* POSITION:           ^
 				*/
-				/* If the replacement does not grow the string length, we do not
-				* need to do any fancy checking at all.  Yay!
-				*/
-				char *moveFrom = ptr + searchLen;		/* Start after the search pointer */
-				char *moveTo = ptr + replaceLen;		/* Copy to where the replacement ends */
+				/* If it does, we'll just bound the length and do a strcpy. */
+				replaceLen = maxLen - browsed;
+
+				/* Note, we add one to the final result for the null terminator */
+				strncopy(ptr, replace, replaceLen + 1);
 
-				/* Copy our replacement in, if any */
-				if (replaceLen)
+				/* Don't truncate a multi-byte character */
+				if (*(ptr + replaceLen - 1) & 1 << 7)
 				{
-					memcpy(ptr, replace, replaceLen);
+					replaceLen -= UTIL_CheckValidChar(ptr + replaceLen - 1);
+					*(ptr + replaceLen) = '\0';
 				}
-
-				/* Figure out how many bytes to move down, including null terminator */
-				size_t bytesToCopy = (textLen - (browsed + searchLen)) + 1;
-
-				/* Move the rest of the string down */
-				memmove(moveTo, moveFrom, bytesToCopy);
 			}
 			else
 			{
@@ -708,21 +990,88 @@ char *UTIL_ReplaceEx(char *subject, size_t maxLen, const char *search, size_t se
 				* Subject: AABBBCCC
 				* Buffer : 12 bytes
 				* Search : BBB
-				* Replace: DDD
-				* OUTPUT : AADDDCCC
-				* POSITION:     ^
+				* Replace: DDDDDDD
+				* OUTPUT : AADDDDDDDCC
+				* POSITION:         ^
 				*/
-				/* We don't have to move anything around, just do a straight copy */
+				/* We're going to have some bytes left over... */
+				size_t origBytesToCopy = (textLen - (browsed + searchLen)) + 1;
+				size_t realBytesToCopy = (maxLen - (browsed + replaceLen)) + 1;
+				char *moveFrom = ptr + searchLen + (origBytesToCopy - realBytesToCopy);
+				char *moveTo = ptr + replaceLen;
+
+				/* First, move our old data out of the way. */
+				memmove(moveTo, moveFrom, realBytesToCopy);
+
+				/* Now, do our replacement. */
 				memcpy(ptr, replace, replaceLen);
 			}
+		}
+		else
+		{
+			/* EXAMPLE CASE:
+			* Subject: AABBBCCC
+			* Buffer : 12 bytes
+			* Search : BBB
+			* Replace: DDDD
+			* OUTPUT : AADDDDCCC
+			* POSITION:      ^
+			*/
+			/* Yes, we have enough space.  Do a normal move operation. */
+			char *moveFrom = ptr + searchLen;
+			char *moveTo = ptr + replaceLen;
+
+			/* First move our old data out of the way. */
+			size_t bytesToCopy = (textLen - (browsed + searchLen)) + 1;
+			memmove(moveTo, moveFrom, bytesToCopy);
+
+			/* Now do our replacement. */
+			memcpy(ptr, replace, replaceLen);
+		}
+	}
+	else if (replaceLen < searchLen)
+	{
+		/* EXAMPLE CASE:
+		* Subject: AABBBCCC
+		* Buffer : 12 bytes
+		* Search : BBB
+		* Replace: D
+		* OUTPUT : AADCCC
+		* POSITION:   ^
+		*/
+		/* If the replacement does not grow the string length, we do not
+		* need to do any fancy checking at all.  Yay!
+		*/
+		char *moveFrom = ptr + searchLen;		/* Start after the search pointer */
+		char *moveTo = ptr + replaceLen;		/* Copy to where the replacement ends */
 
-			return ptr + replaceLen;
+		/* Copy our replacement in, if any */
+		if (replaceLen)
+		{
+			memcpy(ptr, replace, replaceLen);
 		}
-		ptr++;
-		browsed++;
+
+		/* Figure out how many bytes to move down, including null terminator */
+		size_t bytesToCopy = (textLen - (browsed + searchLen)) + 1;
+
+		/* Move the rest of the string down */
+		memmove(moveTo, moveFrom, bytesToCopy);
+	}
+	else
+	{
+		/* EXAMPLE CASE:
+		* Subject: AABBBCCC
+		* Buffer : 12 bytes
+		* Search : BBB
+		* Replace: DDD
+		* OUTPUT : AADDDCCC
+		* POSITION:     ^
+		*/
+		/* We don't have to move anything around, just do a straight copy */
+		memcpy(ptr, replace, replaceLen);
 	}
 
-	return NULL;
+	return ptr + replaceLen;
 }
 
 // From Metamod:Source
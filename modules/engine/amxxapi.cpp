@@ -58,6 +58,8 @@ void OnAmxxAttach()
 	MF_AddNatives(engine_Natives);
 	MF_AddNewNatives(engine_NewNatives);
 	MF_AddNatives(global_Natives);
+	MF_AddNatives(snapshot_Natives);
+	MF_AddNatives(trace_Natives);
 	memset(glinfo.szLastLights, 0x0, 128);
 	memset(glinfo.szRealLights, 0x0, 128);
 	glinfo.bCheckLights = false;
@@ -224,6 +226,9 @@ void ServerDeactivate()
 
 	ClearHooks();
 
+	// Leaves what was cached for the current frame stale
+	g_FrameCount++;
+
 	RETURN_META(MRES_IGNORED);
 }
 
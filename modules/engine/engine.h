@@ -107,6 +107,33 @@ enum
 	TR_Hit,				// (entity) entity the surface is on
 	TR_Hitgroup			// (int) 0 == generic, non zero is specific body part
 };
+// Used by the get_players_snapshot() native.
+enum
+{
+	Snapshot_InGame,		// (bool)
+	Snapshot_Alive,			// (bool)
+	Snapshot_Origin,		// (vector)
+	Snapshot_Velocity,		// (vector)
+	Snapshot_ViewAngles,	// (vector)
+	Snapshot_Health,		// (float)
+	Snapshot_Armor,			// (float)
+	Snapshot_Flags,			// (int)
+	Snapshot_Button,		// (int)
+	Snapshot_Team,			// (int)
+	Snapshot_Weapons,		// (int)
+	Snapshot_Fields
+};
+
+// Layout of a trace in the results of the trace_line_batch() native.
+enum
+{
+	TraceBatch_Fraction = 0,		// (float)
+	TraceBatch_EndPos = 1,			// (vector)
+	TraceBatch_Hit = 4,				// (entity)
+	TraceBatch_PlaneNormal = 5,		// (vector)
+	TraceBatch_Size = 8
+};
+
 enum {
 	Meta_GetUserMsgID,		// int )		(plid_t plid, const char *msgname, int *size);
 	Meta_GetUserMsgName,	// const char *)	(plid_t plid, int msgid, int *size);
@@ -176,6 +203,7 @@ int Spawn(edict_t *pEntity);
 void PlaybackEvent(int flags, const edict_t *pInvoker, unsigned short eventindex, float delay, float *origin, float *angles, float fparam1, float fparam2, int iparam1, int iparam2, int bparam1, int bparam2);
 void KeyValue(edict_t *pEntity, KeyValueData *pkvd);
 void StartFrame();
+void CountFrames();
 void CmdStart(const edict_t *player, const struct usercmd_s *_cmd, unsigned int random_seed);
 void ClientKill(edict_t *pEntity);
 void PlayerPreThink(edict_t *pEntity);
@@ -221,6 +249,9 @@ extern struct PlayerInfo plinfo[33];
 extern struct GlobalInfo glinfo;
 extern AMX_NATIVE_INFO engine_Natives[];
 extern AMX_NATIVE_INFO engine_NewNatives[];
+extern AMX_NATIVE_INFO snapshot_Natives[];
+extern AMX_NATIVE_INFO trace_Natives[];
+extern unsigned int g_FrameCount;
 extern ke::Vector<Impulse *> Impulses;
 extern ke::Vector<EntClass *> Thinks;
 extern ke::Vector<Touch *> Touches;
@@ -34,6 +34,7 @@ ke::Vector<Touch *> Touches;
 KeyValueData *g_pkvd;
 bool g_inKeyValue=false;
 bool g_precachedStuff = false;
+unsigned int g_FrameCount = 0; // Server frames, counted while StartFrame is hooked
 
 int fstrcmp(const char *s1, const char *s2)
 {
@@ -112,8 +113,16 @@ void KeyValue(edict_t *pEntity, KeyValueData *pkvd)
 	RETURN_META(MRES_IGNORED);
 }
 
+// StartFrame is otherwise hooked for server_frame only
+void CountFrames()
+{
+	g_pFunctionTable->pfnStartFrame = StartFrame;
+}
+
 void StartFrame()
 {
+	g_FrameCount++;
+
 	if (StartFrameForward != -1)
 		MF_ExecuteForward(StartFrameForward);
 	else if (VexdServerForward != -1)
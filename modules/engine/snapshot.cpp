@@ -0,0 +1,172 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+//
+// Engine Module
+//
+
+#include "engine.h"
+
+// Player state as a structure of arrays, taken on the first read of a server frame
+// and shared by every read until the next one.
+struct PlayerSnapshot
+{
+	bool ingame[33];
+	bool alive[33];
+	Vector origin[33];
+	Vector velocity[33];
+	Vector viewAngles[33];
+	float health[33];
+	float armor[33];
+	int flags[33];
+	int button[33];
+	int team[33];
+	int weapons[33];
+};
+
+static PlayerSnapshot Snapshot;
+static unsigned int SnapshotFrame;
+static bool SnapshotValid;
+
+static void TakeSnapshot()
+{
+	CountFrames();
+
+	if (SnapshotValid && SnapshotFrame == g_FrameCount)
+	{
+		return;
+	}
+
+	for (int i = 1; i <= gpGlobals->maxClients; ++i)
+	{
+		if (!MF_IsPlayerIngame(i))
+		{
+			Snapshot.ingame[i] = Snapshot.alive[i] = false;
+			Snapshot.origin[i] = Snapshot.velocity[i] = Snapshot.viewAngles[i] = Vector(0, 0, 0);
+			Snapshot.health[i] = Snapshot.armor[i] = 0.0f;
+			Snapshot.flags[i] = Snapshot.button[i] = Snapshot.team[i] = Snapshot.weapons[i] = 0;
+			continue;
+		}
+
+		entvars_t *pev = &TypeConversion.id_to_edict(i)->v;
+
+		Snapshot.ingame[i] = true;
+		Snapshot.alive[i] = pev->deadflag == DEAD_NO && pev->health > 0;
+		Snapshot.origin[i] = pev->origin;
+		Snapshot.velocity[i] = pev->velocity;
+		Snapshot.viewAngles[i] = pev->v_angle;
+		Snapshot.health[i] = pev->health;
+		Snapshot.armor[i] = pev->armorvalue;
+		Snapshot.flags[i] = pev->flags;
+		Snapshot.button[i] = pev->button;
+		Snapshot.team[i] = pev->team;
+		Snapshot.weapons[i] = pev->weapons;
+	}
+
+	SnapshotFrame = g_FrameCount;
+	SnapshotValid = true;
+}
+
+static cell *CopyVector(cell *output, const Vector &vec)
+{
+	*output++ = amx_ftoc(vec.x);
+	*output++ = amx_ftoc(vec.y);
+	*output++ = amx_ftoc(vec.z);
+
+	return output;
+}
+
+//native get_players_snapshot(const players[], numplayers, const fields[], numfields, any:output[], maxlen, &frame = 0);
+static cell AMX_NATIVE_CALL get_players_snapshot(AMX *amx, cell *params)
+{
+	cell *players = MF_GetAmxAddr(amx, params[1]);
+	int numPlayers = params[2];
+	cell *fields = MF_GetAmxAddr(amx, params[3]);
+	int numFields = params[4];
+	int maxlen = params[6];
+
+	if (numPlayers < 0 || numFields < 0)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid number of players (%d) or fields (%d)", numPlayers, numFields);
+		return 0;
+	}
+
+	int rowSize = 0;
+
+	for (int i = 0; i < numFields; ++i)
+	{
+		switch (fields[i])
+		{
+			case Snapshot_Origin:
+			case Snapshot_Velocity:
+			case Snapshot_ViewAngles:
+				rowSize += 3;
+				break;
+			default:
+				if (fields[i] < 0 || fields[i] >= Snapshot_Fields)
+				{
+					MF_LogError(amx, AMX_ERR_NATIVE, "Invalid snapshot field (%d)", fields[i]);
+					return 0;
+				}
+				rowSize++;
+				break;
+		}
+	}
+
+	if (numPlayers && rowSize > maxlen / numPlayers)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Output buffer too small (%d cells needed, %d given)", rowSize * numPlayers, maxlen);
+		return 0;
+	}
+
+	for (int i = 0; i < numPlayers; ++i)
+	{
+		if (players[i] < 1 || players[i] > gpGlobals->maxClients)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Player out of range (%d)", players[i]);
+			return 0;
+		}
+	}
+
+	TakeSnapshot();
+
+	cell *output = MF_GetAmxAddr(amx, params[5]);
+
+	for (int i = 0; i < numPlayers; ++i)
+	{
+		int id = players[i];
+
+		for (int j = 0; j < numFields; ++j)
+		{
+			switch (fields[j])
+			{
+				case Snapshot_InGame:		*output++ = Snapshot.ingame[id]; break;
+				case Snapshot_Alive:		*output++ = Snapshot.alive[id]; break;
+				case Snapshot_Origin:		output = CopyVector(output, Snapshot.origin[id]); break;
+				case Snapshot_Velocity:		output = CopyVector(output, Snapshot.velocity[id]); break;
+				case Snapshot_ViewAngles:	output = CopyVector(output, Snapshot.viewAngles[id]); break;
+				case Snapshot_Health:		*output++ = amx_ftoc(Snapshot.health[id]); break;
+				case Snapshot_Armor:		*output++ = amx_ftoc(Snapshot.armor[id]); break;
+				case Snapshot_Flags:		*output++ = Snapshot.flags[id]; break;
+				case Snapshot_Button:		*output++ = Snapshot.button[id]; break;
+				case Snapshot_Team:			*output++ = Snapshot.team[id]; break;
+				case Snapshot_Weapons:		*output++ = Snapshot.weapons[id]; break;
+			}
+		}
+	}
+
+	*MF_GetAmxAddr(amx, params[7]) = static_cast<cell>(SnapshotFrame);
+
+	return rowSize * numPlayers;
+}
+
+AMX_NATIVE_INFO snapshot_Natives[] = {
+	{"get_players_snapshot",	get_players_snapshot},
+	{NULL,						NULL}
+};
@@ -0,0 +1,221 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+//
+// Engine Module
+//
+
+#include "engine.h"
+
+// Traces done by the batch natives in the current server frame, so the same trace asked
+// by several plugins is only done once. Entries are stamped with their frame, a new
+// frame counted in StartFrame leaves them all stale.
+struct CachedTrace
+{
+	bool used;
+	unsigned int frame;
+	Vector start;
+	Vector end;
+	int flags;
+	edict_t *ignore;
+	edict_t *passThrough;	// Made non solid during the trace
+	TraceResult result;
+};
+
+static const size_t TraceCacheSize = 2048; // Power of two
+
+static CachedTrace TraceCache[TraceCacheSize];
+
+static size_t HashTrace(const Vector &start, const Vector &end, int flags, edict_t *ignore, edict_t *passThrough)
+{
+	// FNV-1a over the raw values
+	uint32_t hash = 2166136261u;
+
+	auto mix = [&hash](const void *data, size_t size)
+	{
+		const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ bytes[i]) * 16777619u;
+		}
+	};
+
+	mix(&start, sizeof(start));
+	mix(&end, sizeof(end));
+	mix(&flags, sizeof(flags));
+	mix(&ignore, sizeof(ignore));
+	mix(&passThrough, sizeof(passThrough));
+
+	return hash & (TraceCacheSize - 1);
+}
+
+static const TraceResult &CachedTraceLine(const Vector &start, const Vector &end, int flags, edict_t *ignore, edict_t *passThrough)
+{
+	CachedTrace &entry = TraceCache[HashTrace(start, end, flags, ignore, passThrough)];
+
+	if (entry.used && entry.frame == g_FrameCount && entry.start == start && entry.end == end
+		&& entry.flags == flags && entry.ignore == ignore && entry.passThrough == passThrough)
+	{
+		return entry.result;
+	}
+
+	if (passThrough)
+	{
+		auto oldSolid = passThrough->v.solid;
+		passThrough->v.solid = SOLID_NOT;
+		TRACE_LINE(start, end, flags, ignore, &entry.result);
+		passThrough->v.solid = oldSolid;
+	}
+	else
+	{
+		TRACE_LINE(start, end, flags, ignore, &entry.result);
+	}
+
+	entry.used = true;
+	entry.frame = g_FrameCount;
+	entry.start = start;
+	entry.end = end;
+	entry.flags = flags;
+	entry.ignore = ignore;
+	entry.passThrough = passThrough;
+
+	return entry.result;
+}
+
+static void CopyVector(cell *output, const Vector &vec)
+{
+	output[0] = amx_ftoc(vec.x);
+	output[1] = amx_ftoc(vec.y);
+	output[2] = amx_ftoc(vec.z);
+}
+
+// Whether an array of the given size holds count items of the given number of cells
+static bool CheckBatchArray(AMX *amx, const char *name, int count, int itemSize, int size)
+{
+	if (count > size / itemSize)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "%s too small for %d entries of %d cells (%d cells given)", name, count, itemSize, size);
+		return false;
+	}
+
+	return true;
+}
+
+//native trace_line_batch(const Float:starts[], startslen, const Float:ends[], endslen, const ignore[], ignorelen, count, flags, Float:results[], maxlen);
+static cell AMX_NATIVE_CALL trace_line_batch(AMX *amx, cell *params)
+{
+	cell *starts = MF_GetAmxAddr(amx, params[1]);
+	cell *ends = MF_GetAmxAddr(amx, params[3]);
+	cell *ignore = MF_GetAmxAddr(amx, params[5]);
+	int count = params[7];
+	int flags = params[8];
+
+	if (count < 0)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid number of traces (%d)", count);
+		return 0;
+	}
+
+	if (!CheckBatchArray(amx, "Starting points array", count, 3, params[2])
+		|| !CheckBatchArray(amx, "Ending points array", count, 3, params[4])
+		|| !CheckBatchArray(amx, "Ignore array", count, 1, params[6])
+		|| !CheckBatchArray(amx, "Output buffer", count, TraceBatch_Size, params[10]))
+	{
+		return 0;
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (ignore[i] > 0)
+		{
+			CHECK_ENTITY(ignore[i]);
+		}
+	}
+
+	CountFrames();
+
+	cell *output = MF_GetAmxAddr(amx, params[9]);
+
+	for (int i = 0; i < count; ++i, output += TraceBatch_Size)
+	{
+		Vector vStart(amx_ctof(starts[i * 3]), amx_ctof(starts[i * 3 + 1]), amx_ctof(starts[i * 3 + 2]));
+		Vector vEnd(amx_ctof(ends[i * 3]), amx_ctof(ends[i * 3 + 1]), amx_ctof(ends[i * 3 + 2]));
+		edict_t *pIgnore = ignore[i] > 0 ? TypeConversion.id_to_edict(ignore[i]) : NULL;
+
+		const TraceResult &tr = CachedTraceLine(vStart, vEnd, flags, pIgnore, NULL);
+
+		output[TraceBatch_Fraction] = amx_ftoc(tr.flFraction);
+		output[TraceBatch_Hit] = FNullEnt(tr.pHit) ? -1 : TypeConversion.edict_to_id(tr.pHit);
+
+		CopyVector(output + TraceBatch_EndPos, tr.vecEndPos);
+		CopyVector(output + TraceBatch_PlaneNormal, tr.vecPlaneNormal);
+	}
+
+	return count;
+}
+
+//native is_visible_batch(const sources[], sourceslen, const targets[], targetslen, count, bool:results[], maxlen);
+static cell AMX_NATIVE_CALL is_visible_batch(AMX *amx, cell *params)
+{
+	cell *sources = MF_GetAmxAddr(amx, params[1]);
+	cell *targets = MF_GetAmxAddr(amx, params[3]);
+	int count = params[5];
+
+	if (count < 0)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid number of pairs (%d)", count);
+		return 0;
+	}
+
+	if (!CheckBatchArray(amx, "Sources array", count, 1, params[2])
+		|| !CheckBatchArray(amx, "Targets array", count, 1, params[4])
+		|| !CheckBatchArray(amx, "Output buffer", count, 1, params[7]))
+	{
+		return 0;
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		CHECK_ENTITY(sources[i]);
+		CHECK_ENTITY(targets[i]);
+	}
+
+	CountFrames();
+
+	cell *results = MF_GetAmxAddr(amx, params[6]);
+
+	// Same as is_visible()
+	for (int i = 0; i < count; ++i)
+	{
+		edict_t *pEntity = TypeConversion.id_to_edict(sources[i]);
+		edict_t *pTarget = TypeConversion.id_to_edict(targets[i]);
+
+		if (pTarget->v.flags & FL_NOTARGET)
+		{
+			results[i] = 0;
+			continue;
+		}
+
+		Vector vLooker = pEntity->v.origin + pEntity->v.view_ofs;
+		Vector vTarget = pTarget->v.origin + pTarget->v.view_ofs;
+
+		const TraceResult &tr = CachedTraceLine(vLooker, vTarget, FALSE, pEntity, pTarget);
+
+		results[i] = !(tr.fInOpen && tr.fInWater) && tr.flFraction == 1.0;
+	}
+
+	return count;
+}
+
+AMX_NATIVE_INFO trace_Natives[] = {
+	{"trace_line_batch",	trace_line_batch},
+	{"is_visible_batch",	is_visible_batch},
+	{NULL,					NULL}
+};
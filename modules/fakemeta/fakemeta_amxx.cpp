@@ -47,6 +47,7 @@ void OnAmxxAttach()
 	MF_AddNatives(misc_natives);
 	MF_AddNatives(pdata_entities_natives);
 	MF_AddNatives(pdata_gamerules_natives);
+	MF_AddNatives(transmit_natives);
 
 	g_kvd_glb.kvd.szClassName = const_cast<char *>(g_kvd_glb.cls.chars());
 	g_kvd_glb.kvd.szKeyName = const_cast<char *>(g_kvd_glb.key.chars());
@@ -298,6 +299,9 @@ void FMH_ServerDeactivate_Post()
 	RESETN(GameShutdown);
 	RESETN(ShouldCollide);
 
+	// Entities are gone with the map, forwards are released by the core.
+	g_Transmit.Clear(false);
+
 	g_pFunctionTable->pfnServerActivate = ServerActivate;
 
 	RETURN_META(MRES_IGNORED);
@@ -23,6 +23,7 @@
 #include "forward.h"
 #include "fm_tr.h"
 #include "glb.h"
+#include "transmit.h"
 #include <amtl/am-string.h>
 #include <amtl/am-vector.h>
 #include <IGameConfigs.h>
@@ -758,8 +758,19 @@ void UpdateClientData_post(const struct edict_s *ent, int sendweapons, struct cl
 	RETURN_META(MRES_IGNORED);
 }
 
+// Set when the pre hook hid the entity, for the post hook which Metamod still calls
+static bool g_TransmitHidden = false;
+
 int AddToFullPack(struct entity_state_s *state, int e, edict_t *ent, edict_t *host, int hostflags, int player, unsigned char *pSet)
 {
+	// Hidden by a transmit rule, plugin forwards are skipped too, pre and post
+	if (g_Transmit.IsActive() && g_Transmit.ShouldHide(ent, e, host))
+	{
+		g_TransmitHidden = true;
+		RETURN_META_VALUE(MRES_SUPERCEDE, 0);
+	}
+
+	g_TransmitHidden = false;
 	g_es_hook = state;
 	FM_ENG_HANDLE(FM_AddToFullPack, (Engine[FM_AddToFullPack].at(i), (cell)state, (cell)e, (cell)ENTINDEX(ent), (cell)ENTINDEX(host), (cell)hostflags, (cell)player, (cell)pSet));
 	RETURN_META_VALUE(mswi(lastFmRes), (int)mlCellResult);
@@ -767,8 +778,20 @@ int AddToFullPack(struct entity_state_s *state, int e, edict_t *ent, edict_t *ho
 
 int AddToFullPack_post(struct entity_state_s *state, int e, edict_t *ent, edict_t *host, int hostflags, int player, unsigned char *pSet)
 {
+	if (g_TransmitHidden)
+	{
+		g_TransmitHidden = false;
+		RETURN_META_VALUE(MRES_IGNORED, 0);
+	}
+
 	g_es_hook = state;
 	origCellRet = META_RESULT_ORIG_RET(int);
+
+	if (origCellRet && g_Transmit.IsActive())
+	{
+		g_Transmit.ApplyRender(ent, e, host, state);
+	}
+
 	FM_ENG_HANDLE_POST(FM_AddToFullPack, (EnginePost[FM_AddToFullPack].at(i), (cell)state, (cell)e, (cell)ENTINDEX(ent), (cell)ENTINDEX(host), (cell)hostflags, (cell)player, (cell)pSet));
 	RETURN_META_VALUE(MRES_IGNORED, (int)mlCellResult);
 }
@@ -848,7 +871,7 @@ static cell AMX_NATIVE_CALL unregister_forward(AMX *amx, cell *params)
 		{
 			peng->remove(i);
 			MF_UnregisterSPForward(func_id);
-			if (!peng->length() && patchAddr != NULL && func != FM_ServerDeactivate)
+			if (!peng->length() && patchAddr != NULL && func != FM_ServerDeactivate && !(func == FM_AddToFullPack && g_Transmit.IsActive()))
 			{
 				/* Clear out this forward if we no longer need it */
 				*(void **)patchAddr = NULL;
@@ -0,0 +1,404 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+//
+// Fakemeta Module
+//
+
+#include "fakemeta_amxx.h"
+#include "transmit.h"
+
+TransmitRules g_Transmit;
+
+int AddToFullPack(struct entity_state_s *state, int e, edict_t *ent, edict_t *host, int hostflags, int player, unsigned char *pSet);
+int AddToFullPack_post(struct entity_state_s *state, int e, edict_t *ent, edict_t *host, int hostflags, int player, unsigned char *pSet);
+
+TransmitRules::~TransmitRules()
+{
+	Clear(false);
+}
+
+TransmitRule *TransmitRules::Get(edict_t *ent, int entity)
+{
+	TransmitRule *rule = Find(ent, entity);
+
+	if (rule)
+	{
+		return rule;
+	}
+
+	while (m_Rules.length() <= static_cast<size_t>(entity))
+	{
+		m_Rules.append(nullptr);
+	}
+
+	rule = new TransmitRule(ent->serialnumber);
+
+	m_Rules[entity] = rule;
+	m_Count++;
+
+	// Shared with register_forward(), which leaves them alone while rules are set
+	g_pFunctionTable->pfnAddToFullPack = AddToFullPack;
+	g_pFunctionTable_Post->pfnAddToFullPack = AddToFullPack_post;
+
+	return rule;
+}
+
+TransmitRule *TransmitRules::Find(edict_t *ent, int entity)
+{
+	if (static_cast<size_t>(entity) >= m_Rules.length())
+	{
+		return nullptr;
+	}
+
+	TransmitRule *rule = m_Rules[entity];
+
+	if (rule && (ent->free || ent->serialnumber != rule->serial))
+	{
+		// The entity was removed, its index may have been reused since
+		Remove(entity);
+		return nullptr;
+	}
+
+	return rule;
+}
+
+void TransmitRules::Remove(int entity, bool unregister)
+{
+	if (static_cast<size_t>(entity) >= m_Rules.length() || !m_Rules[entity])
+	{
+		return;
+	}
+
+	TransmitRule *rule = m_Rules[entity];
+
+	if (unregister && rule->forward != -1)
+	{
+		MF_UnregisterSPForward(rule->forward);
+	}
+
+	delete rule;
+
+	m_Rules[entity] = nullptr;
+	m_Count--;
+}
+
+void TransmitRules::Clear(bool unregister)
+{
+	for (size_t i = 0; i < m_Rules.length(); ++i)
+	{
+		Remove(i, unregister);
+	}
+
+	m_Rules.clear();
+}
+
+bool TransmitRules::ShouldHide(edict_t *ent, int entity, edict_t *host)
+{
+	TransmitRule *rule = Find(ent, entity);
+
+	// A player always gets its own entity
+	if (!rule || ent == host)
+	{
+		return false;
+	}
+
+	int hostIndex = TypeConversion.edict_to_id(host);
+
+	if (rule->hidden & (1u << (hostIndex - 1)))
+	{
+		return true;
+	}
+
+	if (rule->ownerOnly && ent->v.owner != host)
+	{
+		return true;
+	}
+
+	if (rule->team && host->v.team != rule->team)
+	{
+		return true;
+	}
+
+	if (rule->maxDistance > 0.0f)
+	{
+		// Brush entities have their origin at the world origin, use the center of the box
+		Vector delta = (ent->v.absmin + ent->v.absmax) * 0.5f - (host->v.origin + host->v.view_ofs);
+
+		if (DotProduct(delta, delta) > rule->maxDistance)
+		{
+			return true;
+		}
+	}
+
+	if (rule->forward != -1)
+	{
+		return MF_ExecuteForward(rule->forward, static_cast<cell>(entity), static_cast<cell>(hostIndex)) != 0;
+	}
+
+	return false;
+}
+
+void TransmitRules::ApplyRender(edict_t *ent, int entity, edict_t *host, entity_state_t *state)
+{
+	TransmitRule *rule = Find(ent, entity);
+
+	if (!rule || !(rule->renderPlayers & (1u << (TypeConversion.edict_to_id(host) - 1))))
+	{
+		return;
+	}
+
+	state->rendermode = rule->renderMode;
+	state->renderfx = rule->renderFx;
+	state->renderamt = rule->renderAmount;
+	state->rendercolor.r = rule->renderColor[0];
+	state->rendercolor.g = rule->renderColor[1];
+	state->rendercolor.b = rule->renderColor[2];
+}
+
+#define CHECK_TRANSMIT_ENTITY(x) \
+	if (x < 1 || x >= gpGlobals->maxEntities || FNullEnt(TypeConversion.id_to_edict(x))) { \
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid entity %d", x); \
+		return 0; \
+	}
+
+#define CHECK_TRANSMIT_PLAYER(x) \
+	if (x < 0 || x > gpGlobals->maxClients) { \
+		MF_LogError(amx, AMX_ERR_NATIVE, "Player out of range (%d)", x); \
+		return 0; \
+	}
+
+// Bit of a player, all of them for 0
+static uint32_t PlayerBits(int player)
+{
+	return player ? 1u << (player - 1) : ~0u;
+}
+
+// Drops the rule once nothing is left in it
+static void Update(int entity, TransmitRule *rule)
+{
+	if (rule->IsEmpty())
+	{
+		g_Transmit.Remove(entity);
+	}
+}
+
+// native transmit_set_visible(entity, player, bool:visible);
+static cell AMX_NATIVE_CALL transmit_set_visible(AMX *amx, cell *params)
+{
+	int entity = params[1];
+	int player = params[2];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+	CHECK_TRANSMIT_PLAYER(player);
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = g_Transmit.Get(ent, entity);
+
+	if (params[3])
+	{
+		rule->hidden &= ~PlayerBits(player);
+	}
+	else
+	{
+		rule->hidden |= PlayerBits(player);
+	}
+
+	Update(entity, rule);
+
+	return 1;
+}
+
+// native bool:transmit_is_visible(entity, player);
+static cell AMX_NATIVE_CALL transmit_is_visible(AMX *amx, cell *params)
+{
+	int entity = params[1];
+	int player = params[2];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+
+	if (player < 1 || player > gpGlobals->maxClients)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Player out of range (%d)", player);
+		return 0;
+	}
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = g_Transmit.Find(ent, entity);
+
+	return !rule || !(rule->hidden & PlayerBits(player));
+}
+
+// native transmit_set_owner_only(entity, bool:enable);
+static cell AMX_NATIVE_CALL transmit_set_owner_only(AMX *amx, cell *params)
+{
+	int entity = params[1];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = g_Transmit.Get(ent, entity);
+
+	rule->ownerOnly = params[2] != 0;
+
+	Update(entity, rule);
+
+	return 1;
+}
+
+// native transmit_set_team(entity, team);
+static cell AMX_NATIVE_CALL transmit_set_team(AMX *amx, cell *params)
+{
+	int entity = params[1];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = g_Transmit.Get(ent, entity);
+
+	rule->team = params[2];
+
+	Update(entity, rule);
+
+	return 1;
+}
+
+// native transmit_set_distance(entity, Float:distance);
+static cell AMX_NATIVE_CALL transmit_set_distance(AMX *amx, cell *params)
+{
+	int entity = params[1];
+	float distance = amx_ctof(params[2]);
+
+	CHECK_TRANSMIT_ENTITY(entity);
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = g_Transmit.Get(ent, entity);
+
+	rule->maxDistance = distance > 0.0f ? distance * distance : 0.0f;
+
+	Update(entity, rule);
+
+	return 1;
+}
+
+// native transmit_set_render(entity, player, fx = kRenderFxNone, const Float:color[3] = {255.0, 255.0, 255.0}, render = kRenderNormal, Float:amount = 16.0);
+static cell AMX_NATIVE_CALL transmit_set_render(AMX *amx, cell *params)
+{
+	int entity = params[1];
+	int player = params[2];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+	CHECK_TRANSMIT_PLAYER(player);
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = g_Transmit.Get(ent, entity);
+
+	cell *color = MF_GetAmxAddr(amx, params[4]);
+
+	rule->renderPlayers |= PlayerBits(player);
+	rule->renderFx = params[3];
+	rule->renderMode = params[5];
+	rule->renderAmount = static_cast<int>(amx_ctof(params[6]));
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		rule->renderColor[i] = static_cast<unsigned char>(static_cast<int>(amx_ctof(color[i])));
+	}
+
+	return 1;
+}
+
+// native transmit_reset_render(entity, player = 0);
+static cell AMX_NATIVE_CALL transmit_reset_render(AMX *amx, cell *params)
+{
+	int entity = params[1];
+	int player = params[2];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+	CHECK_TRANSMIT_PLAYER(player);
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = g_Transmit.Find(ent, entity);
+
+	if (rule)
+	{
+		rule->renderPlayers &= ~PlayerBits(player);
+
+		Update(entity, rule);
+	}
+
+	return 1;
+}
+
+// native transmit_set_callback(entity, const callback[]);
+static cell AMX_NATIVE_CALL transmit_set_callback(AMX *amx, cell *params)
+{
+	int entity = params[1];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+
+	int length;
+	const char *function = MF_GetAmxString(amx, params[2], 0, &length);
+
+	int forward = -1;
+
+	if (length)
+	{
+		forward = MF_RegisterSPForwardByName(amx, function, FP_CELL, FP_CELL, FP_DONE);
+
+		if (forward == -1)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Function %s not found", function);
+			return 0;
+		}
+	}
+
+	edict_t *ent = TypeConversion.id_to_edict(entity);
+	TransmitRule *rule = forward != -1 ? g_Transmit.Get(ent, entity) : g_Transmit.Find(ent, entity);
+
+	if (rule)
+	{
+		if (rule->forward != -1)
+		{
+			MF_UnregisterSPForward(rule->forward);
+		}
+
+		rule->forward = forward;
+
+		Update(entity, rule);
+	}
+
+	return 1;
+}
+
+// native transmit_clear(entity);
+static cell AMX_NATIVE_CALL transmit_clear(AMX *amx, cell *params)
+{
+	int entity = params[1];
+
+	CHECK_TRANSMIT_ENTITY(entity);
+
+	g_Transmit.Remove(entity);
+
+	return 1;
+}
+
+AMX_NATIVE_INFO transmit_natives[] =
+{
+	{ "transmit_set_visible",		transmit_set_visible },
+	{ "transmit_is_visible",		transmit_is_visible },
+	{ "transmit_set_owner_only",	transmit_set_owner_only },
+	{ "transmit_set_team",			transmit_set_team },
+	{ "transmit_set_distance",		transmit_set_distance },
+	{ "transmit_set_render",		transmit_set_render },
+	{ "transmit_reset_render",		transmit_reset_render },
+	{ "transmit_set_callback",		transmit_set_callback },
+	{ "transmit_clear",				transmit_clear },
+	{ NULL,							NULL }
+};
@@ -0,0 +1,77 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+//
+// Fakemeta Module
+//
+
+#ifndef _INCLUDE_TRANSMIT_H
+#define _INCLUDE_TRANSMIT_H
+
+#include <amtl/am-vector.h>
+
+// What decides if an entity is sent to a player, checked in AddToFullPack
+// without calling into plugins unless a callback is set.
+struct TransmitRule
+{
+	TransmitRule(int serialnumber) :
+		serial(serialnumber), hidden(0), ownerOnly(false), team(0), maxDistance(0.0f), forward(-1),
+		renderPlayers(0), renderMode(0), renderFx(0), renderAmount(0)
+	{
+		renderColor[0] = renderColor[1] = renderColor[2] = 0;
+	}
+
+	bool IsEmpty() const
+	{
+		return !hidden && !ownerOnly && !team && maxDistance <= 0.0f && forward == -1 && !renderPlayers;
+	}
+
+	int serial;           // Serial number of the edict, rules don't carry over to a reused index
+	uint32_t hidden;      // Players the entity is hidden from, bit (index - 1)
+	bool ownerOnly;       // Sent to its owner only
+	int team;             // Sent to players with this pev_team only, 0 for any
+	float maxDistance;    // Squared, 0 for no limit
+	int forward;          // Plugin callback, for what the above can't express
+
+	uint32_t renderPlayers; // Players the render override is sent to
+	int renderMode;
+	int renderFx;
+	int renderAmount;
+	unsigned char renderColor[3];
+};
+
+class TransmitRules
+{
+public:
+	~TransmitRules();
+
+public:
+	TransmitRule *Get(edict_t *ent, int entity);
+	TransmitRule *Find(edict_t *ent, int entity);
+	void Remove(int entity, bool unregister = true);
+	void Clear(bool unregister);
+
+	bool IsActive() const
+	{
+		return m_Count > 0;
+	}
+
+public:
+	bool ShouldHide(edict_t *ent, int entity, edict_t *host);
+	void ApplyRender(edict_t *ent, int entity, edict_t *host, entity_state_t *state);
+
+private:
+	ke::Vector<TransmitRule *> m_Rules;
+	size_t m_Count = 0;
+};
+
+extern TransmitRules g_Transmit;
+extern AMX_NATIVE_INFO transmit_natives[];
+
+#endif //_INCLUDE_TRANSMIT_H
@@ -19,6 +19,7 @@
 #include "hook.h"
 #include "ham_const.h"
 #include "hooklist.h"
+#include "call_funcs.h"
 #include "offsets.h"
 #include <assert.h>
 #include "DataHandler.h"
@@ -123,6 +124,8 @@ void OnPluginsUnloaded(void)
 		}
 		hooks[i].clear();
 	}
+
+	ClearCallCache();
 }
 
 void OnPluginsLoaded(void)
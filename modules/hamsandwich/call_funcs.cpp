@@ -18,6 +18,7 @@
 #include "hooklist.h"
 #include "forward.h"
 #include "hook.h"
+#include "call_thunks.h"
 #include <amtl/am-vector.h>
 #include <amtl/am-string.h>
 
@@ -25,25 +26,108 @@ extern ke::Vector<Hook *> hooks[HAM_LAST_ENTRY_DONT_USE_ME_LOL];
 
 void FailPlugin(AMX *amx, int id, int err, const char *reason);
 
-extern bool gDoForwards;
+// Resolved calls, per function and class. The vtable entry of a class only changes
+// when it gets hooked, or patched by something else, so a descriptor is checked
+// against it and resolved again if it differs. Hooks are only freed with the
+// plugins, along with the descriptors.
+struct CallDescriptor
+{
+	void **vtable;	// Class
+	void *slot;		// Its vtable entry, a trampoline if the function is hooked
+	Hook *hook;		// Hook owning that trampoline
+};
+
+static const size_t CallCacheSize = 16; // Classes per function, power of two
+
+static CallDescriptor *CallCache[HAM_LAST_ENTRY_DONT_USE_ME_LOL];
+
+void ClearCallCache()
+{
+	for (size_t i = 0; i < HAM_LAST_ENTRY_DONT_USE_ME_LOL; ++i)
+	{
+		delete [] CallCache[i];
+		CallCache[i] = NULL;
+	}
+}
 
-inline void *GetFunction(void *pthis, int id, bool &istramp)
+static inline const CallDescriptor &ResolveCall(void *pthis, int id)
 {
-	istramp=false;
-	void *func=GetVTableEntry(pthis, hooklist[id].vtid, Offsets.GetBase());
+	void **vtbl=GetVTable(pthis, Offsets.GetBase());
+	void *slot=vtbl[hooklist[id].vtid];
+
+	if (!CallCache[id])
+	{
+		CallCache[id] = new CallDescriptor[CallCacheSize]();
+	}
+
+	CallDescriptor &desc=CallCache[id][(reinterpret_cast<uintptr_t>(vtbl) >> 4) & (CallCacheSize - 1)];
+
+	if (desc.vtable == vtbl && desc.slot == slot)
+	{
+		return desc;
+	}
+
+	desc.vtable=vtbl;
+	desc.slot=slot;
+	desc.hook=NULL;
 
 	// Check to see if it's a trampoline
 	for (size_t i = 0; i < hooks[id].length(); ++i)
 	{
-		if (func == hooks[id].at(i)->tramp)
+		if (slot == hooks[id].at(i)->tramp)
 		{
-			istramp=true;
-			return func;
+			desc.hook=hooks[id].at(i);
+			break;
 		}
 	}
 
-	return func;
+	return desc;
 }
+
+// Whether a forward of the hook would run for the entity
+static inline bool HasForwards(const Hook *hook, int id)
+{
+	for (size_t i = 0; i < hook->pre.length(); ++i)
+	{
+		if (hook->pre.at(i)->state == FSTATE_OK && hook->pre.at(i)->IsEnabledFor(id))
+		{
+			return true;
+		}
+	}
+
+	for (size_t i = 0; i < hook->post.length(); ++i)
+	{
+		if (hook->post.at(i)->state == FSTATE_OK && hook->post.at(i)->IsEnabledFor(id))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// The function is checked by the caller. Without forwards, or when none would run,
+// the original function is called directly rather than through the trampoline.
+cell ExecuteHamCall(AMX *amx, cell *params, bool forwards)
+{
+	int func=params[1];
+	int id=params[2];
+
+	CHECK_ENTITY(id);
+
+	void *pthis=TypeConversion.id_to_cbase(id);
+	const CallDescriptor &desc=ResolveCall(pthis, func);
+
+	void *target=desc.slot;
+
+	if (desc.hook && (!forwards || !HasForwards(desc.hook, id)))
+	{
+		target=desc.hook->func;
+	}
+
+	return hooklist[func].call(amx, params, pthis, target);
+}
+
 inline void *_GetFunction(void *pthis, int id)
 {
 	void **vtbl=GetVTable(pthis, Offsets.GetBase());
@@ -72,228 +156,45 @@ inline void *_GetFunction(void *pthis, int id)
 		MF_LogError(amx, AMX_ERR_NATIVE, "Bad arg count.  Expected %d, got %d.", NUMARGS + 2, params[0] / sizeof(cell));	\
 		return 0;						\
 	}									\
-	int func=params[1];					\
-	int id=params[2];					\
-	CHECK_FUNCTION(func);				\
-	CHECK_ENTITY(id);					\
-	void *pv=TypeConversion.id_to_cbase(id);		\
-	bool istramp;						\
-	void *__func=GetFunction(pv, func, istramp);	\
-	if (!istramp && !gDoForwards)		\
-	{									\
-		gDoForwards=true;				\
+	void *pv=pthis;						\
+	void *__func=func;
+
+// Signatures converted by HamThunk
+#define THUNK(NAME, ...)	\
+	cell Call_##NAME(AMX *amx, cell *params, void *pthis, void *func)	\
+	{																	\
+		return HamThunk<__VA_ARGS__>::Call(amx, params, pthis, func);	\
 	}
 
+THUNK(Void_Void, void)
 
-cell Call_Void_Void(AMX *amx, cell *params)
-{
-	SETUP(0);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int)>(__func)(pv, 0);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *)>(__func)(pv);
-#endif
-	return 1;
-}
-
-cell Call_Int_Void(AMX *amx, cell *params)
-{
-	SETUP(0);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int)>(__func)(pv, 0);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *)>(__func)(pv);
-#endif
-}
-
-cell Call_Void_Entvar(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-
-	CHECK_ENTITY(id3);
-
-	entvars_t *ev1 = TypeConversion.id_to_entvars(id3);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, entvars_t *)>(__func)(pv, 0, ev1);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, entvars_t *)>(__func)(pv, ev1);
-#endif
-	return 1;
-}
-
-
-cell Call_Void_Cbase(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-
-	CHECK_ENTITY(id3);
-
-	void *pv1 = TypeConversion.id_to_cbase(id3);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, void *)>(__func)(pv, 0, pv1);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, void *)>(__func)(pv, pv1);
-#endif
-	return 1;
-}
-
-cell Call_Int_Float_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, float, int)>(__func)(pv, 0, f3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, float, int)>(__func)(pv, f3, i4);
-#endif
-}
-
-cell Call_Int_Float_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(3);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-	int i5=*MF_GetAmxAddr(amx, params[5]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, float, int, int)>(__func)(pv, 0, f3, i4, i5);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, float, int, int)>(__func)(pv, f3, i4, i5);
-#endif
-}
-
-cell Call_Bool_Float_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(3);
-
-	float f3 = amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-	int i4 = *MF_GetAmxAddr(amx, params[4]);
-	int i5 = *MF_GetAmxAddr(amx, params[5]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool(__fastcall *)(void*, int, float, int, int)>(__func)(pv, 0, f3, i4, i5) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool(*)(void *, float, int, int)>(__func)(pv, f3, i4, i5) ? TRUE : FALSE;
-#endif
-}
-
-cell Call_Void_Entvar_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-
-	CHECK_ENTITY(id3);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, entvars_t *, int)>(__func)(pv, 0, ev3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, entvars_t *, int)>(__func)(pv, ev3, i4);
-#endif
-	return 1;
-}
-
-cell Call_Void_Entvar_Entvar_Int(AMX *amx, cell *params)
-{
-	SETUP(3);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	int i5=*MF_GetAmxAddr(amx, params[5]);
+THUNK(Int_Void, int)
 
-	CHECK_ENTITY(id3);
-	CHECK_ENTITY(id4);
+THUNK(Void_Entvar, void, entvars_t *)
 
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-	entvars_t *ev4 = TypeConversion.id_to_entvars(id4);
 
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, entvars_t *, entvars_t *, int)>(__func)(pv, 0, ev3, ev4, i5);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, entvars_t *, entvars_t *, int)>(__func)(pv, ev3, ev4, i5);
-#endif
-	return 1;
-}
+THUNK(Void_Cbase, void, HamCbase)
 
+THUNK(Int_Float_Int, int, float, int)
 
-cell Call_Int_Cbase(AMX *amx, cell *params)
-{
-	SETUP(1);
+THUNK(Int_Float_Int_Int, int, float, int, int)
 
-	int id3=*MF_GetAmxAddr(amx, params[3]);
+THUNK(Bool_Float_Int_Int, bool, float, int, int)
 
-	CHECK_ENTITY(id3);
+THUNK(Void_Entvar_Int, void, entvars_t *, int)
 
-	void *pv1 = TypeConversion.id_to_cbase(id3);
+THUNK(Void_Entvar_Entvar_Int, void, entvars_t *, entvars_t *, int)
 
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, void *)>(__func)(pv, 0, pv1);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, void *)>(__func)(pv, pv1);
-#endif
-}
 
-cell Call_Void_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
+THUNK(Int_Cbase, int, HamCbase)
 
-	int i3=*MF_GetAmxAddr(amx, params[3]);
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, int, int)>(__func)(pv, 0, i3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, int, int)>(__func)(pv, i3, i4);
-#endif
-	return 1;
-}
-
-cell Call_Void_Int_Bool(AMX *amx, cell *params)
-{
-	SETUP(2);
+THUNK(Void_Int_Int, void, int, int)
 
-	int i3  = *MF_GetAmxAddr(amx, params[3]);
-	bool i4 = *MF_GetAmxAddr(amx, params[4]) != 0;
+THUNK(Void_Int_Bool, void, int, bool)
 
-#if defined(_WIN32)
-	reinterpret_cast<void(__fastcall *)(void*, int, int, bool)>(__func)(pv, 0, i3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void(*)(void *, int, bool)>(__func)(pv, i3, i4);
-#endif
-	return 1;
-}
-
-cell Call_Void_Bool_Bool(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	bool i3 = *MF_GetAmxAddr(amx, params[3]) != 0;
-	bool i4 = *MF_GetAmxAddr(amx, params[4]) != 0;
-
-#if defined(_WIN32)
-	reinterpret_cast<void(__fastcall *)(void*, int, bool, bool)>(__func)(pv, 0, i3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void(*)(void *, bool, bool)>(__func)(pv, i3, i4);
-#endif
-	return 1;
-}
+THUNK(Void_Bool_Bool, void, bool, bool)
 
-cell Call_Int_Int_Str_Int(AMX *amx, cell *params)
+cell Call_Int_Int_Str_Int(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(3);
 
@@ -308,7 +209,7 @@ cell Call_Int_Int_Str_Int(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Int_Int_Str_Int_Int(AMX *amx, cell *params)
+cell Call_Int_Int_Str_Int_Int(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(4);
 
@@ -324,7 +225,7 @@ cell Call_Int_Int_Str_Int_Int(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Int_Int_Str_Int_Bool(AMX *amx, cell *params)
+cell Call_Int_Int_Str_Int_Bool(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(4);
 
@@ -340,110 +241,19 @@ cell Call_Int_Int_Str_Int_Bool(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int i3=*MF_GetAmxAddr(amx, params[3]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, int)>(__func)(pv, 0, i3);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, int)>(__func)(pv, i3);
-#endif
-}
-
-cell Call_Bool_Bool(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	bool i3 = *MF_GetAmxAddr(amx, params[3]) != 0;
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool (__fastcall *)(void*, int, bool)>(__func)(pv, 0, i3) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool (*)(void *, bool)>(__func)(pv, i3) ? TRUE : FALSE;
-#endif
-}
-
-cell Call_Int_Entvar(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-
-	CHECK_ENTITY(id3);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, entvars_t *)>(__func)(pv, 0, ev3);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, entvars_t *)>(__func)(pv, ev3);
-#endif
-}
-
-cell Call_Int_Entvar_Entvar_Float_Int(AMX *amx, cell *params)
-{
-	SETUP(4);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-	int i6=*MF_GetAmxAddr(amx, params[6]);
-
-	CHECK_ENTITY(id3);
-	CHECK_ENTITY(id4);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-	entvars_t *ev4 = TypeConversion.id_to_entvars(id4);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, entvars_t *, entvars_t *, float, int)>(__func)(pv, 0, ev3, ev4, f5, i6);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, entvars_t *, entvars_t *, float, int)>(__func)(pv, ev3, ev4, f5, i6);
-#endif
-}
-
-cell Call_Int_Entvar_Entvar_Float_Float_Int(AMX *amx, cell *params)
-{
-	SETUP(5);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-	float f6=amx_ctof(*MF_GetAmxAddr(amx, params[6]));
-	int i7=*MF_GetAmxAddr(amx, params[7]);
-
-	CHECK_ENTITY(id3);
-	CHECK_ENTITY(id4);
+THUNK(Int_Int, int, int)
 
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-	entvars_t *ev4 = TypeConversion.id_to_entvars(id4);
+THUNK(Bool_Bool, bool, bool)
 
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, entvars_t *, entvars_t *, float, float, int)>(__func)(pv, 0, ev3, ev4, f5, f6, i7);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, entvars_t *, entvars_t *, float, float, int)>(__func)(pv, ev3, ev4, f5, f6, i7);
-#endif
-}
+THUNK(Int_Entvar, int, entvars_t *)
 
-cell Call_Void_Int(AMX *amx, cell *params)
-{
-	SETUP(1);
+THUNK(Int_Entvar_Entvar_Float_Int, int, entvars_t *, entvars_t *, float, int)
 
-	int i3=*MF_GetAmxAddr(amx, params[3]);
+THUNK(Int_Entvar_Entvar_Float_Float_Int, int, entvars_t *, entvars_t *, float, float, int)
 
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, int)>(__func)(pv, 0, i3);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, int)>(__func)(pv, i3);
-#endif
+THUNK(Void_Int, void, int)
 
-	return 1;
-}
-
-cell Call_Vector_Float_Cbase_Int(AMX *amx, cell *params)
+cell Call_Vector_Float_Cbase_Int(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(4);
 
@@ -470,95 +280,13 @@ cell Call_Vector_Float_Cbase_Int(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Cbase_Cbase_Int_Float(AMX *amx, cell *params)
-{
-	SETUP(4);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	int i5=*MF_GetAmxAddr(amx, params[5]);
-	float f6=amx_ctof(*MF_GetAmxAddr(amx, params[6]));
-
-	CHECK_ENTITY(id3);
-	CHECK_ENTITY(id4);
-
-	void *p3 = TypeConversion.id_to_cbase(id3);
-	void *p4 = TypeConversion.id_to_cbase(id4);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, void *, void *, int, float)>(__func)(pv, 0, p3, p4, i5, f6);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, void *, void *, int, float)>(__func)(pv, p3, p4, i5, f6);
-#endif
-
-	return 1;
-}
-
-cell Call_Void_Entvar_Float_Vector_Trace_Int(AMX *amx, cell *params)
-{
-	SETUP(5);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	float f4=amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-	Vector v5;
-	TraceResult *tr6=reinterpret_cast<TraceResult *>(*MF_GetAmxAddr(amx, params[6]));
-	int i7=*MF_GetAmxAddr(amx, params[7]);
-
-	float *fl5=(float *)MF_GetAmxAddr(amx, params[5]);
-	v5.x=fl5[0];
-	v5.y=fl5[1];
-	v5.z=fl5[2];
+THUNK(Void_Cbase_Cbase_Int_Float, void, HamCbase, HamCbase, int, float)
 
-	if (tr6==NULL)
-	{
-		MF_LogError(amx, AMX_ERR_NATIVE, "Null traceresult provided.");
-
-		return 0;
-	}
-
-	CHECK_ENTITY(id3);
+THUNK(Void_Entvar_Float_Vector_Trace_Int, void, entvars_t *, float, Vector, TraceResult *, int)
 
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, entvars_t *, float, Vector, TraceResult *, int)>(__func)(pv, 0, ev3, f4, v5, tr6, i7);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, entvars_t *, float, Vector, TraceResult *, int)>(__func)(pv, ev3, f4, v5, tr6, i7);
-#endif
-
-	return 1;
-}
-
-cell Call_Void_Float_Vector_Trace_Int(AMX *amx, cell *params)
-{
-	SETUP(4);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-	Vector v4;
-	TraceResult *tr5=reinterpret_cast<TraceResult *>(*MF_GetAmxAddr(amx, params[5]));
-	int i6=*MF_GetAmxAddr(amx, params[6]);
-
-	float *fl4=(float *)MF_GetAmxAddr(amx, params[4]);
-	v4.x=fl4[0];
-	v4.y=fl4[1];
-	v4.z=fl4[2];
-
-	if (tr5==NULL)
-	{
-		MF_LogError(amx, AMX_ERR_NATIVE, "Null traceresult provided.");
-
-		return 0;
-	}
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, float, Vector, TraceResult *, int)>(__func)(pv, 0, f3, v4, tr5, i6);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, float, Vector, TraceResult *, int)>(__func)(pv, f3, v4, tr5, i6);
-#endif
-
-	return 1;
-}
+THUNK(Void_Float_Vector_Trace_Int, void, float, Vector, TraceResult *, int)
 
-cell Call_Str_Void(AMX *amx, cell *params)
+cell Call_Str_Void(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -570,7 +298,7 @@ cell Call_Str_Void(AMX *amx, cell *params)
 	return MF_SetAmxString(amx, params[3], v == NULL ? "" : v, *MF_GetAmxAddr(amx, params[4]));
 }
 
-cell Call_Cbase_Void(AMX *amx, cell *params)
+cell Call_Cbase_Void(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(0);
 #if defined(_WIN32)
@@ -581,7 +309,7 @@ cell Call_Cbase_Void(AMX *amx, cell *params)
 	return TypeConversion.cbase_to_id(ret);
 }
 
-cell Call_Float_Int(AMX *amx, cell *params)
+cell Call_Float_Int(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -597,7 +325,7 @@ cell Call_Float_Int(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Vector_Void(AMX *amx, cell *params)
+cell Call_Vector_Void(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 #if defined(_WIN32)
@@ -614,7 +342,7 @@ cell Call_Vector_Void(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Vector_pVector(AMX *amx, cell *params)
+cell Call_Vector_pVector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -642,7 +370,7 @@ cell Call_Vector_pVector(AMX *amx, cell *params)
 	return 1;
 } 
 
-cell Call_Int_pVector(AMX *amx, cell *params)
+cell Call_Int_pVector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 
@@ -665,7 +393,7 @@ cell Call_Int_pVector(AMX *amx, cell *params)
 	return ret;
 }
 
-cell Call_Bool_pVector(AMX *amx, cell *params)
+cell Call_Bool_pVector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 
@@ -688,28 +416,9 @@ cell Call_Bool_pVector(AMX *amx, cell *params)
 	return ret ? TRUE : FALSE;
 }
 
-cell Call_Void_Entvar_Float_Float(AMX *amx, cell *params)
-{
-	SETUP(3);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	float f4=amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-
-	CHECK_ENTITY(id3);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, entvars_t *, float, float)>(__func)(pv, 0, ev3, f4, f5);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, entvars_t *, float, float)>(__func)(pv, ev3, f4, f5);
-#endif
-
-	return 1;
-}
+THUNK(Void_Entvar_Float_Float, void, entvars_t *, float, float)
 
-cell Call_Void_pFloat_pFloat(AMX *amx, cell *params)
+cell Call_Void_pFloat_pFloat(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -721,48 +430,18 @@ cell Call_Void_pFloat_pFloat(AMX *amx, cell *params)
 #elif defined(__linux__) || defined(__APPLE__)
 	reinterpret_cast<void (*)(void *, float*, float*)>(__func)(pv, &f3, &f4);
 #endif
-
-	*MF_GetAmxAddr(amx, params[3]) = amx_ftoc(f3);
-	*MF_GetAmxAddr(amx, params[4]) = amx_ftoc(f4);
-
-	return 1;
-}
-
-cell Call_Void_Entvar_Float(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	float f4=amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-
-	CHECK_ENTITY(id3);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, entvars_t*, float)>(__func)(pv, 0, ev3, f4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, entvars_t*, float)>(__func)(pv, ev3, f4);
-#endif
-}
-
-cell Call_Void_Int_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(3);
-
-	int i3=*MF_GetAmxAddr(amx, params[3]);
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-	int i5=*MF_GetAmxAddr(amx, params[5]);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, int, int, int)>(__func)(pv, 0, i3, i4, i5);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, int, int, int)>(__func)(pv, i3, i4, i5);
-#endif
+
+	*MF_GetAmxAddr(amx, params[3]) = amx_ftoc(f3);
+	*MF_GetAmxAddr(amx, params[4]) = amx_ftoc(f4);
+
 	return 1;
 }
 
-cell Call_Int_ItemInfo(AMX *amx, cell *params)
+THUNK(Void_Entvar_Float, void, entvars_t *, float)
+
+THUNK(Void_Int_Int_Int, void, int, int, int)
+
+cell Call_Int_ItemInfo(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 
@@ -780,7 +459,7 @@ cell Call_Int_ItemInfo(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Bool_ItemInfo(AMX *amx, cell *params)
+cell Call_Bool_ItemInfo(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 
@@ -798,7 +477,7 @@ cell Call_Bool_ItemInfo(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Float_Void(AMX *amx, cell *params)
+cell Call_Float_Void(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 
@@ -812,7 +491,7 @@ cell Call_Float_Void(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Float_Int(AMX* amx, cell* params)
+cell Call_Void_Float_Int(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -828,7 +507,7 @@ cell Call_Void_Float_Int(AMX* amx, cell* params)
 	return 1;
 }
 
-cell Call_Float_Float_Cbase(AMX* amx, cell* params)
+cell Call_Float_Float_Cbase(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(3);
 
@@ -847,38 +526,11 @@ cell Call_Float_Float_Cbase(AMX* amx, cell* params)
 	return 1;
 }
 
-cell Call_Void_Float(AMX* amx, cell* params)
-{
-	SETUP(1);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, float)>(__func)(pv, 0, f3);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void*, float)>(__func)(pv, f3);
-#endif
-	return 1;
-}
-
-cell Call_Void_Float_Float_Float_Int(AMX* amx, cell* params)
-{
-	SETUP(4);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-	float f4=amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-	int i6=*MF_GetAmxAddr(amx, params[6]);
+THUNK(Void_Float, void, float)
 
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, float, float, float, int)>(__func)(pv, 0, f3, f4, f5, i6);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void*, float, float, float, int)>(__func)(pv, f3, f4, f5, i6);
-#endif
-	return 1;
-}
+THUNK(Void_Float_Float_Float_Int, void, float, float, float, int)
 
-cell Call_Vector_Float(AMX *amx, cell *params)
+cell Call_Vector_Float(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -898,96 +550,19 @@ cell Call_Vector_Float(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Float_Cbase(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3])); 
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-
-	CHECK_ENTITY(id4);
-
-	void *p4 = TypeConversion.id_to_cbase(id4);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, float, void *)>(__func)(pv, 0, f3, p4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, float, void *)>(__func)(pv, f3, p4);
-#endif
-
-	return 1;
-}
-
-cell Call_Int_Float_Float(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-	float f4=amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, float, float)>(__func)(pv, 0, f3, f4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, float, float)>(__func)(pv, f3, f4);
-#endif
-}
-
-cell Call_Int_Float(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, float)>(__func)(pv, 0, f3);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, float)>(__func)(pv, f3);
-#endif
-}
-
-cell Call_Int_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int i3=*MF_GetAmxAddr(amx, params[3]);
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, int, int)>(__func)(pv, 0, i3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, int, int)>(__func)(pv, i3, i4);
-#endif
-}
-
-cell Call_Bool_Bool_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
+THUNK(Void_Float_Cbase, void, float, HamCbase)
 
-	bool i3 = *MF_GetAmxAddr(amx, params[3]) != 0;
-	int i4 = *MF_GetAmxAddr(amx, params[4]);
+THUNK(Int_Float_Float, int, float, float)
 
-#if defined(_WIN32)
-	return reinterpret_cast<bool (__fastcall *)(void*, int, bool, int)>(__func)(pv, 0, i3, i4) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool (*)(void *, bool, int)>(__func)(pv, i3, i4) ? TRUE : FALSE;
-#endif
-}
+THUNK(Int_Float, int, float)
 
-cell Call_Int_Bool_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
+THUNK(Int_Int_Int, int, int, int)
 
-	bool i3 = *MF_GetAmxAddr(amx, params[3]) != 0;
-	int i4 = *MF_GetAmxAddr(amx, params[4]);
+THUNK(Bool_Bool_Int, bool, bool, int)
 
-#if defined(_WIN32)
-	return reinterpret_cast<int(__fastcall *)(void*, int, bool, int)>(__func)(pv, 0, i3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int(*)(void *, bool, int)>(__func)(pv, i3, i4);
-#endif
-}
+THUNK(Int_Bool_Int, int, bool, int)
 
-cell Call_Void_Str_Float_Float_Float(AMX *amx, cell *params)
+cell Call_Void_Str_Float_Float_Float(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(4);
 
@@ -1005,7 +580,7 @@ cell Call_Void_Str_Float_Float_Float(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Str_Float_Float_Float_Int_Cbase(AMX *amx, cell *params)
+cell Call_Void_Str_Float_Float_Float_Int_Cbase(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(6);
 
@@ -1029,7 +604,7 @@ cell Call_Void_Str_Float_Float_Float_Int_Cbase(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Str_Float_Float_Float_Bool_Cbase(AMX *amx, cell *params)
+cell Call_Void_Str_Float_Float_Float_Bool_Cbase(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(6);
 
@@ -1053,104 +628,15 @@ cell Call_Void_Str_Float_Float_Float_Bool_Cbase(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Int_Vector_Vector_Float_Float(AMX *amx, cell *params)
-{
-	SETUP(4);
-
-	Vector v3;
-	Vector v4;
-
-	float *fl3=(float *)MF_GetAmxAddr(amx, params[3]);
-	v3.x=fl3[0];
-	v3.y=fl3[1];
-	v3.z=fl3[2];
-
-	float *fl4=(float *)MF_GetAmxAddr(amx, params[4]);
-	v4.x=fl4[0];
-	v4.y=fl4[1];
-	v4.z=fl4[2];
-
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-	float f6=amx_ctof(*MF_GetAmxAddr(amx, params[6]));
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, Vector, Vector, float, float)>(__func)(pv, 0, v3, v4, f5, f6);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, Vector, Vector, float, float)>(__func)(pv, v3, v4, f5, f6);
-#endif
-}
-
-cell Call_Int_Short(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	short s3=*MF_GetAmxAddr(amx, params[3]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, short)>(__func)(pv, 0, s3);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, short)>(__func)(pv, s3);
-#endif
-}
-
-cell Call_Void_Entvar_Entvar_Float_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(5);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-	int i6=*MF_GetAmxAddr(amx, params[6]);
-	int i7=*MF_GetAmxAddr(amx, params[7]);
-
-	CHECK_ENTITY(id3);
-	CHECK_ENTITY(id4);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-	entvars_t *ev4 = TypeConversion.id_to_entvars(id4);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, entvars_t *, entvars_t *, float, int, int)>(__func)(pv, 0, ev3, ev4, f5, i6, i7);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, entvars_t *, entvars_t *, float, int, int)>(__func)(pv, ev3, ev4, f5, i6, i7);
-#endif
-
-	return 1;
-}
-
-cell Call_Void_Vector_Entvar_Entvar_Float_Int_Int(AMX *amx, cell *params)
-{
-	SETUP(6);
-
-	Vector v3;
-
-	float *fl3=(float *)MF_GetAmxAddr(amx, params[3]);
-	v3.x=fl3[0];
-	v3.y=fl3[1];
-	v3.z=fl3[2];
-
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	int id5=*MF_GetAmxAddr(amx, params[5]);
-	float f6=amx_ctof(*MF_GetAmxAddr(amx, params[6]));
-	int i7=*MF_GetAmxAddr(amx, params[7]);
-	int i8=*MF_GetAmxAddr(amx, params[8]);
-
-	CHECK_ENTITY(id4);
-	CHECK_ENTITY(id5);
+THUNK(Int_Vector_Vector_Float_Float, int, Vector, Vector, float, float)
 
-	entvars_t *ev4 = TypeConversion.id_to_entvars(id4);
-	entvars_t *ev5 = TypeConversion.id_to_entvars(id5);
+THUNK(Int_Short, int, short)
 
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, Vector, entvars_t *, entvars_t *, float, int, int)>(__func)(pv, 0, v3, ev4, ev5, f6, i7, i8);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, Vector, entvars_t *, entvars_t *, float, int, int)>(__func)(pv, v3, ev4, ev5, f6, i7, i8);
-#endif
+THUNK(Void_Entvar_Entvar_Float_Int_Int, void, entvars_t *, entvars_t *, float, int, int)
 
-	return 1;
-}
+THUNK(Void_Vector_Entvar_Entvar_Float_Int_Int, void, Vector, entvars_t *, entvars_t *, float, int, int)
 
-cell Call_Float_Int_Float(AMX *amx, cell *params)
+cell Call_Float_Int_Float(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(3);
 
@@ -1167,7 +653,7 @@ cell Call_Float_Int_Float(AMX *amx, cell *params)
 	return 1;	
 }
 
-cell Call_Int_Str(AMX *amx, cell *params)
+cell Call_Int_Str(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 
@@ -1180,25 +666,9 @@ cell Call_Int_Str(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Void_Edict(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
-
-	edict_t *ed3 = TypeConversion.id_to_edict(id3);
-
-#if defined(_WIN32)
-	reinterpret_cast<int (__fastcall *)(void*, int, edict_t *)>(__func)(pv, 0, ed3);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<int (*)(void *, edict_t *)>(__func)(pv, ed3);
-#endif
-
-	return 1;
-}
+THUNK(Void_Edict, void, edict_t *)
 
-cell Call_Void_Int_Str_Bool(AMX *amx, cell *params)
+cell Call_Void_Int_Str_Bool(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(4);
 
@@ -1217,33 +687,9 @@ cell Call_Void_Int_Str_Bool(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Vector_Vector(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	Vector v3;
-	Vector v4;
-
-	float *fl3=(float *)MF_GetAmxAddr(amx, params[3]);
-	v3.x=fl3[0];
-	v3.y=fl3[1];
-	v3.z=fl3[2];
-
-	float *fl4=(float *)MF_GetAmxAddr(amx, params[4]);
-	v4.x=fl4[0];
-	v4.y=fl4[1];
-	v4.z=fl4[2];
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, Vector, Vector)>(__func)(pv, 0, v3, v4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, Vector, Vector)>(__func)(pv, v3, v4);
-#endif
-
-	return 1;
-}
+THUNK(Void_Vector_Vector, void, Vector, Vector)
 
-cell Call_Void_Str_Bool(AMX *amx, cell *params)
+cell Call_Void_Str_Bool(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -1259,7 +705,7 @@ cell Call_Void_Str_Bool(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Int_Str_Str_Int_Str_Int_Int(AMX* amx, cell* params)
+cell Call_Int_Str_Str_Int_Str_Int_Int(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(6);
 
@@ -1272,104 +718,37 @@ cell Call_Int_Str_Str_Int_Str_Int_Int(AMX* amx, cell* params)
 	int i8=*MF_GetAmxAddr(amx, params[8]);
 
 #if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, const char *, const char *, int, const char *, int, int)>(__func)(pv, 0, sz3, sz4, i5, sz6, i7, i8);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, const char *, const char *, int, const char *, int, int)>(__func)(pv, sz3, sz4, i5, sz6, i7, i8);
-#endif
-}
-
-cell Call_Int_Int_Int_Float_Int(AMX* amx, cell* params)
-{
-	SETUP(4);
-
-	int i3=*MF_GetAmxAddr(amx, params[3]);
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-	int i6=*MF_GetAmxAddr(amx, params[6]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, int, int, float, int)>(__func)(pv, 0, i3, i4, f5, i6);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, int, int, float, int)>(__func)(pv, i3, i4, f5, i6);
-#endif
-}
-
-cell Call_Void_Str_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	char *sz3=MF_GetAmxString(amx, params[3], 0, NULL);
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, const char *, int)>(__func)(pv, 0, sz3, i4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, const char *, int)>(__func)(pv, sz3, i4);
-#endif
-
-	return 1;
-}
-
-cell Call_Bool_Cbase_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3 = *MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
-
-	void *p8 = TypeConversion.id_to_cbase(id3);
-
-	int i4 = *MF_GetAmxAddr(amx, params[4]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool(__fastcall *)(void*, int, void *, int)>(__func)(pv, 0, p8, i4) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool(*)(void *, void *, int)>(__func)(pv, p8, i4) ? TRUE : FALSE;
-#endif
-}
-
-cell Call_Void_Cbase_Int(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
-
-	void *p8 = TypeConversion.id_to_cbase(id3);
-
-	int i4=*MF_GetAmxAddr(amx, params[4]);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, void *, int)>(__func)(pv, 0, p8, i4);
+	return reinterpret_cast<int (__fastcall *)(void*, int, const char *, const char *, int, const char *, int, int)>(__func)(pv, 0, sz3, sz4, i5, sz6, i7, i8);
 #elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, void *, int)>(__func)(pv, p8, i4);
+	return reinterpret_cast<int (*)(void *, const char *, const char *, int, const char *, int, int)>(__func)(pv, sz3, sz4, i5, sz6, i7, i8);
 #endif
-
-	return 1;
 }
 
-cell Call_Void_Cbase_Int_Float(AMX *amx, cell *params)
-{
-	SETUP(3);
-
-	int id3 = *MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
+THUNK(Int_Int_Int_Float_Int, int, int, int, float, int)
 
-	void *p8 = TypeConversion.id_to_cbase(id3);
+cell Call_Void_Str_Int(AMX *amx, cell *params, void *pthis, void *func)
+{
+	SETUP(2);
 
-	int i4 = *MF_GetAmxAddr(amx, params[4]);
-	float f5 = amx_ctof(*MF_GetAmxAddr(amx, params[5]));
+	char *sz3=MF_GetAmxString(amx, params[3], 0, NULL);
+	int i4=*MF_GetAmxAddr(amx, params[4]);
 
 #if defined(_WIN32)
-	reinterpret_cast<void(__fastcall *)(void*, int, void *, int, float)>(__func)(pv, 0, p8, i4, f5);
+	reinterpret_cast<void (__fastcall *)(void*, int, const char *, int)>(__func)(pv, 0, sz3, i4);
 #elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void(*)(void *, void *, int, float)>(__func)(pv, p8, i4, f5);
+	reinterpret_cast<void (*)(void *, const char *, int)>(__func)(pv, sz3, i4);
 #endif
 
 	return 1;
 }
 
-cell Call_Void_Str(AMX *amx, cell *params)
+THUNK(Bool_Cbase_Int, bool, HamCbase, int)
+
+THUNK(Void_Cbase_Int, void, HamCbase, int)
+
+THUNK(Void_Cbase_Int_Float, void, HamCbase, int, float)
+
+cell Call_Void_Str(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(1);
 
@@ -1384,27 +763,9 @@ cell Call_Void_Str(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Vector(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	Vector v3;
-
-	float *fl3=(float *)MF_GetAmxAddr(amx, params[3]);
-	v3.x=fl3[0];
-	v3.y=fl3[1];
-	v3.z=fl3[2];
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, Vector)>(__func)(pv, 0, v3);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, Vector)>(__func)(pv, v3);
-#endif
-
-	return 1;
-}
+THUNK(Void_Vector, void, Vector)
 
-cell Call_Int_Str_Vector_Str(AMX* amx, cell* params)
+cell Call_Int_Str_Vector_Str(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(3);
 
@@ -1425,7 +786,7 @@ cell Call_Int_Str_Vector_Str(AMX* amx, cell* params)
 #endif
 }
 
-cell Call_Int_Str_Str(AMX* amx, cell* params)
+cell Call_Int_Str_Str(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -1439,23 +800,9 @@ cell Call_Int_Str_Str(AMX* amx, cell* params)
 #endif
 }
 
-cell Call_Void_Float_Float(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	float f3=amx_ctof(*MF_GetAmxAddr(amx, params[3]));
-	float f4=amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, float, float)>(__func)(pv, 0, f3, f4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, float, float)>(__func)(pv, f3, f4);
-#endif
-
-	return 1;
-}
+THUNK(Void_Float_Float, void, float, float)
 
-cell Call_Void_Str_Str_Int(AMX *amx, cell *params)
+cell Call_Void_Str_Str_Int(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(3);
 
@@ -1472,7 +819,7 @@ cell Call_Void_Str_Str_Int(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Int_pVector_pVector_Cbase_pFloat(AMX *amx, cell *params)
+cell Call_Int_pVector_pVector_Cbase_pFloat(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(4);
 
@@ -1515,7 +862,7 @@ cell Call_Int_pVector_pVector_Cbase_pFloat(AMX *amx, cell *params)
 	return ret;
 }
 
-cell Call_Void_Cbase_pVector_Float(AMX *amx, cell *params)
+cell Call_Void_Cbase_pVector_Float(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(3);
 
@@ -1545,7 +892,7 @@ cell Call_Void_Cbase_pVector_Float(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Int_pVector_pVector_Float_Cbase_pVector(AMX *amx, cell *params)
+cell Call_Int_pVector_pVector_Float_Cbase_pVector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(5);
 
@@ -1597,69 +944,13 @@ cell Call_Int_pVector_pVector_Float_Cbase_pVector(AMX *amx, cell *params)
 	return ret;
 }
 
-cell Call_Int_Cbase_Bool(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-
-	CHECK_ENTITY(id3);
-
-	void *pv1 = TypeConversion.id_to_cbase(id3);
-
-	bool b4= *MF_GetAmxAddr(amx, params[4]) != 0;
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void*, int, void *, bool)>(__func)(pv, 0, pv1, b4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, void *, bool)>(__func)(pv, pv1, b4);
-#endif
-}
-
-cell Call_Bool_Cbase_Bool(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3 = *MF_GetAmxAddr(amx, params[3]);
-
-	CHECK_ENTITY(id3);
-
-	void *pv1 = TypeConversion.id_to_cbase(id3);
-
-	bool b4 = *MF_GetAmxAddr(amx, params[4]) != 0;
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool(__fastcall *)(void*, int, void *, bool)>(__func)(pv, 0, pv1, b4) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool(*)(void *, void *, bool)>(__func)(pv, pv1, b4) ? TRUE : FALSE;
-#endif
-}
-
-cell Call_Int_Vector_Vector(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	Vector v3;
-	Vector v4;
-
-	float *fl3=(float *)MF_GetAmxAddr(amx, params[3]);
-	v3.x=fl3[0];
-	v3.y=fl3[1];
-	v3.z=fl3[2];
+THUNK(Int_Cbase_Bool, int, HamCbase, bool)
 
-	float *fl4=(float *)MF_GetAmxAddr(amx, params[4]);
-	v4.x=fl4[0];
-	v4.y=fl4[1];
-	v4.z=fl4[2];
+THUNK(Bool_Cbase_Bool, bool, HamCbase, bool)
 
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, Vector, Vector)>(__func)(pv, 0, v3, v4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, Vector, Vector)>(__func)(pv, v3, v4);
-#endif
-}
+THUNK(Int_Vector_Vector, int, Vector, Vector)
 
-cell Call_Int_pVector_pVector(AMX *amx, cell *params)
+cell Call_Int_pVector_pVector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -1683,7 +974,7 @@ cell Call_Int_pVector_pVector(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Bool_pVector_pVector(AMX *amx, cell *params)
+cell Call_Bool_pVector_pVector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -1707,45 +998,11 @@ cell Call_Bool_pVector_pVector(AMX *amx, cell *params)
 #endif
 }
 
-cell Call_Int_Entvar_Float(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-
-	CHECK_ENTITY(id3);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-
-	float f4=amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, entvars_t *, float)>(__func)(pv, 0, ev3, f4);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, entvars_t *, float)>(__func)(pv, ev3, f4);
-#endif
-}
-
-cell Call_Bool_Entvar_Float(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3 = *MF_GetAmxAddr(amx, params[3]);
-
-	CHECK_ENTITY(id3);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
+THUNK(Int_Entvar_Float, int, entvars_t *, float)
 
-	float f4 = amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool(__fastcall *)(void *, int, entvars_t *, float)>(__func)(pv, 0, ev3, f4) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool(*)(void *, entvars_t *, float)>(__func)(pv, ev3, f4) ? TRUE : FALSE;
-#endif
-}
+THUNK(Bool_Entvar_Float, bool, entvars_t *, float)
 
-cell Call_Float_Float(AMX *amx, cell *params)
+cell Call_Float_Float(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -1761,41 +1018,11 @@ cell Call_Float_Float(AMX *amx, cell *params)
 	return 1;
 }
 
-cell Call_Void_Entvar_Entvar_Float(AMX *amx, cell *params)
-{
-	SETUP(3);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	float f5=amx_ctof(*MF_GetAmxAddr(amx, params[5]));
-
-	CHECK_ENTITY(id3);
-	CHECK_ENTITY(id4);
-
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-	entvars_t *ev4 = TypeConversion.id_to_entvars(id4);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, entvars_t *, entvars_t *, float)>(__func)(pv, 0, ev3, ev4, f5);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, entvars_t *, entvars_t *, float)>(__func)(pv, ev3, ev4, f5);
-#endif
-
-	return 1;
-}
-
-cell Call_Bool_Void(AMX *amx, cell *params)
-{
-	SETUP(0);
+THUNK(Void_Entvar_Entvar_Float, void, entvars_t *, entvars_t *, float)
 
-#if defined(_WIN32)
-	return reinterpret_cast<bool (__fastcall *)(void*, int)>(__func)(pv, 0) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool (*)(void *)>(__func)(pv) ? TRUE : FALSE;
-#endif
-}
+THUNK(Bool_Void, bool)
 
-cell Call_Int_pVector_pVector_Float_Cbase_pVector_pVector_Bool(AMX *amx, cell *params)
+cell Call_Int_pVector_pVector_Float_Cbase_pVector_pVector_Bool(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(7);
 
@@ -1860,53 +1087,11 @@ cell Call_Int_pVector_pVector_Float_Cbase_pVector_pVector_Bool(AMX *amx, cell *p
 	return ret;
 }
 
-cell Call_Int_Vector_Cbase(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	Vector v3;
-	float *fl3=(float *)MF_GetAmxAddr(amx, params[3]);
-	v3.x=fl3[0];
-	v3.y=fl3[1];
-	v3.z=fl3[2];
-
-	int id4=*MF_GetAmxAddr(amx, params[4]);
-	CHECK_ENTITY(id4);
-	void *p4 = TypeConversion.id_to_cbase(id4);
-
-#if defined(_WIN32)
-	int ret=reinterpret_cast<int (__fastcall *)(void *, int, Vector, void*)>(__func)(pv, 0, v3, p4);
-#elif defined(__linux__) || defined(__APPLE__)
-	int ret=reinterpret_cast<int (*)(void *, Vector, void*)>(__func)(pv, v3, p4);
-#endif
-
-	fl3[0]=v3.x;
-	fl3[1]=v3.y;
-	fl3[2]=v3.z;
-
-	return ret;
-}
-
-cell Call_Int_Vector(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	Vector v3;
-	Vector v4;
-
-	float *fl3=(float *)MF_GetAmxAddr(amx, params[3]);
-	v3.x=fl3[0];
-	v3.y=fl3[1];
-	v3.z=fl3[2];
+THUNK(Int_Vector_Cbase, int, Vector, HamCbase)
 
-#if defined(_WIN32)
-	return reinterpret_cast<int (__fastcall *)(void *, int, Vector)>(__func)(pv, 0, v3);
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<int (*)(void *, Vector)>(__func)(pv, v3);
-#endif
-}
+THUNK(Int_Vector, int, Vector)
 
-cell Call_Int_Cbase_pVector(AMX *amx, cell *params)
+cell Call_Int_Cbase_pVector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(2);
 
@@ -1933,103 +1118,19 @@ cell Call_Int_Cbase_pVector(AMX *amx, cell *params)
 	return ret;
 }
 
-cell Call_Void_Bool(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	bool b3=*MF_GetAmxAddr(amx, params[3]) ? true : false;
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, bool)>(__func)(pv, 0, b3);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, bool)>(__func)(pv, b3);
-#endif
-
-	return 1;
-}
-
-cell Call_Bool_Cbase(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
-	void *pv1 = TypeConversion.id_to_cbase(id3);
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool (__fastcall *)(void*, int, void*)>(__func)(pv, 0, pv1) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool (*)(void *, void*)>(__func)(pv, pv1) ? TRUE : FALSE;
-#endif
-}
-
-cell Call_Bool_Int(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool (__fastcall *)(void*, int, int)>(__func)(pv, 0, id3) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool (*)(void *, int)>(__func)(pv, id3) ? TRUE : FALSE;
-#endif
-}
-
-cell Call_Bool_Entvar(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	int id3 = *MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
-	entvars_t *ev3 = TypeConversion.id_to_entvars(id3);
-
-#if defined(_WIN32)
-	return reinterpret_cast<bool(__fastcall *)(void*, int, void*)>(__func)(pv, 0, ev3) ? TRUE : FALSE;
-#elif defined(__linux__) || defined(__APPLE__)
-	return reinterpret_cast<bool(*)(void *, void*)>(__func)(pv, ev3) ? TRUE : FALSE;
-#endif
-}
-
-cell Call_Void_Cbase_Float(AMX *amx, cell *params)
-{
-	SETUP(2);
-
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
-
-	void *p8 = TypeConversion.id_to_cbase(id3);
-	float f4 = amx_ctof(*MF_GetAmxAddr(amx, params[4]));
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, void *, float)>(__func)(pv, 0, p8, f4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, void *, float)>(__func)(pv, p8, f4);
-#endif
-
-	return 1;
-}
+THUNK(Void_Bool, void, bool)
 
-cell Call_Void_Cbase_Bool(AMX *amx, cell *params)
-{
-	SETUP(2);
+THUNK(Bool_Cbase, bool, HamCbase)
 
-	int id3=*MF_GetAmxAddr(amx, params[3]);
-	CHECK_ENTITY(id3);
+THUNK(Bool_Int, bool, int)
 
-	void *p8 = TypeConversion.id_to_cbase(id3);
-	bool b4 = *MF_GetAmxAddr(amx, params[4]) != 0;
+THUNK(Bool_Entvar, bool, entvars_t *)
 
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void*, int, void *, bool)>(__func)(pv, 0, p8, b4);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, void *, bool)>(__func)(pv, p8, b4);
-#endif
+THUNK(Void_Cbase_Float, void, HamCbase, float)
 
-	return 1;
-}
+THUNK(Void_Cbase_Bool, void, HamCbase, bool)
 
-cell Call_Vector_Vector_Vector_Vector(AMX *amx, cell *params)
+cell Call_Vector_Vector_Vector_Vector(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(4);
 
@@ -2077,7 +1178,7 @@ cell Call_Vector_Vector_Vector_Vector(AMX *amx, cell *params)
 	return 1;
 } 
 
-cell Call_Str_Str(AMX *amx, cell *params)
+cell Call_Str_Str(AMX *amx, cell *params, void *pthis, void *func)
 {
 	SETUP(3);
 
@@ -2091,23 +1192,10 @@ cell Call_Str_Str(AMX *amx, cell *params)
 	return MF_SetAmxString(amx, params[4], v == NULL ? "" : v, *MF_GetAmxAddr(amx, params[5]));
 }
 
-cell Call_Void_Short(AMX *amx, cell *params)
-{
-	SETUP(1);
-
-	short i3=*MF_GetAmxAddr(amx, params[3]);
-
-#if defined(_WIN32)
-	reinterpret_cast<void (__fastcall *)(void *, int, short)>(__func)(pv, 0, i3);
-#elif defined(__linux__) || defined(__APPLE__)
-	reinterpret_cast<void (*)(void *, short)>(__func)(pv, i3);
-#endif
-
-	return 1;
-}
+THUNK(Void_Short, void, short)
 
 
-cell Call_Deprecated(AMX *amx, cell *params)
+cell Call_Deprecated(AMX *amx, cell *params, void *pthis, void *func)
 {
 	MF_LogError(amx, AMX_ERR_NATIVE, "Ham function is deprecated.");
 
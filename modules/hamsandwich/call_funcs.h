@@ -14,210 +14,217 @@
 #ifndef HOOK_Call_H
 #define HOOK_Call_H
 
+// Calls function params[1] on entity params[2], through its hook's forwards if
+// any would run and forwards is set, or the original function otherwise.
+// The function id must already be checked.
+cell ExecuteHamCall(AMX *amx, cell *params, bool forwards);
 
-cell Call_Void_Void(AMX *amx, cell *params);
+// Forgets the resolved calls, must be done whenever hooks are freed
+void ClearCallCache();
 
-cell Call_Int_Void(AMX *amx, cell *params);
+cell Call_Void_Void(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar(AMX *amx, cell *params);
+cell Call_Int_Void(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Cbase(AMX *amx, cell *params);
+cell Call_Void_Entvar(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Float_Int(AMX *amx, cell *params);
+cell Call_Void_Cbase(AMX *amx, cell *params, void *pthis, void *func);
+
+cell Call_Int_Float_Int(AMX *amx, cell *params, void *pthis, void *func);
 	
-cell Call_Int_Float_Int_Int(AMX *amx, cell *params);
+cell Call_Int_Float_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Float_Int_Int(AMX *amx, cell *params);
+cell Call_Bool_Float_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar_Int(AMX *amx, cell *params);
+cell Call_Void_Entvar_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar_Entvar_Int(AMX *amx, cell *params);
+cell Call_Void_Entvar_Entvar_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Cbase(AMX *amx, cell *params);
+cell Call_Int_Cbase(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Int_Int(AMX *amx, cell *params);
+cell Call_Void_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Int_Bool(AMX *amx, cell *params);
+cell Call_Void_Int_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Bool_Bool(AMX *amx, cell *params);
+cell Call_Void_Bool_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Int_Str_Int(AMX *amx, cell *params);
+cell Call_Int_Int_Str_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Int_Str_Int_Int(AMX *amx, cell *params);
+cell Call_Int_Int_Str_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Int_Str_Int_Bool(AMX *amx, cell *params);
+cell Call_Int_Int_Str_Int_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Int(AMX *amx, cell *params);
+cell Call_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 	
-cell Call_Bool_Bool(AMX *amx, cell *params);
+cell Call_Bool_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Entvar(AMX *amx, cell *params);
+cell Call_Int_Entvar(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Entvar_Entvar_Float_Int(AMX *amx, cell *params);
+cell Call_Int_Entvar_Entvar_Float_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Entvar_Entvar_Float_Float_Int(AMX *amx, cell *params);
+cell Call_Int_Entvar_Entvar_Float_Float_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Int(AMX *amx, cell *params);
+cell Call_Void_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Vector_Float_Cbase_Int(AMX *amx, cell *params);
+cell Call_Vector_Float_Cbase_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Cbase_Cbase_Int_Float(AMX *amx, cell *params);
+cell Call_Void_Cbase_Cbase_Int_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar_Float_Vector_Trace_Int(AMX *amx, cell *params);
+cell Call_Void_Entvar_Float_Vector_Trace_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Float_Vector_Trace_Int(AMX *amx, cell *params);
+cell Call_Void_Float_Vector_Trace_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Str_Void(AMX *amx, cell *params);
+cell Call_Str_Void(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Cbase_Void(AMX *amx, cell *params);
+cell Call_Cbase_Void(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Vector_Void(AMX *amx, cell *params);
+cell Call_Vector_Void(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Vector_pVector(AMX *amx, cell *params);
+cell Call_Vector_pVector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_pVector(AMX *amx, cell *params);
+cell Call_Int_pVector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_pVector(AMX *amx, cell *params);
+cell Call_Bool_pVector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar_Float_Float(AMX *amx, cell *params);
+cell Call_Void_Entvar_Float_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_pFloat_pFloat(AMX *amx, cell *params);
+cell Call_Void_pFloat_pFloat(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar_Float(AMX *amx, cell *params);
+cell Call_Void_Entvar_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Int_Int_Int(AMX *amx, cell *params);
+cell Call_Void_Int_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_ItemInfo(AMX *amx, cell *params);
+cell Call_Int_ItemInfo(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_ItemInfo(AMX *amx, cell *params);
+cell Call_Bool_ItemInfo(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Float_Void(AMX *amx, cell *params);
+cell Call_Float_Void(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Float_Int(AMX* amx, cell* params);
+cell Call_Void_Float_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Float_Float_Cbase(AMX* amx, cell* params);
+cell Call_Float_Float_Cbase(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Float(AMX* amx, cell* params);
+cell Call_Void_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Float_Float_Float_Int(AMX* amx, cell* params);
+cell Call_Void_Float_Float_Float_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Float_Int(AMX* amx, cell* params);
+cell Call_Float_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Vector_Float(AMX* amx, cell* params);
+cell Call_Vector_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Float_Cbase(AMX *amx, cell *params);
+cell Call_Void_Float_Cbase(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Float_Float(AMX *amx, cell *params);
+cell Call_Int_Float_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Float(AMX *amx, cell *params);
+cell Call_Int_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Int_Int(AMX *amx, cell *params);
+cell Call_Int_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Bool_Int(AMX *amx, cell *params);
+cell Call_Bool_Bool_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Str_Float_Float_Float(AMX *amx, cell *params);
+cell Call_Void_Str_Float_Float_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Str_Float_Float_Float_Int_Cbase(AMX *amx, cell *params);
+cell Call_Void_Str_Float_Float_Float_Int_Cbase(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Str_Float_Float_Float_Bool_Cbase(AMX *amx, cell *params);
+cell Call_Void_Str_Float_Float_Float_Bool_Cbase(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Vector_Vector_Float_Float(AMX *amx, cell *params);
+cell Call_Int_Vector_Vector_Float_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Short(AMX *amx, cell *params);
+cell Call_Int_Short(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar_Entvar_Float_Int_Int(AMX *amx, cell *params);
+cell Call_Void_Entvar_Entvar_Float_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Vector_Entvar_Entvar_Float_Int_Int(AMX *amx, cell *params);
+cell Call_Void_Vector_Entvar_Entvar_Float_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Float_Int_Float(AMX* amx, cell* params);
+cell Call_Float_Int_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Str(AMX* amx, cell* params);
+cell Call_Int_Str(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Edict(AMX* amx, cell* params);
+cell Call_Void_Edict(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Int_Str_Bool(AMX* amx, cell* params);
+cell Call_Void_Int_Str_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Vector_Vector(AMX* amx, cell* params);
+cell Call_Void_Vector_Vector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Str_Bool(AMX* amx, cell* params);
+cell Call_Void_Str_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Str_Str_Int_Str_Int_Int(AMX* amx, cell* params);
+cell Call_Int_Str_Str_Int_Str_Int_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Int_Int_Float_Int(AMX* amx, cell* params);
+cell Call_Int_Int_Int_Float_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Str_Int(AMX* amx, cell* params);
+cell Call_Void_Str_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Cbase_Int(AMX* amx, cell* params);
+cell Call_Bool_Cbase_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Cbase_Int(AMX* amx, cell* params);
+cell Call_Void_Cbase_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Cbase_Int_Float(AMX* amx, cell* params);
+cell Call_Void_Cbase_Int_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Str(AMX* amx, cell* params);
+cell Call_Void_Str(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Vector(AMX* amx, cell* params);
+cell Call_Void_Vector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Str_Vector_Str(AMX* amx, cell* params);
+cell Call_Int_Str_Vector_Str(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Str_Str(AMX* amx, cell* params);
+cell Call_Int_Str_Str(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Float_Float(AMX* amx, cell* params);
+cell Call_Void_Float_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Str_Str_Int(AMX* amx, cell* params);
+cell Call_Void_Str_Str_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_pVector_pVector_Cbase_pFloat(AMX* amx, cell* params);
+cell Call_Int_pVector_pVector_Cbase_pFloat(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Cbase_pVector_Float(AMX* amx, cell* params);
+cell Call_Void_Cbase_pVector_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_pVector_pVector_Float_Cbase_pVector(AMX* amx, cell* params);
+cell Call_Int_pVector_pVector_Float_Cbase_pVector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Cbase_Bool(AMX* amx, cell* params);
+cell Call_Int_Cbase_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Cbase_Bool(AMX* amx, cell* params);
+cell Call_Bool_Cbase_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Vector_Vector(AMX *amx, cell *params);
+cell Call_Int_Vector_Vector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_pVector_pVector(AMX *amx, cell *params);
+cell Call_Int_pVector_pVector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_pVector_pVector(AMX *amx, cell *params);
+cell Call_Bool_pVector_pVector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Entvar_Float(AMX *amx, cell *params);
+cell Call_Int_Entvar_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Entvar_Float(AMX *amx, cell *params);
+cell Call_Bool_Entvar_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Float_Float(AMX* amx, cell* params);
+cell Call_Float_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Entvar_Entvar_Float(AMX *amx, cell *params);
+cell Call_Void_Entvar_Entvar_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Void(AMX *amx, cell *params);
+cell Call_Bool_Void(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_pVector_pVector_Float_Cbase_pVector_pVector_Bool(AMX* amx, cell* params);
+cell Call_Int_pVector_pVector_Float_Cbase_pVector_pVector_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Vector_Cbase(AMX *amx, cell *params);
+cell Call_Int_Vector_Cbase(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Vector(AMX *amx, cell *params);
+cell Call_Int_Vector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Int_Cbase_pVector(AMX *amx, cell *params);
+cell Call_Int_Cbase_pVector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Bool(AMX *amx, cell *params);
+cell Call_Void_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Cbase(AMX *amx, cell *params);
+cell Call_Bool_Cbase(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Entvar(AMX *amx, cell *params);
+cell Call_Bool_Entvar(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Bool_Int(AMX *amx, cell *params);
+cell Call_Bool_Int(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Cbase_Float(AMX* amx, cell* params);
+cell Call_Void_Cbase_Float(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Cbase_Bool(AMX* amx, cell* params);
+cell Call_Void_Cbase_Bool(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Vector_Vector_Vector_Vector(AMX *amx, cell *params);
+cell Call_Vector_Vector_Vector_Vector(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Str_Str(AMX *amx, cell *params);
+cell Call_Str_Str(AMX *amx, cell *params, void *pthis, void *func);
 
-cell Call_Void_Short(AMX *amx, cell *params);
+cell Call_Void_Short(AMX *amx, cell *params, void *pthis, void *func);
 
 
-cell Call_Deprecated(AMX* amx, cell* params);
+cell Call_Deprecated(AMX *amx, cell *params, void *pthis, void *func);
 
 #endif
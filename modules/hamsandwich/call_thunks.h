@@ -0,0 +1,283 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+//
+// Ham Sandwich Module
+//
+
+#ifndef CALL_THUNKS_H
+#define CALL_THUNKS_H
+
+#include "amxxmodule.h"
+#include "ham_utils.h"
+
+// Typed thunks for ExecuteHam[B], the parameter conversions of a signature being
+// generated at compile time from its types. Signatures with string or by reference
+// parameters, or with a return value written back to the plugin, are still written
+// out by hand in call_funcs.cpp.
+
+// CBaseEntity parameter, passed as void * like the hand written calls do
+struct HamCbase {};
+
+// Reads one ExecuteHam parameter, passed by reference, into its C++ type
+template <typename T>
+struct HamParam;
+
+template <>
+struct HamParam<int>
+{
+	typedef int Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		out = *MF_GetAmxAddr(amx, param);
+		return true;
+	}
+};
+
+template <>
+struct HamParam<short>
+{
+	typedef short Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		out = static_cast<short>(*MF_GetAmxAddr(amx, param));
+		return true;
+	}
+};
+
+template <>
+struct HamParam<bool>
+{
+	typedef bool Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		out = *MF_GetAmxAddr(amx, param) != 0;
+		return true;
+	}
+};
+
+template <>
+struct HamParam<float>
+{
+	typedef float Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		out = amx_ctof(*MF_GetAmxAddr(amx, param));
+		return true;
+	}
+};
+
+template <>
+struct HamParam<Vector>
+{
+	typedef Vector Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		float *fl = (float *)MF_GetAmxAddr(amx, param);
+
+		out.x = fl[0];
+		out.y = fl[1];
+		out.z = fl[2];
+
+		return true;
+	}
+};
+
+template <>
+struct HamParam<TraceResult *>
+{
+	typedef TraceResult *Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		out = reinterpret_cast<TraceResult *>(*MF_GetAmxAddr(amx, param));
+
+		if (out == NULL)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Null traceresult provided.");
+			return false;
+		}
+
+		return true;
+	}
+};
+
+// Entities are checked as CHECK_ENTITY() does
+inline bool HamReadEntity(AMX *amx, cell param, int &id)
+{
+	id = *MF_GetAmxAddr(amx, param);
+
+	if (id < 0 || id > gpGlobals->maxEntities)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Entity out of range (%d)", id);
+		return false;
+	}
+
+	edict_t *ent = TypeConversion.id_to_edict(id);
+
+	if (ent->free)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid entity (%d)", id);
+		return false;
+	}
+
+	if (ent->pvPrivateData == NULL)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Entity has null private data (%d)", id);
+		return false;
+	}
+
+	return true;
+}
+
+template <>
+struct HamParam<entvars_t *>
+{
+	typedef entvars_t *Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		int id;
+
+		if (!HamReadEntity(amx, param, id))
+		{
+			return false;
+		}
+
+		out = TypeConversion.id_to_entvars(id);
+		return true;
+	}
+};
+
+template <>
+struct HamParam<edict_t *>
+{
+	typedef edict_t *Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		int id;
+
+		if (!HamReadEntity(amx, param, id))
+		{
+			return false;
+		}
+
+		out = TypeConversion.id_to_edict(id);
+		return true;
+	}
+};
+
+template <>
+struct HamParam<HamCbase>
+{
+	typedef void *Type;
+
+	static inline bool Read(AMX *amx, cell param, Type &out)
+	{
+		int id;
+
+		if (!HamReadEntity(amx, param, id))
+		{
+			return false;
+		}
+
+		out = TypeConversion.id_to_cbase(id);
+		return true;
+	}
+};
+
+template <typename Ret, typename... Args>
+inline Ret HamInvoke(void *func, void *pthis, Args... args)
+{
+#if defined(_WIN32)
+	return reinterpret_cast<Ret (__fastcall *)(void *, int, Args...)>(func)(pthis, 0, args...);
+#elif defined(__linux__) || defined(__APPLE__)
+	return reinterpret_cast<Ret (*)(void *, Args...)>(func)(pthis, args...);
+#endif
+}
+
+// Makes the call and converts what it returns to the native's result
+template <typename Ret>
+struct HamReturn
+{
+	template <typename... Args>
+	static inline cell Call(void *func, void *pthis, Args... args)
+	{
+		return static_cast<cell>(HamInvoke<Ret>(func, pthis, args...));
+	}
+};
+
+template <>
+struct HamReturn<bool>
+{
+	template <typename... Args>
+	static inline cell Call(void *func, void *pthis, Args... args)
+	{
+		return HamInvoke<bool>(func, pthis, args...) ? TRUE : FALSE;
+	}
+};
+
+template <>
+struct HamReturn<void>
+{
+	template <typename... Args>
+	static inline cell Call(void *func, void *pthis, Args... args)
+	{
+		HamInvoke<void>(func, pthis, args...);
+		return 1;
+	}
+};
+
+template <typename... Types>
+struct HamTypes {};
+
+template <typename Ret, typename... Args>
+class HamThunk
+{
+public:
+	static cell Call(AMX *amx, cell *params, void *pthis, void *func)
+	{
+		if ((sizeof...(Args) + 2) * sizeof(cell) > static_cast<unsigned>(params[0]))
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Bad arg count.  Expected %d, got %d.", static_cast<int>(sizeof...(Args) + 2), static_cast<int>(params[0] / sizeof(cell)));
+			return 0;
+		}
+
+		return Convert(HamTypes<Args...>(), amx, params + 3, pthis, func);
+	}
+
+private:
+	// Converts the parameters one at a time, then calls with all of them
+	template <typename Next, typename... Left, typename... Done>
+	static inline cell Convert(HamTypes<Next, Left...>, AMX *amx, cell *params, void *pthis, void *func, Done... done)
+	{
+		typename HamParam<Next>::Type value;
+
+		if (!HamParam<Next>::Read(amx, *params, value))
+		{
+			return 0;
+		}
+
+		return Convert(HamTypes<Left...>(), amx, params + 1, pthis, func, done..., value);
+	}
+
+	template <typename... Done>
+	static inline cell Convert(HamTypes<>, AMX *, cell *, void *pthis, void *func, Done... done)
+	{
+		return HamReturn<Ret>::Call(func, pthis, done...);
+	}
+};
+
+#endif // CALL_THUNKS_H
@@ -12,6 +12,7 @@
 #include "hooklist.h"
 #include "DataHandler.h"
 #include "forward.h"
+#include "call_funcs.h"
 #include "ham_const.h"
 #include <string.h>
 #include <amtl/am-vector.h>
@@ -19,7 +20,6 @@ using namespace ke;
 // 外部变量声明
 extern ke::Vector<Hook*> hooks[HAM_LAST_ENTRY_DONT_USE_ME_LOL];
 extern hook_t hooklist[];
-extern bool gDoForwards;
 
 //
 //// 全局变量定义
@@ -149,20 +149,13 @@ CSHARP_EXPORT int CALLING_CONVENTION Csharp_ExecuteHamHook(int hamId, int entity
     if (!hookInfo || !hookInfo->isset)
         return 0;
 
-    // 启用前向回调，这样AMXX插件的Ham钩子会被触发
-    gDoForwards = true;
-    
     cell amxParams[16];
     amxParams[0] = 2 * sizeof(cell);
     amxParams[1] = hamId;
     amxParams[2] = entity;
     
     // 执行Ham函数，这会触发所有AMXX的RegisterHam回调
-    cell result = hooklist[hamId].call(nullptr, amxParams);
-    
-    gDoForwards = false;
-    
-    return result;
+    return ExecuteHamCall(nullptr, amxParams, true);
 }
 
 CSHARP_EXPORT int CALLING_CONVENTION Csharp_ExecuteHamHookDirect(int hamId, int entity, void* params)
@@ -178,15 +171,13 @@ CSHARP_EXPORT int CALLING_CONVENTION Csharp_ExecuteHamHookDirect(int hamId, int
     if (!hookInfo || !hookInfo->isset)
         return 0;
 
-    // 不触发前向回调，只执行原生函数
-    gDoForwards = false;
-    
     cell amxParams[16];
     amxParams[0] = 2 * sizeof(cell);
     amxParams[1] = hamId;
     amxParams[2] = entity;
     
-    return hooklist[hamId].call(nullptr, amxParams);
+    // 不触发前向回调，只执行原生函数
+    return ExecuteHamCall(nullptr, amxParams, false);
 }
 
 CSHARP_EXPORT int CALLING_CONVENTION Csharp_IsHamHookValid(int hamId, int entity)
@@ -17,6 +17,7 @@
 #define FORWARD_H
 
 #include <amtl/am-refcounting.h>
+#include <amtl/am-vector.h>
 
 enum fwdstate
 {
@@ -32,11 +33,18 @@ class Forward :public ke::Refcounted<Forward>
 public:
 	int      id;    // id of the forward
 	fwdstate state;
-	Forward(int id_) : id(id_), state(FSTATE_OK)
+
+	// Entity filter, set from EnableHamForwardFor/DisableHamForwardFor.
+	// Unfiltered forwards are called for every entity of the hooked class.
+	bool                 filtered;
+	bool                 others;    // whether entities past the end of the bitset are enabled
+	ke::Vector<uint32_t> entities;  // a bit per entity index
+
+	Forward(int id_) : id(id_), state(FSTATE_OK), filtered(false), others(true)
 	{
 		/* do nothing */
 	};
-	Forward() : id(-1), state(FSTATE_INVALID)
+	Forward() : id(-1), state(FSTATE_INVALID), filtered(false), others(true)
 	{
 		/* do nothing */
 	}
@@ -50,6 +58,59 @@ public:
 		id=i;
 	};
 
+	inline bool IsEnabledFor(int entity) const
+	{
+		if (!filtered)
+		{
+			return true;
+		}
+
+		size_t word = static_cast<size_t>(entity) >> 5;
+
+		if (word >= entities.length())
+		{
+			return others;
+		}
+
+		return (entities[word] & (1u << (entity & 31))) != 0;
+	}
+
+	// Entity -1 stands for all of them
+	void SetEnabledFor(int entity, bool enable)
+	{
+		if (entity < 0)
+		{
+			// Everything enabled is the same as no filter at all
+			filtered = !enable;
+			others = enable;
+			entities.clear();
+			return;
+		}
+
+		if (!filtered)
+		{
+			// Enabling an entity restricts the forward to it, disabling one keeps the others
+			filtered = true;
+			others = !enable;
+			entities.clear();
+		}
+
+		size_t word = static_cast<size_t>(entity) >> 5;
+
+		while (entities.length() <= word)
+		{
+			entities.append(others ? ~0u : 0u);
+		}
+
+		if (enable)
+		{
+			entities[word] |= 1u << (entity & 31);
+		}
+		else
+		{
+			entities[word] &= ~(1u << (entity & 31));
+		}
+	}
 };
 
 #endif
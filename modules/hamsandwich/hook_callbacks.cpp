@@ -84,7 +84,7 @@ extern bool gDoForwards;
 	{																			\
 		for (size_t i = 0; i < hook->pre.length(); ++i)							\
 		{																		\
-			if (hook->pre.at(i)->state == FSTATE_OK)							\
+			if (hook->pre.at(i)->state == FSTATE_OK && hook->pre.at(i)->IsEnabledFor(iThis))							\
 			{																	\
 				thisresult = MF_ExecuteForward(hook->pre.at(i)->id, iThis
 
@@ -106,7 +106,7 @@ extern bool gDoForwards;
 	{																		\
 		for (size_t i = 0; i < hook->post.length(); ++i)					\
 		{																	\
-			if (hook->post.at(i)->state == FSTATE_OK)						\
+			if (hook->post.at(i)->state == FSTATE_OK && hook->post.at(i)->IsEnabledFor(iThis))						\
 			{																\
 					thisresult = MF_ExecuteForward(hook->post.at(i)->id, iThis
 
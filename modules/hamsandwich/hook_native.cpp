@@ -799,18 +799,15 @@ static cell AMX_NATIVE_CALL ExecuteHam(AMX *amx, cell *params)
 
 	CHECK_FUNCTION(func);
 
-	gDoForwards=false;
-	return hooklist[func].call(amx, params);
+	return ExecuteHamCall(amx, params, false);
 }
 static cell AMX_NATIVE_CALL ExecuteHamB(AMX *amx, cell *params)
 {
 	int func=params[1];
 	CHECK_FUNCTION(func);
 
-	gDoForwards=true;
-	
 	// 执行原有逻辑
-	cell result = hooklist[func].call(amx, params);
+	cell result = ExecuteHamCall(amx, params, true);
 	
 	// 如果有C#回调，也要触发
 	if (g_CsharpBridge.csharpGlobalCallback)
@@ -879,6 +876,35 @@ static cell AMX_NATIVE_CALL EnableHamForward(AMX *amx, cell *params)
 	fwd->state=FSTATE_OK;
 	return 0;
 }
+static cell SetHamForwardFor(AMX *amx, cell *params, bool enable)
+{
+	Forward *fwd=reinterpret_cast<Forward *>(params[1]);
+
+	if (fwd == 0)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid HamHook handle.");
+		return -1;
+	}
+
+	int entity = params[2];
+
+	if (entity < -1 || entity > gpGlobals->maxEntities)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Entity out of range (%d)", entity);
+		return -1;
+	}
+
+	fwd->SetEnabledFor(entity, enable);
+	return 0;
+}
+static cell AMX_NATIVE_CALL DisableHamForwardFor(AMX *amx, cell *params)
+{
+	return SetHamForwardFor(amx, params, false);
+}
+static cell AMX_NATIVE_CALL EnableHamForwardFor(AMX *amx, cell *params)
+{
+	return SetHamForwardFor(amx, params, true);
+}
 AMX_NATIVE_INFO RegisterNatives[] =
 {
 	{ "RegisterHam",			RegisterHam },
@@ -888,6 +914,8 @@ AMX_NATIVE_INFO RegisterNatives[] =
 	{ "IsHamValid",				IsHamValid },
 	{ "DisableHamForward",		DisableHamForward },
 	{ "EnableHamForward",		EnableHamForward },
+	{ "DisableHamForwardFor",	DisableHamForwardFor },
+	{ "EnableHamForwardFor",	EnableHamForwardFor },
 
 	{ NULL,						NULL }
 };
@@ -25,7 +25,7 @@ typedef struct hook_s
 	int  paramcount;						// how many parameters are in the func
 	void *targetfunc;						// the target hook
 	int (*makefunc)(AMX *, const char*);	// function that creates forwards
-	cell (*call)(AMX *, cell*);				// function to call the vcall
+	cell (*call)(AMX *, cell*, void *, void *);	// function to call the vcall
 } hook_t;
 
 extern hook_t hooklist[];
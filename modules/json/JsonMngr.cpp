@@ -12,6 +12,7 @@
 //
 
 #include "JsonMngr.h"
+#include <platform_helpers.h>
 
 JSONMngr::~JSONMngr()
 {
@@ -70,10 +71,22 @@ JS_Handle JSONMngr::_MakeHandle(void *value, JSONHandleType type, bool must_be_f
 	}
 
 	m_Handles[id]->m_bMustBeFreed = must_be_freed;
+	m_Handles[id]->m_Owner = HandleStats ? HandleStats->GetCallingPlugin() : -1;
 
 	return id;
 }
 
+void JSONMngr::ReportHandles(IHandleReport *report)
+{
+	for (auto &i : m_Handles)
+	{
+		if (i)
+		{
+			report->AddHandle("JSON", i->m_Owner, 0);
+		}
+	}
+}
+
 void JSONMngr::_FreeHandle(ke::AutoPtr<JSONHandle> &ptr)
 {
 	if (ptr->m_bMustBeFreed && ptr->m_pValue)
@@ -450,11 +463,41 @@ bool JSONMngr::SerialToBuffer(JS_Handle value, char *buffer, size_t size, bool p
 
 bool JSONMngr::SerialToFile(JS_Handle value, const char *filepath, bool pretty)
 {
-	auto JSValue = m_Handles[value]->m_pValue;
-	auto JSResult = (!pretty) ? json_serialize_to_file(JSValue, filepath) :
-					json_serialize_to_file_pretty(JSValue, filepath);
+	// Streamed through a fixed buffer rather than serialised to memory first, into
+	// a temporary file so a failure leaves the existing one untouched
+	char temppath[PLATFORM_MAX_PATH];
+	ke::SafeSprintf(temppath, sizeof(temppath), "%s.tmp", filepath);
 
-	return JSResult == JSONSuccess;
+	auto fp = fopen(temppath, "w");
+	if (!fp)
+	{
+		return false;
+	}
+
+	bool result;
+
+	{
+		// The writer closes the file on destruction if it failed before Close()
+		auto writer = ke::MakeUnique<JSONWriter>(fp, pretty);
+
+		result = writer->Value(m_Handles[value]->m_pValue) && writer->Close();
+	}
+
+	if (result)
+	{
+#if defined PLATFORM_WINDOWS
+		result = MoveFileExA(temppath, filepath, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+		result = rename(temppath, filepath) == 0;
+#endif
+	}
+
+	if (!result)
+	{
+		remove(temppath);
+	}
+
+	return result;
 }
 
 char *JSONMngr::SerialToString(JS_Handle value, bool pretty)
@@ -18,7 +18,9 @@
 #include <amtl/am-uniqueptr.h>
 #include <amtl/am-deque.h>
 
+#include <IHandleStats.h>
 #include "IJsonMngr.h"
+#include "JsonStream.h"
 
 using namespace AMXX;
 
@@ -176,6 +178,29 @@ class JSONMngr : public IJSONMngr
 		json_free_serialized_string(string);
 	}
 
+	// Streaming
+	inline bool WriteValue(JS_Handle value, JSONWriter *writer)
+	{
+		return writer->Value(m_Handles[value]->m_pValue);
+	}
+
+	// Bulk conversions
+	inline JSON_Array *GetJSONArray(JS_Handle array)
+	{
+		return m_Handles[array]->m_pArray;
+	}
+	inline JSON_Object *GetJSONObject(JS_Handle object)
+	{
+		return m_Handles[object]->m_pObject;
+	}
+	inline JS_Handle AdoptArray(JSON_Array *array)
+	{
+		return _MakeHandle(array, Handle_Array, true);
+	}
+
+	// Handle accounting
+	void ReportHandles(IHandleReport *report);
+
 	private:
 
 	struct JSONHandle
@@ -184,6 +209,7 @@ class JSONMngr : public IJSONMngr
 		JSON_Array  *m_pArray;          //Store an pointer to an array
 		JSON_Object *m_pObject;         //Store an pointer to an object
 		bool         m_bMustBeFreed;    //Must be freed using json_value_free()?
+		int          m_Owner;           //Plugin which created the handle
 	};
 
 	JS_Handle _MakeHandle(void *value, JSONHandleType type, bool must_be_freed = false);
@@ -194,3 +220,4 @@ class JSONMngr : public IJSONMngr
 };
 
 extern ke::UniquePtr<JSONMngr> JsonMngr;
+extern IHandleStats *HandleStats;
@@ -12,8 +12,46 @@
 //
 
 #include "JsonMngr.h"
+#include <IDataStructs.h>
+#include <math.h>
 
 ke::UniquePtr<JSONMngr> JsonMngr;
+IDataStructManager *DataStructs;
+IHandleStats *HandleStats;
+
+enum JSONReaderAction
+{
+	ReaderAction_Continue,
+	ReaderAction_Skip,
+	ReaderAction_Stop
+};
+
+enum JSONReaderStatus
+{
+	ReaderStatus_Error = -1,
+	ReaderStatus_Finished,
+	ReaderStatus_Paused,
+	ReaderStatus_Stopped
+};
+
+struct JSONReaderHandle
+{
+	JSONReaderHandle(FILE *fp, const char *filter, int forward, cell data) : reader(fp, filter), forward(forward), data(data), reading(false)
+	{
+	}
+	~JSONReaderHandle()
+	{
+		MF_UnregisterSPForward(forward);
+	}
+
+	JSONReader reader;
+	int        forward;
+	cell       data;
+	bool       reading;
+};
+
+JSONStreamHandles<JSONReaderHandle> JsonReaders;
+JSONStreamHandles<JSONWriter> JsonWriters;
 
 //native JSON:json_parse(const string[], bool:is_file = false, bool:with_comments = false);
 static cell AMX_NATIVE_CALL amxx_json_parse(AMX *amx, cell *params)
@@ -871,6 +909,802 @@ static cell AMX_NATIVE_CALL amxx_json_serial_to_file(AMX *amx, cell *params)
 	return JsonMngr->SerialToFile(value, path, params[3] != 0);
 }
 
+//native JSONReader:json_reader_open(const file[], const handler[], const filter[] = "", any:data = 0);
+static cell AMX_NATIVE_CALL amxx_json_reader_open(AMX *amx, cell *params)
+{
+	int len;
+	auto handler = MF_GetAmxString(amx, params[2], 0, &len);
+	auto forward = MF_RegisterSPForwardByName(amx, handler, FP_CELL, FP_CELL, FP_STRING, FP_STRING, FP_STRING, FP_CELL, FP_DONE);
+
+	if (forward < 1)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Function not found: %s", handler);
+		return -1;
+	}
+
+	char path[256];
+	auto fp = fopen(MF_BuildPathnameR(path, sizeof(path), "%s", MF_GetAmxString(amx, params[1], 0, &len)), "rb");
+
+	if (!fp)
+	{
+		MF_UnregisterSPForward(forward);
+		return -1;
+	}
+
+	return JsonReaders.Add(new JSONReaderHandle(fp, MF_GetAmxString(amx, params[3], 0, &len), forward, params[4]));
+}
+
+//native JSONReaderStatus:json_reader_read(JSONReader:reader, max_events = 0);
+static cell AMX_NATIVE_CALL amxx_json_reader_read(AMX *amx, cell *params)
+{
+	auto handle = JsonReaders.Get(params[1]);
+	if (!handle)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON reader! %d", params[1]);
+		return ReaderStatus_Error;
+	}
+
+	if (handle->reading)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "JSON reader %d is already being read", params[1]);
+		return ReaderStatus_Error;
+	}
+
+	auto &reader = handle->reader;
+	auto status = ReaderStatus_Finished;
+	cell events = 0;
+
+	handle->reading = true;
+
+	while (reader.Next())
+	{
+		auto action = MF_ExecuteForward(handle->forward, params[1], static_cast<cell>(reader.GetEvent()),
+										reader.GetPath(), reader.GetKey(), reader.GetValue(), handle->data);
+
+		if (action == ReaderAction_Stop)
+		{
+			status = ReaderStatus_Stopped;
+			break;
+		}
+
+		if (action == ReaderAction_Skip)
+		{
+			reader.Skip();
+		}
+
+		if (params[2] > 0 && ++events >= params[2])
+		{
+			status = ReaderStatus_Paused;
+			break;
+		}
+	}
+
+	handle->reading = false;
+
+	return (reader.HasError()) ? ReaderStatus_Error : status;
+}
+
+//native json_reader_get_error(JSONReader:reader, buffer[], maxlen);
+static cell AMX_NATIVE_CALL amxx_json_reader_get_error(AMX *amx, cell *params)
+{
+	auto handle = JsonReaders.Get(params[1]);
+	if (!handle)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON reader! %d", params[1]);
+		return 0;
+	}
+
+	auto error = handle->reader.GetError();
+
+	return MF_SetAmxStringUTF8Char(amx, params[2], error, strlen(error), params[3]);
+}
+
+//native bool:json_reader_close(&JSONReader:reader);
+static cell AMX_NATIVE_CALL amxx_json_reader_close(AMX *amx, cell *params)
+{
+	auto reader = MF_GetAmxAddr(amx, params[1]);
+	auto handle = JsonReaders.Get(*reader);
+	if (!handle)
+	{
+		return 0;
+	}
+
+	if (handle->reading)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "JSON reader %d can't be closed while being read", *reader);
+		return 0;
+	}
+
+	JsonReaders.Remove(*reader);
+	*reader = -1;
+
+	return 1;
+}
+
+//native JSONWriter:json_writer_open(const file[], bool:pretty = false);
+static cell AMX_NATIVE_CALL amxx_json_writer_open(AMX *amx, cell *params)
+{
+	int len;
+	char path[256];
+	auto fp = fopen(MF_BuildPathnameR(path, sizeof(path), "%s", MF_GetAmxString(amx, params[1], 0, &len)), "w");
+
+	if (!fp)
+	{
+		return -1;
+	}
+
+	return JsonWriters.Add(new JSONWriter(fp, params[2] != 0));
+}
+
+static cell WriterResult(AMX *amx, JSONWriter *writer, bool result)
+{
+	if (!result)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "JSON writer error: %s", writer->GetError());
+	}
+
+	return result;
+}
+
+//native bool:json_writer_begin_object(JSONWriter:writer);
+static cell AMX_NATIVE_CALL amxx_json_writer_begin_object(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->BeginObject());
+}
+
+//native bool:json_writer_end_object(JSONWriter:writer);
+static cell AMX_NATIVE_CALL amxx_json_writer_end_object(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->EndObject());
+}
+
+//native bool:json_writer_begin_array(JSONWriter:writer);
+static cell AMX_NATIVE_CALL amxx_json_writer_begin_array(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->BeginArray());
+}
+
+//native bool:json_writer_end_array(JSONWriter:writer);
+static cell AMX_NATIVE_CALL amxx_json_writer_end_array(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->EndArray());
+}
+
+//native bool:json_writer_key(JSONWriter:writer, const name[]);
+static cell AMX_NATIVE_CALL amxx_json_writer_key(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	int len;
+	return WriterResult(amx, writer, writer->Key(MF_GetAmxString(amx, params[2], 0, &len)));
+}
+
+//native bool:json_writer_string(JSONWriter:writer, const string[]);
+static cell AMX_NATIVE_CALL amxx_json_writer_string(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	int len;
+	auto string = MF_GetAmxString(amx, params[2], 0, &len);
+
+	return WriterResult(amx, writer, writer->String(string, len));
+}
+
+//native bool:json_writer_number(JSONWriter:writer, number);
+static cell AMX_NATIVE_CALL amxx_json_writer_number(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->Number(params[2]));
+}
+
+//native bool:json_writer_real(JSONWriter:writer, Float:number);
+static cell AMX_NATIVE_CALL amxx_json_writer_real(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->Number(amx_ctof(params[2])));
+}
+
+//native bool:json_writer_bool(JSONWriter:writer, bool:boolean);
+static cell AMX_NATIVE_CALL amxx_json_writer_bool(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->Bool(params[2] != 0));
+}
+
+//native bool:json_writer_null(JSONWriter:writer);
+static cell AMX_NATIVE_CALL amxx_json_writer_null(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, writer->Null());
+}
+
+//native bool:json_writer_value(JSONWriter:writer, const JSON:value);
+static cell AMX_NATIVE_CALL amxx_json_writer_value(AMX *amx, cell *params)
+{
+	auto writer = JsonWriters.Get(params[1]);
+	if (!writer)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON writer! %d", params[1]);
+		return 0;
+	}
+
+	auto value = params[2];
+	if (!JsonMngr->IsValidHandle(value))
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON value! %d", value);
+		return 0;
+	}
+
+	return WriterResult(amx, writer, JsonMngr->WriteValue(value, writer));
+}
+
+//native bool:json_writer_close(&JSONWriter:writer);
+static cell AMX_NATIVE_CALL amxx_json_writer_close(AMX *amx, cell *params)
+{
+	auto writer = MF_GetAmxAddr(amx, params[1]);
+	auto handle = JsonWriters.Get(*writer);
+	if (!handle)
+	{
+		return 0;
+	}
+
+	auto result = handle->Close();
+
+	JsonWriters.Remove(*writer);
+	*writer = -1;
+
+	return result;
+}
+
+// Must match JSON_SCHEMA_KEY_LENGTH and the JSONSchema layout in json.inc
+static const size_t JSONSchemaKeyLength = 64;
+static const size_t JSONTrieMaxKey      = 1024;
+
+enum JSONFieldType
+{
+	FieldType_Number,
+	FieldType_Real,
+	FieldType_Bool,
+	FieldType_String,
+	FieldType_NumberArray,
+	FieldType_RealArray
+};
+
+struct JSONSchemaField
+{
+	char          key[JSONSchemaKeyLength];
+	JSONFieldType type;
+	size_t        offset;
+	size_t        size;
+};
+
+static bool ReadSchema(AMX *amx, cell schemaAddr, cell fields, size_t blocksize, ke::Vector<JSONSchemaField> &schema)
+{
+	if (fields <= 0)
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid field count (%d)", fields);
+		return false;
+	}
+
+	auto base = MF_GetAmxAddr(amx, schemaAddr);
+
+	for (cell i = 0; i < fields; ++i)
+	{
+		auto row = MF_GetAmxAddr(amx, schemaAddr + i * sizeof(cell) + base[i]);
+
+		JSONSchemaField field;
+		size_t length = 0;
+
+		while (length < JSONSchemaKeyLength - 1 && row[length])
+		{
+			field.key[length] = static_cast<char>(row[length]);
+			++length;
+		}
+		field.key[length] = '\0';
+
+		auto type = row[JSONSchemaKeyLength];
+		auto offset = row[JSONSchemaKeyLength + 1];
+		auto size = row[JSONSchemaKeyLength + 2];
+
+		if (!length)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Empty key for field %d", i);
+			return false;
+		}
+
+		if (type < FieldType_Number || type > FieldType_RealArray)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Invalid type (%d) for field \"%s\"", type, field.key);
+			return false;
+		}
+
+		if (type < FieldType_String)
+		{
+			size = 1;
+		}
+		else if (size <= 0)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Invalid size (%d) for field \"%s\"", size, field.key);
+			return false;
+		}
+
+		if (offset < 0 || static_cast<size_t>(offset) + size > blocksize)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Field \"%s\" does not fit in blocks of %d cells", field.key, blocksize);
+			return false;
+		}
+
+		field.type = static_cast<JSONFieldType>(type);
+		field.offset = offset;
+		field.size = size;
+
+		schema.append(field);
+	}
+
+	return true;
+}
+
+// Booleans are accepted wherever a number is expected, and the other way around
+static bool GetNumber(const JSON_Value *value, double *number)
+{
+	switch (json_value_get_type(value))
+	{
+		case JSONNumber:
+		{
+			*number = json_value_get_number(value);
+			return true;
+		}
+		case JSONBoolean:
+		{
+			*number = json_value_get_boolean(value) == 1;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Whole numbers in the range of a cell, the ones stored as integers when the type is up to us
+static bool IsInteger(double number)
+{
+	return number >= INT32_MIN && number <= INT32_MAX && floor(number) == number;
+}
+
+static cell NumberToCell(double number, bool real)
+{
+	if (real)
+	{
+		return amx_ftoc(static_cast<float>(number));
+	}
+
+	// Out of range values are clamped, NaN is 0
+	if (number != number)
+	{
+		return 0;
+	}
+
+	if (number <= INT32_MIN)
+	{
+		return INT32_MIN;
+	}
+
+	if (number >= INT32_MAX)
+	{
+		return INT32_MAX;
+	}
+
+	return static_cast<cell>(number);
+}
+
+static void ReadField(const JSON_Value *value, const JSONSchemaField &field, cell *block)
+{
+	auto dest = block + field.offset;
+	double number;
+
+	switch (field.type)
+	{
+		case FieldType_Number:
+		case FieldType_Real:
+		{
+			if (GetNumber(value, &number))
+			{
+				*dest = NumberToCell(number, field.type == FieldType_Real);
+			}
+			break;
+		}
+		case FieldType_Bool:
+		{
+			if (GetNumber(value, &number))
+			{
+				*dest = number != 0.0;
+			}
+			break;
+		}
+		case FieldType_String:
+		{
+			auto string = json_value_get_string(value);
+			if (!string)
+			{
+				break;
+			}
+
+			auto length = strlen(string);
+			if (length >= field.size)
+			{
+				// Don't leave a partial UTF-8 sequence behind
+				length = field.size - 1;
+				while (length && (string[length] & 0xC0) == 0x80)
+				{
+					--length;
+				}
+			}
+
+			for (size_t i = 0; i < length; ++i)
+			{
+				dest[i] = static_cast<unsigned char>(string[i]);
+			}
+			dest[length] = 0;
+			break;
+		}
+		case FieldType_NumberArray:
+		case FieldType_RealArray:
+		{
+			auto array = json_value_get_array(value);
+			auto count = json_array_get_count(array);
+
+			for (size_t i = 0; i < count && i < field.size; ++i)
+			{
+				if (GetNumber(json_array_get_value(array, i), &number))
+				{
+					dest[i] = NumberToCell(number, field.type == FieldType_RealArray);
+				}
+			}
+			break;
+		}
+	}
+}
+
+static JSON_Value *WriteField(const JSONSchemaField &field, const cell *block, char *buffer)
+{
+	auto src = block + field.offset;
+
+	switch (field.type)
+	{
+		case FieldType_Number:
+		{
+			return json_value_init_number(*src);
+		}
+		case FieldType_Real:
+		{
+			return json_value_init_number(amx_ctof(*src));
+		}
+		case FieldType_Bool:
+		{
+			return json_value_init_boolean(*src != 0);
+		}
+		case FieldType_String:
+		{
+			size_t length = 0;
+			while (length < field.size && src[length])
+			{
+				buffer[length] = static_cast<char>(src[length]);
+				++length;
+			}
+			buffer[length] = '\0';
+
+			// Fails on invalid UTF-8, leaving the field out
+			return json_value_init_string(buffer);
+		}
+		case FieldType_NumberArray:
+		case FieldType_RealArray:
+		{
+			auto value = json_value_init_array();
+			auto array = json_value_get_array(value);
+
+			for (size_t i = 0; i < field.size; ++i)
+			{
+				double number = (field.type == FieldType_RealArray) ? amx_ctof(src[i]) : src[i];
+				json_array_append_number(array, number);
+			}
+
+			return value;
+		}
+	}
+
+	return nullptr;
+}
+
+//native json_array_to_cellarray(const JSON:array, Array:target, const schema[][JSONSchema], fields, bool:dotfunc = false);
+static cell AMX_NATIVE_CALL amxx_json_array_to_cellarray(AMX *amx, cell *params)
+{
+	auto array = params[1];
+	if (!JsonMngr->IsValidHandle(array, Handle_Array))
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON array! %d", array);
+		return 0;
+	}
+
+	size_t blocksize, count;
+	if (!DataStructs || !DataStructs->ArrayGetInfo(params[2], &blocksize, &count))
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid array handle provided (%d)", params[2]);
+		return 0;
+	}
+
+	ke::Vector<JSONSchemaField> schema;
+	if (!ReadSchema(amx, params[3], params[4], blocksize, schema))
+	{
+		return 0;
+	}
+
+	auto JSArray = JsonMngr->GetJSONArray(array);
+	auto elements = json_array_get_count(JSArray);
+	auto dotfunc = params[5] != 0;
+	cell pushed = 0;
+
+	for (size_t i = 0; i < elements; ++i)
+	{
+		auto JSObject = json_array_get_object(JSArray, i);
+		if (!JSObject)
+		{
+			continue;
+		}
+
+		auto block = DataStructs->ArrayPush(params[2]);
+		if (!block)
+		{
+			MF_LogError(amx, AMX_ERR_NATIVE, "Failed to grow array");
+			break;
+		}
+
+		for (size_t field = 0; field < schema.length(); ++field)
+		{
+			auto value = (!dotfunc) ? json_object_get_value(JSObject, schema[field].key) :
+							json_object_dotget_value(JSObject, schema[field].key);
+
+			if (value)
+			{
+				ReadField(value, schema[field], block);
+			}
+		}
+
+		++pushed;
+	}
+
+	return pushed;
+}
+
+//native JSON:json_array_from_cellarray(Array:source, const schema[][JSONSchema], fields, bool:dotfunc = false);
+static cell AMX_NATIVE_CALL amxx_json_array_from_cellarray(AMX *amx, cell *params)
+{
+	size_t blocksize, count;
+	if (!DataStructs || !DataStructs->ArrayGetInfo(params[1], &blocksize, &count))
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid array handle provided (%d)", params[1]);
+		return -1;
+	}
+
+	ke::Vector<JSONSchemaField> schema;
+	if (!ReadSchema(amx, params[2], params[3], blocksize, schema))
+	{
+		return -1;
+	}
+
+	// String fields can't be longer than the blocks
+	ke::AutoPtr<char[]> buffer(new char[blocksize + 1]);
+
+	auto JSArray = json_value_get_array(json_value_init_array());
+	if (!JSArray)
+	{
+		return -1;
+	}
+
+	auto dotfunc = params[4] != 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto block = DataStructs->ArrayAt(params[1], i);
+		auto JSValue = json_value_init_object();
+		auto JSObject = json_value_get_object(JSValue);
+
+		for (size_t field = 0; field < schema.length(); ++field)
+		{
+			auto value = WriteField(schema[field], block, buffer.get());
+			if (!value)
+			{
+				continue;
+			}
+
+			auto result = (!dotfunc) ? json_object_set_value(JSObject, schema[field].key, value) :
+							json_object_dotset_value(JSObject, schema[field].key, value);
+
+			if (result != JSONSuccess)
+			{
+				json_value_free(value);
+			}
+		}
+
+		if (json_array_append_value(JSArray, JSValue) != JSONSuccess)
+		{
+			json_value_free(JSValue);
+		}
+	}
+
+	return JsonMngr->AdoptArray(JSArray);
+}
+
+static cell ObjectToTrie(const JSON_Object *object, cell trie, char *key, size_t keyLength, bool replace)
+{
+	auto count = json_object_get_count(object);
+	ke::Vector<cell> cells;
+	cell set = 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto name = json_object_get_name(object, i);
+		auto value = json_object_get_value_at(object, i);
+
+		// Nested objects are flattened into dotted keys
+		auto nameLength = strlen(name);
+		auto length = keyLength + (keyLength ? 1 : 0) + nameLength;
+
+		if (length >= JSONTrieMaxKey)
+		{
+			continue;
+		}
+
+		if (keyLength)
+		{
+			key[keyLength] = '.';
+		}
+		memcpy(key + length - nameLength, name, nameLength + 1);
+
+		double number;
+
+		switch (json_value_get_type(value))
+		{
+			case JSONString:
+			{
+				set += DataStructs->TrieSetString(trie, key, json_value_get_string(value), replace);
+				break;
+			}
+			case JSONNumber:
+			case JSONBoolean:
+			{
+				GetNumber(value, &number);
+				set += DataStructs->TrieSetCell(trie, key, NumberToCell(number, !IsInteger(number)), replace);
+				break;
+			}
+			case JSONObject:
+			{
+				set += ObjectToTrie(json_value_get_object(value), trie, key, length, replace);
+				break;
+			}
+			case JSONArray:
+			{
+				// Only arrays of numbers are kept, as floats if any of them is
+				auto array = json_value_get_array(value);
+				auto elements = json_array_get_count(array);
+				auto real = false;
+				size_t index;
+
+				for (index = 0; index < elements; ++index)
+				{
+					if (!GetNumber(json_array_get_value(array, index), &number))
+					{
+						break;
+					}
+
+					real |= !IsInteger(number);
+				}
+
+				if (index < elements)
+				{
+					break;
+				}
+
+				cells.clear();
+
+				for (index = 0; index < elements; ++index)
+				{
+					GetNumber(json_array_get_value(array, index), &number);
+					cells.append(NumberToCell(number, real));
+				}
+
+				set += DataStructs->TrieSetArray(trie, key, cells.buffer(), cells.length(), replace);
+				break;
+			}
+		}
+
+		key[keyLength] = '\0';
+	}
+
+	return set;
+}
+
+//native json_object_to_trie(const JSON:object, Trie:target, bool:replace = true);
+static cell AMX_NATIVE_CALL amxx_json_object_to_trie(AMX *amx, cell *params)
+{
+	auto object = params[1];
+	if (!JsonMngr->IsValidHandle(object, Handle_Object))
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid JSON object! %d", object);
+		return 0;
+	}
+
+	if (!DataStructs || !DataStructs->TrieIsValid(params[2]))
+	{
+		MF_LogError(amx, AMX_ERR_NATIVE, "Invalid trie handle provided (%d)", params[2]);
+		return 0;
+	}
+
+	char key[JSONTrieMaxKey] = "";
+
+	return ObjectToTrie(JsonMngr->GetJSONObject(object), params[2], key, 0, params[3] != 0);
+}
+
 AMX_NATIVE_INFO JsonNatives[] =
 {
 	{ "json_parse",                     amxx_json_parse },
@@ -931,13 +1765,65 @@ AMX_NATIVE_INFO JsonNatives[] =
 	{ "json_serial_size",               amxx_json_serial_size },
 	{ "json_serial_to_string",          amxx_json_serial_to_string },
 	{ "json_serial_to_file",            amxx_json_serial_to_file },
+	{ "json_reader_open",               amxx_json_reader_open },
+	{ "json_reader_read",               amxx_json_reader_read },
+	{ "json_reader_get_error",          amxx_json_reader_get_error },
+	{ "json_reader_close",              amxx_json_reader_close },
+	{ "json_writer_open",               amxx_json_writer_open },
+	{ "json_writer_begin_object",       amxx_json_writer_begin_object },
+	{ "json_writer_end_object",         amxx_json_writer_end_object },
+	{ "json_writer_begin_array",        amxx_json_writer_begin_array },
+	{ "json_writer_end_array",          amxx_json_writer_end_array },
+	{ "json_writer_key",                amxx_json_writer_key },
+	{ "json_writer_string",             amxx_json_writer_string },
+	{ "json_writer_number",             amxx_json_writer_number },
+	{ "json_writer_real",               amxx_json_writer_real },
+	{ "json_writer_bool",               amxx_json_writer_bool },
+	{ "json_writer_null",               amxx_json_writer_null },
+	{ "json_writer_value",              amxx_json_writer_value },
+	{ "json_writer_close",              amxx_json_writer_close },
+	{ "json_array_to_cellarray",        amxx_json_array_to_cellarray },
+	{ "json_array_from_cellarray",      amxx_json_array_from_cellarray },
+	{ "json_object_to_trie",            amxx_json_object_to_trie },
 	{ nullptr,                          nullptr }
 };
 
+static void ReportJsonHandles(IHandleReport *report)
+{
+	JsonMngr->ReportHandles(report);
+}
+
 void OnAmxxAttach()
 {
 	JsonMngr = ke::MakeUnique<JSONMngr>();
 
+	// Missing on older cores, the conversion natives then fail with an error
+	auto getDataStructs = reinterpret_cast<IDataStructManager *(*)()>(MF_RequestFunction(DATASTRUCTS_FUNC));
+	DataStructs = getDataStructs ? getDataStructs() : nullptr;
+
+	auto getHandleStats = reinterpret_cast<IHandleStats *(*)()>(MF_RequestFunction(HANDLESTATS_FUNC));
+	HandleStats = getHandleStats ? getHandleStats() : nullptr;
+
+	if (HandleStats)
+	{
+		HandleStats->AddReporter(ReportJsonHandles);
+	}
+
 	MF_AddNatives(JsonNatives);
 	//MF_AddInterface(JsonMngr.get());
 }
+
+void OnAmxxDetach()
+{
+	if (HandleStats)
+	{
+		HandleStats->RemoveReporter(ReportJsonHandles);
+	}
+}
+
+void OnPluginsUnloading()
+{
+	// Readers hold forwards into the plugins, and files shouldn't stay open across maps
+	JsonReaders.Clear();
+	JsonWriters.Clear();
+}
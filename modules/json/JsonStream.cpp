@@ -0,0 +1,1061 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+//
+// JSON Streaming
+//
+
+#include <string.h>
+#include <amtl/am-string.h>
+#include "JsonStream.h"
+
+enum PathMatch
+{
+	Path_Mismatch,
+	Path_Ancestor,  // The filter goes deeper than the path
+	Path_Match,     // The path is the filter or lies below it
+};
+
+static PathMatch MatchPath(const char *path, const char *filter)
+{
+	if (!*filter)
+	{
+		return Path_Match;
+	}
+
+	for (;;)
+	{
+		if (!*path)
+		{
+			return Path_Ancestor;
+		}
+
+		auto pathEnd = strchr(path, '.');
+		auto filterEnd = strchr(filter, '.');
+
+		size_t pathLength = pathEnd ? pathEnd - path : strlen(path);
+		size_t filterLength = filterEnd ? filterEnd - filter : strlen(filter);
+
+		if (!(filterLength == 1 && *filter == '*') && (filterLength != pathLength || strncmp(path, filter, pathLength)))
+		{
+			return Path_Mismatch;
+		}
+
+		if (!filterEnd)
+		{
+			return Path_Match;
+		}
+
+		if (!pathEnd)
+		{
+			return Path_Ancestor;
+		}
+
+		path = pathEnd + 1;
+		filter = filterEnd + 1;
+	}
+}
+
+JSONReader::JSONReader(FILE *fp, const char *filter) : m_File(fp), m_BufferPos(0), m_BufferLength(0), m_Line(1), m_Column(0),
+	m_Depth(0), m_State(State_Value), m_Event(Event_Null), m_Level(0), m_SkipLevel(0), m_PathLength(0), m_KeyOffset(0)
+{
+	m_Path[0] = '\0';
+	m_Value[0] = '\0';
+	m_Error[0] = '\0';
+
+	size_t length = strlen(filter);
+	if (length >= sizeof(m_Filter))
+	{
+		length = sizeof(m_Filter) - 1;
+	}
+
+	memcpy(m_Filter, filter, length);
+	m_Filter[length] = '\0';
+}
+
+JSONReader::~JSONReader()
+{
+	fclose(m_File);
+}
+
+int JSONReader::Peek()
+{
+	if (m_BufferPos == m_BufferLength)
+	{
+		m_BufferLength = fread(m_Buffer, 1, sizeof(m_Buffer), m_File);
+		m_BufferPos = 0;
+
+		if (!m_BufferLength)
+		{
+			return EOF;
+		}
+	}
+
+	return static_cast<unsigned char>(m_Buffer[m_BufferPos]);
+}
+
+int JSONReader::Get()
+{
+	int c = Peek();
+
+	if (c != EOF)
+	{
+		++m_BufferPos;
+
+		if (c == '\n')
+		{
+			++m_Line;
+			m_Column = 0;
+		}
+		else
+		{
+			++m_Column;
+		}
+	}
+
+	return c;
+}
+
+void JSONReader::SkipWhitespace()
+{
+	for (int c = Peek(); c == ' ' || c == '\t' || c == '\n' || c == '\r'; c = Peek())
+	{
+		Get();
+	}
+}
+
+bool JSONReader::Fail(const char *message)
+{
+	if (!HasError())
+	{
+		ke::SafeSprintf(m_Error, sizeof(m_Error), "%s at line %u, column %u", message,
+				 static_cast<unsigned int>(m_Line), static_cast<unsigned int>(m_Column));
+	}
+
+	return false;
+}
+
+bool JSONReader::Next()
+{
+	while (!HasError() && ReadEvent())
+	{
+		if (Accept())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JSONReader::Skip()
+{
+	if ((m_Event == Event_ObjectStart || m_Event == Event_ArrayStart) && !IsSkipping())
+	{
+		m_SkipLevel = m_Level;
+	}
+}
+
+bool JSONReader::Accept()
+{
+	if (IsSkipping())
+	{
+		if ((m_Event == Event_ObjectEnd || m_Event == Event_ArrayEnd) && m_Level == m_SkipLevel)
+		{
+			m_SkipLevel = 0;
+		}
+
+		return false;
+	}
+
+	switch (MatchPath(m_Path, m_Filter))
+	{
+		case Path_Match:
+		{
+			return true;
+		}
+		case Path_Mismatch:
+		{
+			// Nothing inside can match either
+			Skip();
+			return false;
+		}
+		default:
+		{
+			return false;
+		}
+	}
+}
+
+bool JSONReader::ReadEvent()
+{
+	for (;;)
+	{
+		SkipWhitespace();
+		int c = Peek();
+
+		switch (m_State)
+		{
+			case State_Done:
+			{
+				return (c == EOF) ? false : Fail("Unexpected data after the root value");
+			}
+			case State_Value:
+			{
+				return ReadValue(c);
+			}
+			case State_KeyOrEnd:
+			{
+				if (c == '}')
+				{
+					Get();
+					return EndContainer();
+				}
+			}
+			// fall through
+			case State_Key:
+			{
+				if (c != '"')
+				{
+					return Fail("Expected a string key");
+				}
+
+				Get();
+
+				auto &frame = m_Frames[m_Depth - 1];
+				++frame.index;
+
+				if (IsSkipping())
+				{
+					if (!ReadString(nullptr, 0, nullptr, nullptr))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					size_t offset = frame.pathLength + (m_Depth > 1 ? 1 : 0);
+					size_t length;
+
+					if (offset >= sizeof(m_Path) || !ReadString(m_Path + offset, sizeof(m_Path) - offset - 1, &length, "Path too long"))
+					{
+						return Fail("Path too long");
+					}
+
+					if (m_Depth > 1)
+					{
+						m_Path[frame.pathLength] = '.';
+					}
+
+					m_KeyOffset = offset;
+					m_PathLength = offset + length;
+				}
+
+				SkipWhitespace();
+
+				if (Get() != ':')
+				{
+					return Fail("Expected ':'");
+				}
+
+				m_State = State_Value;
+				continue;
+			}
+			case State_ElementOrEnd:
+			{
+				if (c == ']')
+				{
+					Get();
+					return EndContainer();
+				}
+			}
+			// fall through
+			case State_Element:
+			{
+				auto &frame = m_Frames[m_Depth - 1];
+
+				if (!IsSkipping() && !SetIndexSegment(frame.index))
+				{
+					return false;
+				}
+
+				++frame.index;
+				m_State = State_Value;
+				continue;
+			}
+			case State_CommaOrEnd:
+			{
+				auto &frame = m_Frames[m_Depth - 1];
+
+				if (c == ',')
+				{
+					Get();
+					m_State = frame.object ? State_Key : State_Element;
+					continue;
+				}
+
+				if (c == (frame.object ? '}' : ']'))
+				{
+					Get();
+					return EndContainer();
+				}
+
+				return Fail(frame.object ? "Expected ',' or '}'" : "Expected ',' or ']'");
+			}
+		}
+	}
+}
+
+bool JSONReader::ReadValue(int c)
+{
+	m_Level = m_Depth;
+
+	switch (c)
+	{
+		case '{':
+		{
+			Get();
+			return BeginContainer(true);
+		}
+		case '[':
+		{
+			Get();
+			return BeginContainer(false);
+		}
+		case '"':
+		{
+			Get();
+
+			if (!ReadString(IsSkipping() ? nullptr : m_Value, JSONStreamMaxString, nullptr, "String too long"))
+			{
+				return false;
+			}
+
+			m_Event = Event_String;
+			EndValue();
+			return true;
+		}
+		case 't':
+		{
+			m_Event = Event_Bool;
+			return ReadLiteral("true");
+		}
+		case 'f':
+		{
+			m_Event = Event_Bool;
+			return ReadLiteral("false");
+		}
+		case 'n':
+		{
+			m_Event = Event_Null;
+			return ReadLiteral("null");
+		}
+		case EOF:
+		{
+			return Fail("Unexpected end of file");
+		}
+	}
+
+	if (c == '-' || (c >= '0' && c <= '9'))
+	{
+		return ReadNumber();
+	}
+
+	return Fail("Unexpected character");
+}
+
+bool JSONReader::ReadHex(unsigned int *code)
+{
+	*code = 0;
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		int c = Get();
+		*code <<= 4;
+
+		if (c >= '0' && c <= '9')
+		{
+			*code |= c - '0';
+		}
+		else if (c >= 'a' && c <= 'f')
+		{
+			*code |= c - 'a' + 10;
+		}
+		else if (c >= 'A' && c <= 'F')
+		{
+			*code |= c - 'A' + 10;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool JSONReader::ReadString(char *buffer, size_t maxlen, size_t *length, const char *overflow)
+{
+	size_t written = 0;
+
+	for (;;)
+	{
+		int c = Get();
+
+		if (c == '"')
+		{
+			break;
+		}
+
+		if (c == EOF)
+		{
+			return Fail("Unterminated string");
+		}
+
+		if (c < 0x20)
+		{
+			return Fail("Control character in string");
+		}
+
+		char utf8[4];
+		size_t count = 1;
+		utf8[0] = static_cast<char>(c);
+
+		if (c == '\\')
+		{
+			switch (c = Get())
+			{
+				case '"': case '\\': case '/': utf8[0] = static_cast<char>(c); break;
+				case 'b': utf8[0] = '\b'; break;
+				case 'f': utf8[0] = '\f'; break;
+				case 'n': utf8[0] = '\n'; break;
+				case 'r': utf8[0] = '\r'; break;
+				case 't': utf8[0] = '\t'; break;
+				case 'u':
+				{
+					unsigned int code, low;
+
+					if (!ReadHex(&code))
+					{
+						return Fail("Invalid unicode escape");
+					}
+
+					if (code >= 0xD800 && code <= 0xDBFF)
+					{
+						if (Get() != '\\' || Get() != 'u' || !ReadHex(&low) || low < 0xDC00 || low > 0xDFFF)
+						{
+							return Fail("Invalid surrogate pair");
+						}
+
+						code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+					}
+					else if (code >= 0xDC00 && code <= 0xDFFF)
+					{
+						return Fail("Invalid surrogate pair");
+					}
+
+					if (code < 0x80)
+					{
+						utf8[0] = static_cast<char>(code);
+					}
+					else if (code < 0x800)
+					{
+						utf8[0] = static_cast<char>(0xC0 | (code >> 6));
+						utf8[1] = static_cast<char>(0x80 | (code & 0x3F));
+						count = 2;
+					}
+					else if (code < 0x10000)
+					{
+						utf8[0] = static_cast<char>(0xE0 | (code >> 12));
+						utf8[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+						utf8[2] = static_cast<char>(0x80 | (code & 0x3F));
+						count = 3;
+					}
+					else
+					{
+						utf8[0] = static_cast<char>(0xF0 | (code >> 18));
+						utf8[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+						utf8[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+						utf8[3] = static_cast<char>(0x80 | (code & 0x3F));
+						count = 4;
+					}
+					break;
+				}
+				default:
+				{
+					return Fail("Invalid escape sequence");
+				}
+			}
+		}
+
+		if (buffer)
+		{
+			if (written + count > maxlen)
+			{
+				return Fail(overflow);
+			}
+
+			memcpy(buffer + written, utf8, count);
+		}
+
+		written += count;
+	}
+
+	if (buffer)
+	{
+		buffer[written] = '\0';
+	}
+
+	if (length)
+	{
+		*length = written;
+	}
+
+	return true;
+}
+
+bool JSONReader::ReadNumber()
+{
+	size_t length = 0;
+	bool digits;
+
+	auto store = [this, &length]() -> bool
+	{
+		if (length >= JSONStreamMaxString)
+		{
+			return Fail("Number too long");
+		}
+
+		m_Value[length++] = static_cast<char>(Get());
+		return true;
+	};
+	auto isDigit = [](int c)
+	{
+		return c >= '0' && c <= '9';
+	};
+	auto storeDigits = [this, &store, &isDigit]() -> bool
+	{
+		if (!isDigit(Peek()))
+		{
+			return Fail("Invalid number");
+		}
+
+		while (isDigit(Peek()))
+		{
+			if (!store())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	if (Peek() == '-' && !store())
+	{
+		return false;
+	}
+
+	if (Peek() == '0')
+	{
+		digits = store();
+	}
+	else
+	{
+		digits = storeDigits();
+	}
+
+	if (!digits)
+	{
+		return false;
+	}
+
+	if (Peek() == '.' && (!store() || !storeDigits()))
+	{
+		return false;
+	}
+
+	if (Peek() == 'e' || Peek() == 'E')
+	{
+		if (!store())
+		{
+			return false;
+		}
+
+		if ((Peek() == '+' || Peek() == '-') && !store())
+		{
+			return false;
+		}
+
+		if (!storeDigits())
+		{
+			return false;
+		}
+	}
+
+	m_Value[length] = '\0';
+	m_Event = Event_Number;
+	EndValue();
+
+	return true;
+}
+
+bool JSONReader::ReadLiteral(const char *literal)
+{
+	for (auto p = literal; *p; ++p)
+	{
+		if (Get() != *p)
+		{
+			return Fail("Unexpected character");
+		}
+	}
+
+	strcpy(m_Value, literal);
+	EndValue();
+
+	return true;
+}
+
+bool JSONReader::SetIndexSegment(size_t index)
+{
+	auto &frame = m_Frames[m_Depth - 1];
+	size_t offset = frame.pathLength + (m_Depth > 1 ? 1 : 0);
+
+	char segment[24];
+	int length = ke::SafeSprintf(segment, sizeof(segment), "%u", static_cast<unsigned int>(index));
+
+	if (offset + length >= sizeof(m_Path))
+	{
+		return Fail("Path too long");
+	}
+
+	if (m_Depth > 1)
+	{
+		m_Path[frame.pathLength] = '.';
+	}
+
+	memcpy(m_Path + offset, segment, length + 1);
+
+	m_KeyOffset = offset;
+	m_PathLength = offset + length;
+
+	return true;
+}
+
+bool JSONReader::BeginContainer(bool object)
+{
+	if (m_Depth == JSONStreamMaxDepth)
+	{
+		return Fail("Too deeply nested");
+	}
+
+	auto &frame = m_Frames[m_Depth++];
+	frame.object = object;
+	frame.index = 0;
+	frame.pathLength = m_PathLength;
+	frame.keyOffset = m_KeyOffset;
+
+	m_Level = m_Depth;
+	m_Event = object ? Event_ObjectStart : Event_ArrayStart;
+	m_State = object ? State_KeyOrEnd : State_ElementOrEnd;
+	m_Value[0] = '\0';
+
+	return true;
+}
+
+bool JSONReader::EndContainer()
+{
+	auto &frame = m_Frames[m_Depth - 1];
+
+	m_PathLength = frame.pathLength;
+	m_KeyOffset = frame.keyOffset;
+	m_Path[m_PathLength] = '\0';
+
+	m_Level = m_Depth--;
+	m_Event = frame.object ? Event_ObjectEnd : Event_ArrayEnd;
+	m_Value[0] = '\0';
+
+	EndValue();
+
+	return true;
+}
+
+void JSONReader::EndValue()
+{
+	m_State = m_Depth ? State_CommaOrEnd : State_Done;
+}
+
+JSONWriter::JSONWriter(FILE *fp, bool pretty) : m_File(fp), m_Length(0), m_Pretty(pretty), m_HasRoot(false), m_WriteFailed(false),
+	m_Depth(0), m_Error(nullptr)
+{
+}
+
+JSONWriter::~JSONWriter()
+{
+	if (m_File)
+	{
+		Flush();
+		fclose(m_File);
+	}
+}
+
+bool JSONWriter::Fail(const char *message)
+{
+	m_Error = message;
+	return false;
+}
+
+void JSONWriter::Flush()
+{
+	if (m_Length && !m_WriteFailed && fwrite(m_Buffer, 1, m_Length, m_File) != m_Length)
+	{
+		m_WriteFailed = true;
+	}
+
+	m_Length = 0;
+}
+
+void JSONWriter::Write(const char *data, size_t length)
+{
+	if (m_Length + length > sizeof(m_Buffer))
+	{
+		Flush();
+
+		if (length > sizeof(m_Buffer))
+		{
+			if (!m_WriteFailed && fwrite(data, 1, length, m_File) != length)
+			{
+				m_WriteFailed = true;
+			}
+
+			return;
+		}
+	}
+
+	memcpy(m_Buffer + m_Length, data, length);
+	m_Length += length;
+}
+
+void JSONWriter::Write(const char *data)
+{
+	Write(data, strlen(data));
+}
+
+void JSONWriter::Indent(size_t level)
+{
+	while (level--)
+	{
+		Write("    ", 4);
+	}
+}
+
+void JSONWriter::WriteString(const char *string, size_t length)
+{
+	size_t start = 0;
+	Write("\"", 1);
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		auto c = static_cast<unsigned char>(string[i]);
+		const char *escape;
+		char unicode[8];
+
+		// Same escapes as parson
+		switch (c)
+		{
+			case '"':  escape = "\\\""; break;
+			case '\\': escape = "\\\\"; break;
+			case '/':  escape = "\\/";  break;
+			case '\b': escape = "\\b";  break;
+			case '\f': escape = "\\f";  break;
+			case '\n': escape = "\\n";  break;
+			case '\r': escape = "\\r";  break;
+			case '\t': escape = "\\t";  break;
+			default:
+			{
+				if (c >= 0x20)
+				{
+					continue;
+				}
+
+				ke::SafeSprintf(unicode, sizeof(unicode), "\\u%04x", c);
+				escape = unicode;
+				break;
+			}
+		}
+
+		Write(string + start, i - start);
+		Write(escape);
+		start = i + 1;
+	}
+
+	Write(string + start, length - start);
+	Write("\"", 1);
+}
+
+void JSONWriter::Separate(Frame &frame)
+{
+	if (frame.count++)
+	{
+		Write(",", 1);
+	}
+
+	if (m_Pretty)
+	{
+		Write("\n", 1);
+		Indent(m_Depth);
+	}
+}
+
+bool JSONWriter::BeginValue()
+{
+	if (!m_Depth)
+	{
+		if (m_HasRoot)
+		{
+			return Fail("Document already has a root value");
+		}
+
+		m_HasRoot = true;
+		return true;
+	}
+
+	auto &frame = m_Frames[m_Depth - 1];
+
+	if (frame.object)
+	{
+		if (!frame.hasKey)
+		{
+			return Fail("Expected a key");
+		}
+
+		frame.hasKey = false;
+		return true;
+	}
+
+	Separate(frame);
+	return true;
+}
+
+bool JSONWriter::BeginContainer(bool object)
+{
+	if (m_Depth == JSONStreamMaxDepth)
+	{
+		return Fail("Too deeply nested");
+	}
+
+	if (!BeginValue())
+	{
+		return false;
+	}
+
+	auto &frame = m_Frames[m_Depth++];
+	frame.object = object;
+	frame.hasKey = false;
+	frame.count = 0;
+
+	Write(object ? "{" : "[", 1);
+	return true;
+}
+
+bool JSONWriter::EndContainer(bool object)
+{
+	if (!m_Depth || m_Frames[m_Depth - 1].object != object || m_Frames[m_Depth - 1].hasKey)
+	{
+		return Fail(object ? "Unexpected end of object" : "Unexpected end of array");
+	}
+
+	if (m_Frames[m_Depth - 1].count && m_Pretty)
+	{
+		Write("\n", 1);
+		Indent(m_Depth - 1);
+	}
+
+	Write(object ? "}" : "]", 1);
+	--m_Depth;
+
+	return true;
+}
+
+bool JSONWriter::BeginObject()
+{
+	return BeginContainer(true);
+}
+
+bool JSONWriter::EndObject()
+{
+	return EndContainer(true);
+}
+
+bool JSONWriter::BeginArray()
+{
+	return BeginContainer(false);
+}
+
+bool JSONWriter::EndArray()
+{
+	return EndContainer(false);
+}
+
+bool JSONWriter::Key(const char *name)
+{
+	if (!m_Depth || !m_Frames[m_Depth - 1].object || m_Frames[m_Depth - 1].hasKey)
+	{
+		return Fail("Unexpected key");
+	}
+
+	auto &frame = m_Frames[m_Depth - 1];
+
+	Separate(frame);
+	WriteString(name, strlen(name));
+	Write(m_Pretty ? ": " : ":");
+
+	frame.hasKey = true;
+	return true;
+}
+
+bool JSONWriter::String(const char *string, size_t length)
+{
+	if (!BeginValue())
+	{
+		return false;
+	}
+
+	WriteString(string, length);
+	return true;
+}
+
+bool JSONWriter::Number(double number)
+{
+	// Catches both NaN and infinities, which parson doesn't accept either
+	if (number - number != 0)
+	{
+		return Fail("Invalid number");
+	}
+
+	if (!BeginValue())
+	{
+		return false;
+	}
+
+	char buffer[64];
+	int length = ke::SafeSprintf(buffer, sizeof(buffer), "%1.17g", number);
+
+	Write(buffer, length);
+	return true;
+}
+
+bool JSONWriter::Bool(bool boolean)
+{
+	if (!BeginValue())
+	{
+		return false;
+	}
+
+	Write(boolean ? "true" : "false");
+	return true;
+}
+
+bool JSONWriter::Null()
+{
+	if (!BeginValue())
+	{
+		return false;
+	}
+
+	Write("null", 4);
+	return true;
+}
+
+bool JSONWriter::Value(const JSON_Value *value)
+{
+	switch (json_value_get_type(value))
+	{
+		case JSONObject:
+		{
+			auto object = json_value_get_object(value);
+
+			if (!BeginObject())
+			{
+				return false;
+			}
+
+			for (size_t i = 0, count = json_object_get_count(object); i < count; ++i)
+			{
+				if (!Key(json_object_get_name(object, i)) || !Value(json_object_get_value_at(object, i)))
+				{
+					return false;
+				}
+			}
+
+			return EndObject();
+		}
+		case JSONArray:
+		{
+			auto array = json_value_get_array(value);
+
+			if (!BeginArray())
+			{
+				return false;
+			}
+
+			for (size_t i = 0, count = json_array_get_count(array); i < count; ++i)
+			{
+				if (!Value(json_array_get_value(array, i)))
+				{
+					return false;
+				}
+			}
+
+			return EndArray();
+		}
+		case JSONString:
+		{
+			return String(json_value_get_string(value), json_value_get_string_len(value));
+		}
+		case JSONNumber:
+		{
+			return Number(json_value_get_number(value));
+		}
+		case JSONBoolean:
+		{
+			return Bool(json_value_get_boolean(value) == 1);
+		}
+		case JSONNull:
+		{
+			return Null();
+		}
+	}
+
+	return Fail("Invalid value");
+}
+
+bool JSONWriter::Close()
+{
+	Flush();
+
+	if (fclose(m_File) == EOF)
+	{
+		m_WriteFailed = true;
+	}
+
+	m_File = nullptr;
+
+	if (m_WriteFailed)
+	{
+		return Fail("Failed to write to file");
+	}
+
+	if (!IsComplete())
+	{
+		return Fail("Document is not complete");
+	}
+
+	return true;
+}
@@ -0,0 +1,281 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+//
+// JSON Streaming
+//
+
+#ifndef _INCLUDE_JSON_STREAM_H_
+#define _INCLUDE_JSON_STREAM_H_
+
+#include <stdio.h>
+#include <parson.h>
+#include <amtl/am-vector.h>
+#include <amtl/am-autoptr.h>
+#include <amtl/am-deque.h>
+
+// Both sides work on fixed buffers allocated once, so memory use does not depend on the document size.
+// The nesting limit is the same as parson's.
+static const size_t JSONStreamBufferSize = 16384;
+static const size_t JSONStreamMaxDepth   = 2048;
+static const size_t JSONStreamMaxString  = 16384;
+static const size_t JSONStreamMaxPath    = 4096;
+
+//
+// Pull parser reading a document from a file one event at a time.
+//
+// Every event comes with the dotted path of its value ("players.3.name"), array
+// elements being named by their index. An optional filter made of the same segments,
+// '*' matching any single one, limits the events to the values at or below it.
+// Containers outside of the filter are still scanned but their contents are not kept.
+//
+class JSONReader
+{
+	public:
+
+	enum Event
+	{
+		Event_ObjectStart,
+		Event_ObjectEnd,
+		Event_ArrayStart,
+		Event_ArrayEnd,
+		Event_String,
+		Event_Number,
+		Event_Bool,
+		Event_Null,
+	};
+
+	JSONReader(FILE *fp, const char *filter);
+	~JSONReader();
+
+	// Reads up to the next event passing the filter. Returns false at the end of
+	// the document or on error.
+	bool Next();
+
+	// Skips the contents of the container whose start event was just returned,
+	// including its end event.
+	void Skip();
+
+	inline bool HasError() const
+	{
+		return m_Error[0] != '\0';
+	}
+	inline const char *GetError() const
+	{
+		return m_Error;
+	}
+	inline Event GetEvent() const
+	{
+		return m_Event;
+	}
+	inline const char *GetPath() const
+	{
+		return m_Path;
+	}
+	inline const char *GetKey() const
+	{
+		return m_Path + m_KeyOffset;
+	}
+	inline const char *GetValue() const
+	{
+		return m_Value;
+	}
+
+	private:
+
+	enum State
+	{
+		State_Value,
+		State_KeyOrEnd,
+		State_Key,
+		State_ElementOrEnd,
+		State_Element,
+		State_CommaOrEnd,
+		State_Done,
+	};
+
+	struct Frame
+	{
+		bool   object;
+		size_t index;
+		size_t pathLength;
+		size_t keyOffset;
+	};
+
+	int Peek();
+	int Get();
+	void SkipWhitespace();
+
+	bool ReadEvent();
+	bool ReadValue(int c);
+	bool ReadString(char *buffer, size_t maxlen, size_t *length, const char *overflow);
+	bool ReadHex(unsigned int *code);
+	bool ReadNumber();
+	bool ReadLiteral(const char *literal);
+
+	bool BeginContainer(bool object);
+	bool EndContainer();
+	bool SetIndexSegment(size_t index);
+	void EndValue();
+	bool Accept();
+	bool Fail(const char *message);
+
+	inline bool IsSkipping() const
+	{
+		return m_SkipLevel != 0;
+	}
+
+	FILE  *m_File;
+	char   m_Buffer[JSONStreamBufferSize];
+	size_t m_BufferPos;
+	size_t m_BufferLength;
+	size_t m_Line;
+	size_t m_Column;
+
+	Frame  m_Frames[JSONStreamMaxDepth];
+	size_t m_Depth;
+	State  m_State;
+
+	Event  m_Event;
+	size_t m_Level;
+	size_t m_SkipLevel;
+	char   m_Path[JSONStreamMaxPath];
+	size_t m_PathLength;
+	size_t m_KeyOffset;
+	char   m_Value[JSONStreamMaxString + 1];
+	char   m_Filter[JSONStreamMaxPath];
+	char   m_Error[128];
+};
+
+//
+// Writer appending values to a file through a fixed buffer, in the same format as parson.
+//
+class JSONWriter
+{
+	public:
+
+	JSONWriter(FILE *fp, bool pretty);
+	~JSONWriter();
+
+	bool BeginObject();
+	bool EndObject();
+	bool BeginArray();
+	bool EndArray();
+	bool Key(const char *name);
+	bool String(const char *string, size_t length);
+	bool Number(double number);
+	bool Bool(bool boolean);
+	bool Null();
+
+	// Writes a parson value as a whole, without serialising it to memory first.
+	bool Value(const JSON_Value *value);
+
+	// Flushes and closes the file. Returns false on write errors or if the document isn't complete.
+	bool Close();
+
+	inline bool IsComplete() const
+	{
+		return m_HasRoot && !m_Depth;
+	}
+	inline const char *GetError() const
+	{
+		return m_Error;
+	}
+
+	private:
+
+	struct Frame
+	{
+		bool   object;
+		bool   hasKey;
+		size_t count;
+	};
+
+	bool BeginValue();
+	bool BeginContainer(bool object);
+	bool EndContainer(bool object);
+	void Separate(Frame &frame);
+	void Indent(size_t level);
+	void WriteString(const char *string, size_t length);
+	void Write(const char *data, size_t length);
+	void Write(const char *data);
+	void Flush();
+	bool Fail(const char *message);
+
+	FILE  *m_File;
+	char   m_Buffer[JSONStreamBufferSize];
+	size_t m_Length;
+	bool   m_Pretty;
+	bool   m_HasRoot;
+	bool   m_WriteFailed;
+
+	Frame  m_Frames[JSONStreamMaxDepth];
+	size_t m_Depth;
+	const char *m_Error;
+};
+
+//
+// Handle table for readers and writers, the same way JSONMngr keeps its values.
+//
+template <typename T>
+class JSONStreamHandles
+{
+	public:
+
+	size_t Add(T *object)
+	{
+		size_t id;
+
+		if (!m_OldHandles.empty())
+		{
+			id = m_OldHandles.popFrontCopy();
+			m_Handles[id] = ke::AutoPtr<T>(object);
+		}
+		else
+		{
+			m_Handles.append(ke::AutoPtr<T>(object));
+			id = m_Handles.length() - 1;
+		}
+
+		return id;
+	}
+
+	T *Get(size_t id)
+	{
+		if (id >= m_Handles.length())
+		{
+			return nullptr;
+		}
+
+		return m_Handles[id].get();
+	}
+
+	void Remove(size_t id)
+	{
+		m_Handles[id] = nullptr;
+		m_OldHandles.append(id);
+	}
+
+	void Clear()
+	{
+		m_Handles.clear();
+
+		while (!m_OldHandles.empty())
+		{
+			m_OldHandles.popFront();
+		}
+	}
+
+	private:
+
+	ke::Vector<ke::AutoPtr<T>> m_Handles;
+	ke::Deque<size_t> m_OldHandles;
+};
+
+#endif // _INCLUDE_JSON_STREAM_H_
@@ -73,7 +73,7 @@
 #define FN_AMXX_ATTACH OnAmxxAttach
 
 /** AMXX Detach (unload) */
-// #define FN_AMXX_DETACH OnAmxxDetach
+#define FN_AMXX_DETACH OnAmxxDetach
 
 /** All plugins loaded
  * Do forward functions init here (MF_RegisterForward)
@@ -81,7 +81,7 @@
 // #define FN_AMXX_PLUGINSLOADED OnPluginsLoaded
 
 /** All plugins are about to be unloaded */
-//#define FN_AMXX_PLUGINSUNLOADING OnPluginsUnloading
+#define FN_AMXX_PLUGINSUNLOADING OnPluginsUnloading
 
 /** All plugins are now unloaded */
 //#define FN_AMXX_PLUGINSUNLOADED OnPluginsUnloaded
@@ -22,10 +22,12 @@ struct QHandle
 	FREEHANDLE _func;
 	HandleType type;
 	bool isfree;
+	int owner;
 };
 
 ke::Vector<QHandle *> g_Handles;
 CStack<unsigned int> g_FreeHandles;
+IHandleStats *HandleStats = NULL;
 
 unsigned int MakeHandle(void *ptr, HandleType type, FREEHANDLE f)
 {
@@ -47,6 +49,7 @@ unsigned int MakeHandle(void *ptr, HandleType type, FREEHANDLE f)
 	h->type = type;
 	h->_func = f;
 	h->isfree = false;
+	h->owner = HandleStats ? HandleStats->GetCallingPlugin() : -1;
 
 	return num + 1;
 }
@@ -118,3 +121,25 @@ void FreeHandleTable()
 	while (!g_FreeHandles.empty())
 		g_FreeHandles.pop();
 }
+
+void ReportHandles(IHandleReport *report)
+{
+	static const char *names[] =
+	{
+		"MySQL Connection",
+		"MySQL Tuple",
+		"MySQL Query",
+		"MySQL Old Db",
+		"MySQL Old Result",
+	};
+
+	QHandle *q;
+	for (size_t i = 0; i < g_Handles.length(); i++)
+	{
+		q = g_Handles[i];
+		if (q && !q->isfree && q->type >= Handle_Connection && q->type <= Handle_OldResult)
+		{
+			report->AddHandle(names[q->type], q->owner, 0);
+		}
+	}
+}
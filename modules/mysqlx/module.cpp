@@ -37,6 +37,14 @@ void OnAmxxAttach()
 	MF_AddNatives(g_BaseSqlNatives);
 	MF_AddNatives(g_ThreadSqlNatives);
 	g_MysqlFuncs.prev = (SqlFunctions *)MF_RegisterFunctionEx(&g_MysqlFuncs, SQL_DRIVER_FUNC);
+
+	// Missing on older cores
+	IHandleStats *(*getHandleStats)() = (IHandleStats *(*)())MF_RequestFunction(HANDLESTATS_FUNC);
+	if (getHandleStats && (HandleStats = getHandleStats()) != NULL)
+	{
+		HandleStats->AddReporter(ReportHandles);
+	}
+
 	if (!MF_RequestFunction("GetDbDriver") 
 		&& !MF_FindLibrary("SQLITE", LibType_Library))
 	{
@@ -47,6 +55,11 @@ void OnAmxxAttach()
 
 void OnAmxxDetach()
 {
+	if (HandleStats)
+	{
+		HandleStats->RemoveReporter(ReportHandles);
+	}
+
 	ShutdownThreading();
 	MF_RemoveLibraries(&g_ident);
 }
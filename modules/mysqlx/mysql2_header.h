@@ -16,8 +16,7 @@
 
 #include "MysqlDriver.h"
 #include "amxxmodule.h"
-#include "ThreadSupport.h"
-#include "ThreadWorker.h"
+#include <IHandleStats.h>
 
 #define MYSQL2_THREADED
 
@@ -58,14 +57,14 @@ void *GetHandle(unsigned int num, HandleType type);
 bool FreeHandle(unsigned int num);
 void FreeAllHandles(HandleType type);
 void FreeHandleTable();
+void ReportHandles(IHandleReport *report);
 void ShutdownThreading();
 int SetMysqlAffinity(AMX *amx);
 
+extern IHandleStats *HandleStats;
 extern AMX_NATIVE_INFO g_BaseSqlNatives[];
 extern AMX_NATIVE_INFO g_ThreadSqlNatives[];
 extern AMX_NATIVE_INFO g_OldCompatNatives[];
-extern MainThreader g_Threader;
-extern ThreadWorker *g_pWorker;
 extern SourceMod::MysqlDriver g_Mysql;
 
 #endif //_INCLUDE_AMXMODX_MYSQL2_HEADER_H
@@ -14,7 +14,6 @@
 #ifndef _INCLUDE_MYSQL_THREADING_H
 #define _INCLUDE_MYSQL_THREADING_H
 
-#include "IThreader.h"
 #include "ISQLDriver.h"
 #include <amtl/am-string.h>
 #include <sh_stack.h>
@@ -68,7 +67,7 @@ private:
 	bool m_IsFree;
 };
 
-class MysqlThread : public IThread
+class MysqlThread
 {
 public:
 	MysqlThread();
@@ -82,8 +81,7 @@ public:
 	void Invalidate();
 	void Execute();
 public:
-	void RunThread(IThreadHandle *pHandle);
-	void OnTerminate(IThreadHandle *pHandle, bool cancel);
+	void RunThread();
 private:
 	ke::AString m_query;
 	ke::AString m_host;
@@ -101,5 +99,9 @@ private:
 	AtomicResult m_atomicResult;
 };
 
+// Thread pool callbacks, the job data is the MysqlThread
+void RunQueryJob(void *data);
+void CompleteQueryJob(void *data, bool cancelled);
+
 #endif //_INCLUDE_MYSQL_THREADING_H
 
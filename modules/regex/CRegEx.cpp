@@ -22,6 +22,7 @@ RegEx::RegEx()
 {
 	mErrorOffset = 0;
 	mError = NULL;
+	mOwner = -1;
 	re = NULL;
 	mFree = true;
 	subject = NULL;
@@ -59,6 +59,7 @@ public:
 public:
 	int mErrorOffset;
 	const char *mError;
+	int mOwner;
 	int Count() { return mSubStrings.length(); }
 
 private:
@@ -14,27 +14,46 @@
 #include <string.h>
 #include "pcre.h"
 #include "amxxmodule.h"
+#include <IHandleStats.h>
 #include <amtl/am-vector.h>
 #include <amtl/am-utility.h>
 #include "CRegEx.h"
 #include "utils.h"
 
 ke::Vector<RegEx *> PEL;
+IHandleStats *HandleStats = NULL;
 
 int GetPEL()
 {
+	int owner = HandleStats ? HandleStats->GetCallingPlugin() : -1;
+
 	for (int i=0; i<(int)PEL.length(); i++)
 	{
 		if (PEL[i]->isFree())
+		{
+			PEL[i]->mOwner = owner;
 			return i;
+		}
 	}
 
 	RegEx *x = new RegEx();
+	x->mOwner = owner;
 	PEL.append(x);
 
 	return (int)PEL.length() - 1;
 }
 
+void ReportHandles(IHandleReport *report)
+{
+	for (size_t i = 0; i < PEL.length(); i++)
+	{
+		if (PEL[i] && !PEL[i]->isFree())
+		{
+			report->AddHandle("Regex", PEL[i]->mOwner, 0);
+		}
+	}
+}
+
 // native Regex:regex_compile(const pattern[], &ret, error[], maxLen, const flags[]="");
 static cell AMX_NATIVE_CALL regex_compile(AMX *amx, cell *params)
 {
@@ -319,10 +338,22 @@ AMX_NATIVE_INFO regex_Natives[] = {
 void OnAmxxAttach()
 {
 	MF_AddNatives(regex_Natives);
+
+	// Missing on older cores
+	IHandleStats *(*getHandleStats)() = (IHandleStats *(*)())MF_RequestFunction(HANDLESTATS_FUNC);
+	if (getHandleStats && (HandleStats = getHandleStats()) != NULL)
+	{
+		HandleStats->AddReporter(ReportHandles);
+	}
 }
 
 void OnAmxxDetach()
 {
+	if (HandleStats)
+	{
+		HandleStats->RemoveReporter(ReportHandles);
+	}
+
 	for (int i = 0; i<(int)PEL.length(); i++)
 	{
 		if (PEL[i])
@@ -62,6 +62,13 @@ void OnAmxxAttach()
 	MF_AddNatives(g_ThreadSqlNatives);
 	g_SqliteFuncs.prev = (SqlFunctions *)MF_RegisterFunctionEx(&g_SqliteFuncs, SQL_DRIVER_FUNC);
 
+	// Missing on older cores
+	IHandleStats *(*getHandleStats)() = (IHandleStats *(*)())MF_RequestFunction(HANDLESTATS_FUNC);
+	if (getHandleStats && (HandleStats = getHandleStats()) != NULL)
+	{
+		HandleStats->AddReporter(ReportHandles);
+	}
+
 	MF_AddLibraries("dbi", LibType_Class, &g_ident);
 
 	//override any mysqlx old compat stuff
@@ -82,6 +89,11 @@ void OnAmxxAttach()
 
 void OnAmxxDetach()
 {
+	if (HandleStats)
+	{
+		HandleStats->RemoveReporter(ReportHandles);
+	}
+
 	ShutdownThreading();
 	MF_RemoveLibraries(&g_ident);
 }
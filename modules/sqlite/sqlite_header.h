@@ -16,8 +16,7 @@
 
 #include "SqliteDriver.h"
 #include "amxxmodule.h"
-#include "ThreadSupport.h"
-#include "ThreadWorker.h"
+#include <IHandleStats.h>
 
 #define SQLITE_THREADED
 
@@ -56,14 +55,14 @@ void *GetHandle(unsigned int num, HandleType type);
 bool FreeHandle(unsigned int num);
 void FreeAllHandles(HandleType type);
 void FreeHandleTable();
+void ReportHandles(IHandleReport *report);
 void ShutdownThreading();
 int SetMysqlAffinity(AMX *amx);
 
+extern IHandleStats *HandleStats;
 extern AMX_NATIVE_INFO g_BaseSqlNatives[];
 extern AMX_NATIVE_INFO g_ThreadSqlNatives[];
 extern AMX_NATIVE_INFO g_OldCompatNatives[];
-extern MainThreader g_Threader;
-extern ThreadWorker *g_pWorker;
 extern SourceMod::SqliteDriver g_Sqlite;
 
 #endif //_INCLUDE_AMXMODX_MYSQL2_HEADER_H
@@ -16,38 +16,18 @@
 #include "threading.h"
 #include <amtl/am-string.h>
 
-MainThreader g_Threader;
-ThreadWorker *g_pWorker = NULL;
-extern DLL_FUNCTIONS *g_pFunctionTable;
-IMutex *g_QueueLock = NULL;
-CStack<MysqlThread *> g_ThreadQueue;
 CStack<MysqlThread *> g_FreeThreads;
-float g_lasttime = 0.0f;
 
 void ShutdownThreading()
 {
-	if (g_pWorker)
-	{
-		// Flush all the remaining job fast!
-		g_pWorker->SetMaxThreadsPerFrame(8192);
-		g_pWorker->Stop(true);
-		delete g_pWorker;
-		g_pWorker = NULL;
-	}
+	// Flush all the remaining jobs
+	MF_WaitThreadJobs(&g_Sqlite);
 
-	g_QueueLock->Lock();
-	while (!g_ThreadQueue.empty())
-	{
-		delete g_ThreadQueue.front();
-		g_ThreadQueue.pop();
-	}
 	while (!g_FreeThreads.empty())
 	{
 		delete g_FreeThreads.front();
 		g_FreeThreads.pop();
 	}
-	g_QueueLock->Unlock();
-	g_QueueLock->DestroyThis();
 
 	FreeHandleTable();
 }
@@ -56,12 +36,6 @@ void ShutdownThreading()
 //native SQL_ThreadQuery(Handle:cn_tuple, const handler[], const query[], const data[]="", dataSize=0);
 static cell AMX_NATIVE_CALL SQL_ThreadQuery(AMX *amx, cell *params)
 {
-	if (!g_pWorker)
-	{
-		MF_LogError(amx, AMX_ERR_NATIVE, "Thread worker was unable to start.");
-		return 0;
-	}
-
 	SQL_Connection *cn = (SQL_Connection *)GetHandle(params[1], Handle_Connection);
 	if (!cn)
 	{
@@ -79,7 +53,6 @@ static cell AMX_NATIVE_CALL SQL_ThreadQuery(AMX *amx, cell *params)
 	}
 
 	MysqlThread *kmThread;
-	g_QueueLock->Lock();
 	if (g_FreeThreads.empty())
 	{
 		kmThread = new MysqlThread();
@@ -87,14 +60,22 @@ static cell AMX_NATIVE_CALL SQL_ThreadQuery(AMX *amx, cell *params)
 		kmThread = g_FreeThreads.front();
 		g_FreeThreads.pop();
 	}
-	g_QueueLock->Unlock();
 
 	kmThread->SetInfo(cn->db);
 	kmThread->SetForward(fwd);
 	kmThread->SetQuery(MF_GetAmxString(amx, params[3], 1, &len));
 	kmThread->SetCellData(MF_GetAmxAddr(amx, params[4]), (ucell)params[5]);
 
-	g_pWorker->MakeThread(kmThread);
+	// Queries run one at a time, in the order they are made
+	if (!MF_AddThreadJob(amx, &g_Sqlite, RunQueryJob, CompleteQueryJob, kmThread))
+	{
+		MF_UnregisterSPForward(fwd);
+		kmThread->SetForward(0);
+		g_FreeThreads.push(kmThread);
+
+		MF_LogError(amx, AMX_ERR_NATIVE, "Thread worker was unable to start.");
+		return 0;
+	}
 
 	return 1;
 }
@@ -150,7 +131,7 @@ void MysqlThread::SetQuery(const char *query)
 	m_query = query;
 }
 
-void MysqlThread::RunThread(IThreadHandle *pHandle)
+void MysqlThread::RunThread()
 {
 	DatabaseInfo info;
 
@@ -209,19 +190,22 @@ void MysqlThread::Invalidate()
 	m_atomicResult.FreeHandle();
 }
 
-void MysqlThread::OnTerminate(IThreadHandle *pHandle, bool cancel)
+void RunQueryJob(void *data)
 {
-	if (cancel)
+	static_cast<MysqlThread *>(data)->RunThread();
+}
+
+void CompleteQueryJob(void *data, bool cancelled)
+{
+	MysqlThread *kmThread = static_cast<MysqlThread *>(data);
+
+	if (!cancelled)
 	{
-		Invalidate();
-		g_QueueLock->Lock();
-		g_FreeThreads.push(this);
-		g_QueueLock->Unlock();
-	} else {
-		g_QueueLock->Lock();
-		g_ThreadQueue.push(this);
-		g_QueueLock->Unlock();
+		kmThread->Execute();
 	}
+
+	kmThread->Invalidate();
+	g_FreeThreads.push(kmThread);
 }
 
 void NullFunc(void *ptr, unsigned int num)
@@ -283,90 +267,10 @@ void MysqlThread::Execute()
  * METAMOD STUFF *
  *****************/
 
-void OnPluginsLoaded()
-{
-	if (g_pWorker)
-	{
-		return;
-	}
-
-	if (!g_QueueLock)
-	{
-		g_QueueLock = g_Threader.MakeMutex();
-	}
-
-	g_pWorker = new ThreadWorker(&g_Threader, DEFAULT_THINK_TIME_MS);
-	if (!g_pWorker->Start())
-	{
-		delete g_pWorker;
-		g_pWorker = NULL;
-	}
-	g_pFunctionTable->pfnSpawn = NULL;
-
-	g_lasttime = 0.0f;
-
-	return;
-}
-
-void StartFrame()
-{
-	if (g_pWorker && (g_lasttime < gpGlobals->time))
-	{
-		g_lasttime = gpGlobals->time + 0.025f;
-		g_QueueLock->Lock();
-		size_t remaining = g_ThreadQueue.size();
-		if (remaining)
-		{
-			MysqlThread *kmThread;
-			do 
-			{
-				kmThread = g_ThreadQueue.front();
-				g_ThreadQueue.pop();
-				g_QueueLock->Unlock();
-				kmThread->Execute();
-				kmThread->Invalidate();
-				g_FreeThreads.push(kmThread);
-				g_QueueLock->Lock();
-			} while (!g_ThreadQueue.empty());
-		}
-
-		g_QueueLock->Unlock();
-	}
-
-	RETURN_META(MRES_IGNORED);
-}
-
 void OnPluginsUnloading()
 {
-	if (!g_pWorker)
-	{
-		return;
-	}
-
-	// Flush all the remaining job fast!
-	g_pWorker->SetMaxThreadsPerFrame(8192);
-	g_pWorker->Stop(false);
-	delete g_pWorker;
-	g_pWorker = NULL;
-
-	g_QueueLock->Lock();
-	size_t remaining = g_ThreadQueue.size();
-	if (remaining)
-	{
-		MysqlThread *kmThread;
-		do 
-		{
-			kmThread = g_ThreadQueue.front();
-			g_ThreadQueue.pop();
-			g_QueueLock->Unlock();
-			kmThread->Execute();
-			kmThread->Invalidate();
-			g_FreeThreads.push(kmThread);
-			g_QueueLock->Lock();
-		} while (!g_ThreadQueue.empty());
-	}
-
-	g_QueueLock->Unlock();
+	// Handlers of the remaining queries are called while plugins are still there
+	MF_WaitThreadJobs(&g_Sqlite);
 }
 
 /***********************
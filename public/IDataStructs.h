@@ -0,0 +1,69 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_IDATASTRUCTS_H_
+#define _INCLUDE_IDATASTRUCTS_H_
+
+#include <stddef.h>
+
+/**
+ * Name to pass to MF_RequestFunction(), the function returning the IDataStructManager pointer.
+ */
+#define DATASTRUCTS_FUNC	"GetDataStructManager"
+
+/**
+ * Gives modules access to the core's dynamic arrays and tries, so they can fill or read
+ * them in bulk without going through one native per value. Handles are the ones plugins see.
+ *
+ * The cell type must be defined before including this file.
+ */
+class IDataStructManager
+{
+public:
+	virtual ~IDataStructManager() {}
+
+	/**
+	 * Retrieves the block size and the number of blocks of an array.
+	 *
+	 * @return          false if the handle is invalid.
+	 */
+	virtual bool ArrayGetInfo(cell handle, size_t *blocksize, size_t *count) = 0;
+
+	/**
+	 * Appends a zeroed block to an array.
+	 *
+	 * @return          Block pointer, valid until the array is modified again,
+	 *                  or nullptr if the handle is invalid or memory ran out.
+	 */
+	virtual cell *ArrayPush(cell handle) = 0;
+
+	/**
+	 * Retrieves a block of an array for reading.
+	 *
+	 * @return          Block pointer, valid until the array is modified again,
+	 *                  or nullptr if the handle or the index is invalid.
+	 */
+	virtual const cell *ArrayAt(cell handle, size_t index) = 0;
+
+	/**
+	 * Checks whether a trie handle is valid.
+	 */
+	virtual bool TrieIsValid(cell handle) = 0;
+
+	/**
+	 * Sets a trie entry, the same way as the TrieSet* natives.
+	 *
+	 * @return          false if the handle is invalid, or if the key exists and replace is false.
+	 */
+	virtual bool TrieSetCell(cell handle, const char *key, cell value, bool replace) = 0;
+	virtual bool TrieSetString(cell handle, const char *key, const char *value, bool replace) = 0;
+	virtual bool TrieSetArray(cell handle, const char *key, const cell *values, size_t count, bool replace) = 0;
+};
+
+#endif // _INCLUDE_IDATASTRUCTS_H_
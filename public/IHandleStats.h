@@ -0,0 +1,66 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#ifndef _INCLUDE_IHANDLESTATS_H_
+#define _INCLUDE_IHANDLESTATS_H_
+
+#include <stddef.h>
+
+/**
+ * Name to pass to MF_RequestFunction(), the function returning the IHandleStats pointer.
+ */
+#define HANDLESTATS_FUNC	"GetHandleStats"
+
+/**
+ * Receives the live handles of a module when "amxx handles" runs or a map ends.
+ */
+class IHandleReport
+{
+public:
+	virtual ~IHandleReport() {}
+
+	/**
+	 * Adds a live handle.
+	 *
+	 * @param type      Handle type shown to the user, e.g. "SQL Query". Must stay valid
+	 *                  until the reporter returns.
+	 * @param plugin    Id of the owning plugin, as returned by GetCallingPlugin().
+	 * @param bytes     Approximate memory held by the object, 0 if unknown.
+	 */
+	virtual void AddHandle(const char *type, int plugin, size_t bytes) = 0;
+};
+
+typedef void (*HANDLE_REPORTER)(IHandleReport *report);
+
+/**
+ * Lets modules attribute their handles to plugins, so they are part of the per-plugin
+ * handle accounting and of the leak warnings given on map change.
+ */
+class IHandleStats
+{
+public:
+	virtual ~IHandleStats() {}
+
+	/**
+	 * Retrieves the plugin whose native is being executed, to be recorded as the owner
+	 * of the handles created by this native.
+	 *
+	 * @return          Plugin id, or -1 outside of a native.
+	 */
+	virtual int GetCallingPlugin() = 0;
+
+	/**
+	 * Adds or removes a function listing the live handles of a module.
+	 * Reporters must be removed before the module is unloaded.
+	 */
+	virtual void AddReporter(HANDLE_REPORTER reporter) = 0;
+	virtual void RemoveReporter(HANDLE_REPORTER reporter) = 0;
+};
+
+#endif // _INCLUDE_IHANDLESTATS_H_
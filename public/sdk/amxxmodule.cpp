@@ -2427,6 +2427,9 @@ PFN_AMX_REREGISTER			g_fn_AmxReRegister;
 PFN_REGISTERFUNCTIONEX		g_fn_RegisterFunctionEx;
 PFN_MESSAGE_BLOCK			g_fn_MessageBlock;
 PFN_GET_CONFIG_MANAGER		g_fn_GetConfigManager;
+PFN_ADD_THREAD_JOB			g_fn_AddThreadJob;
+PFN_CANCEL_THREAD_JOB		g_fn_CancelThreadJob;
+PFN_WAIT_THREAD_JOBS		g_fn_WaitThreadJobs;
 
 // *** Exports ***
 C_DLLEXPORT int AMXX_Query(int *interfaceVersion, amxx_module_info_s *moduleInfo)
@@ -2487,6 +2490,9 @@ C_DLLEXPORT int AMXX_Attach(PFN_REQ_FNPTR reqFnptrFunc)
 	REQFUNC("RegisterFunction", g_fn_RegisterFunction, PFN_REGISTERFUNCTION);
 	REQFUNC("RegisterFunctionEx", g_fn_RegisterFunctionEx, PFN_REGISTERFUNCTIONEX);
 	REQFUNC("GetConfigManager", g_fn_GetConfigManager, PFN_GET_CONFIG_MANAGER);
+	REQFUNC("AddThreadJob", g_fn_AddThreadJob, PFN_ADD_THREAD_JOB);
+	REQFUNC("CancelThreadJob", g_fn_CancelThreadJob, PFN_CANCEL_THREAD_JOB);
+	REQFUNC("WaitThreadJobs", g_fn_WaitThreadJobs, PFN_WAIT_THREAD_JOBS);
 
 	// Amx scripts
 	REQFUNC("GetAmxScript", g_fn_GetAmxScript, PFN_GET_AMXSCRIPT);
@@ -2717,6 +2723,9 @@ void ValidateMacros_DontCallThis_Smiley()
 	MF_OverrideNatives(NULL, NULL);
 	MF_MessageBlock(0, 0, NULL);
 	MF_GetConfigManager();
+	MF_AddThreadJob(NULL, NULL, NULL, NULL, NULL);
+	MF_CancelThreadJob(0);
+	MF_WaitThreadJobs(NULL);
 }
 #endif
 
@@ -2128,6 +2128,11 @@ enum LibType
 
 typedef void (*AUTHORIZEFUNC)(int player, const char *authstring);
 
+// Thread pool jobs: run is called on a worker thread, done on the main thread once it has
+// run, or with cancelled set if it was cancelled (it may then not have run at all)
+typedef void (*THREADJOB_RUN)(void *data);
+typedef void (*THREADJOB_DONE)(void *data, bool cancelled);
+
 typedef int				(*PFN_ADD_NATIVES)				(const AMX_NATIVE_INFO * /*list*/);
 typedef int				(*PFN_ADD_NEW_NATIVES)			(const AMX_NATIVE_INFO * /*list*/);
 typedef char *			(*PFN_BUILD_PATHNAME)			(const char * /*format*/, ...);
@@ -2222,6 +2227,9 @@ typedef int				(*PFN_AMX_REREGISTER)			(AMX * /*amx*/, AMX_NATIVE_INFO * /*list*
 typedef void *			(*PFN_REGISTERFUNCTIONEX)		(void * /*pfn*/, const char * /*desc*/);
 typedef void			(*PFN_MESSAGE_BLOCK)			(int /* mode */, int /* message */, int * /* opt */);
 typedef IGameConfigManager* (*PFN_GET_CONFIG_MANAGER)   ();
+typedef int				(*PFN_ADD_THREAD_JOB)			(AMX * /*owner*/, const void * /*queue*/, THREADJOB_RUN /*run*/, THREADJOB_DONE /*done*/, void * /*data*/);
+typedef int				(*PFN_CANCEL_THREAD_JOB)		(int /*job*/);
+typedef void			(*PFN_WAIT_THREAD_JOBS)			(const void * /*queue*/);
 
 extern PFN_ADD_NATIVES				g_fn_AddNatives;
 extern PFN_ADD_NEW_NATIVES			g_fn_AddNewNatives;
@@ -2304,6 +2312,9 @@ extern PFN_AMX_REREGISTER			g_fn_AmxReRegister;
 extern PFN_REGISTERFUNCTIONEX		g_fn_RegisterFunctionEx;
 extern PFN_MESSAGE_BLOCK			g_fn_MessageBlock;
 extern PFN_GET_CONFIG_MANAGER		g_fn_GetConfigManager;
+extern PFN_ADD_THREAD_JOB			g_fn_AddThreadJob;
+extern PFN_CANCEL_THREAD_JOB		g_fn_CancelThreadJob;
+extern PFN_WAIT_THREAD_JOBS			g_fn_WaitThreadJobs;
 
 #ifdef MAY_NEVER_BE_DEFINED
 // Function prototypes for intellisense and similar systems
@@ -2382,6 +2393,9 @@ int				MF_AmxReRegister			(AMX *amx, AMX_NATIVE_INFO *list, int number) { return
 void *			MF_RegisterFunctionEx		(void *pfn, const char *description) { }
 void *			MF_MessageBlock				(int mode, int msg, int *opt) { }
 IGameConfigManager* MF_GetConfigManager     (void) { }
+int				MF_AddThreadJob				(AMX *owner, const void *queue, THREADJOB_RUN run, THREADJOB_DONE done, void *data) { }
+int				MF_CancelThreadJob			(int job) { }
+void			MF_WaitThreadJobs			(const void *queue) { }
 #endif	// MAY_NEVER_BE_DEFINED
 
 #define MF_AddNatives g_fn_AddNatives
@@ -2466,6 +2480,9 @@ void MF_LogError(AMX *amx, int err, const char *fmt, ...);
 #define MF_RegisterFunctionEx g_fn_RegisterFunctionEx
 #define MF_MessageBlock g_fn_MessageBlock
 #define MF_GetConfigManager g_fn_GetConfigManager
+#define MF_AddThreadJob g_fn_AddThreadJob
+#define MF_CancelThreadJob g_fn_CancelThreadJob
+#define MF_WaitThreadJobs g_fn_WaitThreadJobs
 
 #ifdef MEMORY_TEST
 /*** Memory ***/
@@ -0,0 +1,72 @@
+// vim: set ts=4 sw=4 tw=99 noet:
+//
+// AMX Mod X, based on AMX Mod by Aleksander Naszko ("OLO").
+// Copyright (C) The AMX Mod X Development Team.
+//
+// This software is licensed under the GNU General Public License, version 3 or higher.
+// Additional exceptions apply. For full license details, see LICENSE.txt or visit:
+//     https://alliedmods.net/amxmodx-license
+
+#if !defined __HASHER_H__
+#define      __HASHER_H__
+
+/**
+ * Kept apart from hashing.h, which every hasher includes before being declared.
+ */
+#include "hashing.h"
+
+/**
+ * Longest hash, in bytes and in hex characters (SHA3 512 and KECCAK 512)
+ */
+enum
+{
+	MaxHashBytes  = 64,
+	MaxHashLength = MaxHashBytes * 2,
+};
+
+/**
+ * Hashes data given in chunks, e.g. a file read piece by piece.
+ * @note       Unlike hashFile() and hashString(), results aren't written to
+ *             a static buffer, so separate hashers can be used from any thread
+ */
+class Hasher
+{
+public:
+	explicit Hasher(HashType Type);
+
+	/**
+	 * Returns false if an invalid "Type" was given
+	 */
+	bool isValid() const;
+
+	HashType getType() const;
+
+	/**
+	 * Adds bytes to the data being hashed
+	 */
+	void add(const void* Data, size_t Size);
+
+	/**
+	 * Writes the hash of everything added as a zero-terminated hex string,
+	 * then starts over
+	 * @return     Number of hex characters written
+	 */
+	size_t finish(char Output[MaxHashLength + 1]);
+
+	/**
+	 * Drops everything added so far
+	 */
+	void reset();
+
+private:
+	HashType m_Type;
+
+	CRC32  m_Crc32;
+	MD5    m_Md5;
+	SHA1   m_Sha1;
+	SHA256 m_Sha256;
+	SHA3   m_Sha3;
+	Keccak m_Kec;
+};
+
+#endif // __HASHER_H__
@@ -5,6 +5,7 @@
 //
 
 #include "crc32.h"
+#include "simd.h"
 
 
 /// same as reset()
@@ -336,6 +337,15 @@ void CRC32::add(const void* data, size_t numBytes)
   uint32_t* current = (uint32_t*) data;
   uint32_t crc = ~m_hash;
 
+  // fold 16 bytes at once with carry-less multiplication, the tail goes through the tables
+  if (numBytes >= 64 && HashSimd::hasClmul())
+  {
+    size_t folded = numBytes & ~(size_t) 15;
+    crc = HashSimd::crc32Fold(crc, current, folded);
+    current   = (uint32_t*) ((unsigned char*) current + folded);
+    numBytes -= folded;
+  }
+
   // process eight bytes at once
   while (numBytes >= 8)
   {
@@ -275,6 +275,19 @@ const char* Keccak::getHash()
 }
 
 
+/// return latest hash as bytes
+void Keccak::getHash(unsigned char buffer[Keccak::MaxHashBytes])
+{
+  // process remaining bytes
+  processBuffer();
+
+  // same order as the hex characters, little endian within each 64 bit element
+  unsigned int hashBytes = m_bits / 8;
+  for (unsigned int i = 0; i < hashBytes; i++)
+    buffer[i] = (unsigned char) (m_hash[i / 8] >> (8 * (i % 8)));
+}
+
+
 /// compute Keccak hash of a memory block
 const char* Keccak::operator()(const void* data, size_t numBytes)
 {
@@ -26,6 +26,8 @@ class Keccak //: public Hash
 public:
   /// algorithm variants
   enum Bits { Keccak224 = 224, Keccak256 = 256, Keccak384 = 384, Keccak512 = 512 };
+  /// hash is up to 64 bytes long
+  enum { MaxHashBytes = 512 / 8 };
 
   /// same as reset()
   explicit Keccak(Bits bits = Keccak256);
@@ -40,6 +42,8 @@ public:
 
   /// return latest hash as hex characters
   const char* getHash();
+  /// return latest hash as bytes, MaxHashBytes at most (bits / 8)
+  void        getHash(unsigned char buffer[MaxHashBytes]);
 
   /// same as reset()
   void changeBits(Bits bits);
@@ -5,6 +5,7 @@
 //
 
 #include "sha1.h"
+#include "simd.h"
 
 /// same as reset()
 SHA1::SHA1()
@@ -71,6 +72,12 @@ namespace
 /// process 64 bytes
 void SHA1::processBlock(const void* data)
 {
+  if (HashSimd::hasSha())
+  {
+    HashSimd::sha1Blocks(m_hash, data, 1);
+    return;
+  }
+
   // get last hash
   uint32_t a = m_hash[0];
   uint32_t b = m_hash[1];
@@ -172,7 +179,16 @@ void SHA1::add(const void* data, size_t numBytes)
   if (numBytes == 0)
     return;
 
-  // process full blocks
+  // process full blocks, all at once with SHA extensions
+  if (HashSimd::hasSha() && numBytes >= BlockSize)
+  {
+    size_t numBlocks = numBytes / BlockSize;
+    HashSimd::sha1Blocks(m_hash, current, numBlocks);
+    current    += numBlocks * BlockSize;
+    m_numBytes += numBlocks * BlockSize;
+    numBytes   -= numBlocks * BlockSize;
+  }
+
   while (numBytes >= BlockSize)
   {
     processBlock(current);
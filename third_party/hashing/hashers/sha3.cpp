@@ -274,6 +274,19 @@ const char* SHA3::getHash()
 }
 
 
+/// return latest hash as bytes
+void SHA3::getHash(unsigned char buffer[SHA3::MaxHashBytes])
+{
+  // process remaining bytes
+  processBuffer();
+
+  // same order as the hex characters, little endian within each 64 bit element
+  unsigned int hashBytes = m_bits / 8;
+  for (unsigned int i = 0; i < hashBytes; i++)
+    buffer[i] = (unsigned char) (m_hash[i / 8] >> (8 * (i % 8)));
+}
+
+
 /// compute SHA3 of a memory block
 const char* SHA3::operator()(const void* data, size_t numBytes)
 {
@@ -26,6 +26,8 @@ class SHA3 //: public Hash
 public:
   /// algorithm variants
   enum Bits { Bits224 = 224, Bits256 = 256, Bits384 = 384, Bits512 = 512 };
+  /// hash is up to 64 bytes long
+  enum { MaxHashBytes = 512 / 8 };
 
   /// same as reset()
   explicit SHA3(Bits bits = Bits256);
@@ -40,6 +42,8 @@ public:
 
   /// return latest hash as hex characters
   const char* getHash();
+  /// return latest hash as bytes, MaxHashBytes at most (bits / 8)
+  void        getHash(unsigned char buffer[MaxHashBytes]);
 
   /// same as reset()
   void changeBits(Bits bits);
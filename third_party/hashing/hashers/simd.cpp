@@ -0,0 +1,353 @@
+// //////////////////////////////////////////////////////////
+// simd.cpp
+// x86 SHA extensions and carry-less multiplication paths of the hashers.
+// SHA rounds follow Intel's SHA extensions reference code, the CRC32 folding
+// Intel's "Fast CRC Computation Using PCLMULQDQ Instruction" paper.
+//
+
+#include "simd.h"
+
+#if defined(HASHING_X86_SIMD)
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+  #include <immintrin.h>
+  #define SHA_TARGET
+  #define CLMUL_TARGET
+#else
+  #include <cpuid.h>
+  #include <immintrin.h>
+  #define SHA_TARGET   __attribute__((target("sha,sse4.1,ssse3")))
+  #define CLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+#endif
+
+namespace
+{
+  enum
+  {
+    Leaf1_Ecx_Ssse3  = 1 << 9,
+    Leaf1_Ecx_Sse41  = 1 << 19,
+    Leaf1_Ecx_Clmul  = 1 << 1,
+    Leaf7_Ebx_Sha    = 1 << 29,
+  };
+
+  struct CpuFeatures
+  {
+    bool sha;
+    bool clmul;
+
+    CpuFeatures() : sha(false), clmul(false)
+    {
+      unsigned int regs[4] = { 0, 0, 0, 0 }; // eax, ebx, ecx, edx
+
+#if defined(_MSC_VER)
+      int info[4];
+      __cpuid(info, 0);
+      unsigned int maxLeaf = info[0];
+
+      __cpuid(info, 1);
+      regs[2] = info[2];
+#else
+      unsigned int maxLeaf = __get_cpuid_max(0, 0);
+
+      if (maxLeaf >= 1)
+        __cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+#endif
+
+      bool sse = (regs[2] & Leaf1_Ecx_Ssse3) && (regs[2] & Leaf1_Ecx_Sse41);
+      clmul = sse && (regs[2] & Leaf1_Ecx_Clmul);
+
+      if (sse && maxLeaf >= 7)
+      {
+#if defined(_MSC_VER)
+        __cpuidex(info, 7, 0);
+        regs[1] = info[1];
+#else
+        __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        sha = (regs[1] & Leaf7_Ebx_Sha) != 0;
+      }
+    }
+  };
+
+  const CpuFeatures& cpuFeatures()
+  {
+    static const CpuFeatures features;
+    return features;
+  }
+
+  const uint32_t sha256K[64] =
+  {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+  // CRC32 folding constants, bit-reflected, as 64 bit pairs
+  const uint32_t crcK1K2[4] = { 0x54442bd4, 0x00000001, 0xc6e41596, 0x00000001 };
+  const uint32_t crcK3K4[4] = { 0x751997d0, 0x00000001, 0xccaa009e, 0x00000000 };
+  const uint32_t crcK5K0[4] = { 0x63cd6124, 0x00000001, 0x00000000, 0x00000000 };
+  const uint32_t crcPoly[4] = { 0xdb710641, 0x00000001, 0xf7011641, 0x00000001 };
+}
+
+
+bool HashSimd::hasSha()
+{
+  return cpuFeatures().sha;
+}
+
+
+bool HashSimd::hasClmul()
+{
+  return cpuFeatures().clmul;
+}
+
+
+// 4 rounds of SHA1, cur holds the message words of this group, next to next3 those of the following ones
+#define SHA1_QUAD(group, cur, next, next2, next3)                         \
+  {                                                                       \
+    e = (group) == 0 ? _mm_add_epi32(e, cur) : _mm_sha1nexte_epu32(e, cur); \
+    save = abcd;                                                          \
+    abcd = _mm_sha1rnds4_epu32(abcd, e, (group) / 5);                     \
+    e = save;                                                             \
+    if ((group) >= 3 && (group) <= 18)                                    \
+      next = _mm_sha1msg2_epu32(next, cur);                               \
+    if ((group) >= 1 && (group) <= 16)                                    \
+      next3 = _mm_sha1msg1_epu32(next3, cur);                             \
+    if ((group) >= 2 && (group) <= 17)                                    \
+      next2 = _mm_xor_si128(next2, cur);                                  \
+  }
+
+SHA_TARGET
+void HashSimd::sha1Blocks(uint32_t state[5], const void* data, size_t numBlocks)
+{
+  const __m128i mask = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  const uint8_t* current = (const uint8_t*) data;
+
+  __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) state), 0x1B);
+  __m128i e0   = _mm_set_epi32((int) state[4], 0, 0, 0);
+
+  while (numBlocks--)
+  {
+    __m128i abcdSave = abcd;
+    __m128i e = e0;
+    __m128i save;
+
+    __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current +  0)), mask);
+    __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current + 16)), mask);
+    __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current + 32)), mask);
+    __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current + 48)), mask);
+
+    SHA1_QUAD( 0, w0, w1, w2, w3); SHA1_QUAD( 1, w1, w2, w3, w0);
+    SHA1_QUAD( 2, w2, w3, w0, w1); SHA1_QUAD( 3, w3, w0, w1, w2);
+    SHA1_QUAD( 4, w0, w1, w2, w3); SHA1_QUAD( 5, w1, w2, w3, w0);
+    SHA1_QUAD( 6, w2, w3, w0, w1); SHA1_QUAD( 7, w3, w0, w1, w2);
+    SHA1_QUAD( 8, w0, w1, w2, w3); SHA1_QUAD( 9, w1, w2, w3, w0);
+    SHA1_QUAD(10, w2, w3, w0, w1); SHA1_QUAD(11, w3, w0, w1, w2);
+    SHA1_QUAD(12, w0, w1, w2, w3); SHA1_QUAD(13, w1, w2, w3, w0);
+    SHA1_QUAD(14, w2, w3, w0, w1); SHA1_QUAD(15, w3, w0, w1, w2);
+    SHA1_QUAD(16, w0, w1, w2, w3); SHA1_QUAD(17, w1, w2, w3, w0);
+    SHA1_QUAD(18, w2, w3, w0, w1); SHA1_QUAD(19, w3, w0, w1, w2);
+
+    e0   = _mm_sha1nexte_epu32(e, e0);
+    abcd = _mm_add_epi32(abcd, abcdSave);
+
+    current += 64;
+  }
+
+  _mm_storeu_si128((__m128i*) state, _mm_shuffle_epi32(abcd, 0x1B));
+  state[4] = (uint32_t) _mm_extract_epi32(e0, 3);
+}
+
+#undef SHA1_QUAD
+
+
+// 4 rounds of SHA256, cur holds the message words of this group, prev and next its neighbours
+#define SHA256_QUAD(group, cur, prev, next)                                                 \
+  {                                                                                         \
+    msg = _mm_add_epi32(cur, _mm_loadu_si128((const __m128i*) (sha256K + 4 * (group))));    \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                                    \
+    if ((group) >= 3 && (group) <= 14)                                                      \
+      next = _mm_sha256msg2_epu32(_mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4)), cur); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));          \
+    if ((group) >= 1 && (group) <= 12)                                                      \
+      prev = _mm_sha256msg1_epu32(prev, cur);                                               \
+  }
+
+SHA_TARGET
+void HashSimd::sha256Blocks(uint32_t state[8], const void* data, size_t numBlocks)
+{
+  const __m128i mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  const uint8_t* current = (const uint8_t*) data;
+
+  // a,b,c,d,e,f,g,h => abef, cdgh
+  __m128i tmp    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) (state + 0)), 0xB1);
+  __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) (state + 4)), 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  while (numBlocks--)
+  {
+    __m128i save0 = state0;
+    __m128i save1 = state1;
+    __m128i msg;
+
+    __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current +  0)), mask);
+    __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current + 16)), mask);
+    __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current + 32)), mask);
+    __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (current + 48)), mask);
+
+    SHA256_QUAD( 0, w0, w3, w1); SHA256_QUAD( 1, w1, w0, w2);
+    SHA256_QUAD( 2, w2, w1, w3); SHA256_QUAD( 3, w3, w2, w0);
+    SHA256_QUAD( 4, w0, w3, w1); SHA256_QUAD( 5, w1, w0, w2);
+    SHA256_QUAD( 6, w2, w1, w3); SHA256_QUAD( 7, w3, w2, w0);
+    SHA256_QUAD( 8, w0, w3, w1); SHA256_QUAD( 9, w1, w0, w2);
+    SHA256_QUAD(10, w2, w1, w3); SHA256_QUAD(11, w3, w2, w0);
+    SHA256_QUAD(12, w0, w3, w1); SHA256_QUAD(13, w1, w0, w2);
+    SHA256_QUAD(14, w2, w1, w3); SHA256_QUAD(15, w3, w2, w0);
+
+    state0 = _mm_add_epi32(state0, save0);
+    state1 = _mm_add_epi32(state1, save1);
+
+    current += 64;
+  }
+
+  // abef, cdgh => a,b,c,d,e,f,g,h
+  tmp    = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+  _mm_storeu_si128((__m128i*) (state + 0), state0);
+  _mm_storeu_si128((__m128i*) (state + 4), state1);
+}
+
+#undef SHA256_QUAD
+
+
+CLMUL_TARGET
+uint32_t HashSimd::crc32Fold(uint32_t crc, const void* data, size_t numBytes)
+{
+  const uint8_t* current = (const uint8_t*) data;
+
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  // four lanes of 16 bytes, the crc so far goes into the first one
+  x1 = _mm_loadu_si128((const __m128i*) (current +  0));
+  x2 = _mm_loadu_si128((const __m128i*) (current + 16));
+  x3 = _mm_loadu_si128((const __m128i*) (current + 32));
+  x4 = _mm_loadu_si128((const __m128i*) (current + 48));
+
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+  x0 = _mm_loadu_si128((const __m128i*) crcK1K2);
+
+  current  += 64;
+  numBytes -= 64;
+
+  // fold 64 bytes at once
+  while (numBytes >= 64)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*) (current +  0)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*) (current + 16)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*) (current + 32)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*) (current + 48)));
+
+    current  += 64;
+    numBytes -= 64;
+  }
+
+  // fold the four lanes into one
+  x0 = _mm_loadu_si128((const __m128i*) crcK3K4);
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // remaining blocks of 16 bytes
+  while (numBytes >= 16)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*) current)), x5);
+
+    current  += 16;
+    numBytes -= 16;
+  }
+
+  // 128 => 64 bits
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  x0 = _mm_loadu_si128((const __m128i*) crcK5K0);
+
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, x3);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits
+  x0 = _mm_loadu_si128((const __m128i*) crcPoly);
+
+  x2 = _mm_and_si128(x1, x3);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+  x2 = _mm_and_si128(x2, x3);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return (uint32_t) _mm_extract_epi32(x1, 1);
+}
+
+#else // HASHING_X86_SIMD
+
+bool HashSimd::hasSha()
+{
+  return false;
+}
+
+
+bool HashSimd::hasClmul()
+{
+  return false;
+}
+
+
+void HashSimd::sha1Blocks(uint32_t*, const void*, size_t)
+{
+}
+
+
+void HashSimd::sha256Blocks(uint32_t*, const void*, size_t)
+{
+}
+
+
+uint32_t HashSimd::crc32Fold(uint32_t crc, const void*, size_t)
+{
+  return crc;
+}
+
+#endif // HASHING_X86_SIMD
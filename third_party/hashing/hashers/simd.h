@@ -0,0 +1,32 @@
+// //////////////////////////////////////////////////////////
+// simd.h
+// x86 SHA extensions and carry-less multiplication paths of the hashers,
+// picked at runtime when the CPU has them.
+//
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if (defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)) && \
+    ((defined(__GNUC__) && !defined(__clang__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || \
+     (defined(__clang__) && (__clang_major__ > 3 || (__clang_major__ == 3 && __clang_minor__ >= 8))) || \
+     (defined(_MSC_VER) && _MSC_VER >= 1900))
+  #define HASHING_X86_SIMD
+#endif
+
+namespace HashSimd
+{
+  /// SHA-NI, with the SSSE3 and SSE4.1 instructions used around it
+  bool hasSha();
+  /// PCLMULQDQ and SSE4.1
+  bool hasClmul();
+
+  /// process numBlocks 64 byte blocks, only when hasSha()
+  void sha1Blocks (uint32_t state[5], const void* data, size_t numBlocks);
+  void sha256Blocks(uint32_t state[8], const void* data, size_t numBlocks);
+
+  /// fold numBytes (at least 64, multiple of 16) into an inverted crc, only when hasClmul()
+  uint32_t crc32Fold(uint32_t crc, const void* data, size_t numBytes);
+}
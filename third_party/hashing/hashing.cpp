@@ -8,6 +8,7 @@
 //     https://alliedmods.net/amxmodx-license
 
 #include "hashing.h"
+#include "hasher.h"
 
 
 /**
@@ -168,3 +169,95 @@ const char* hashString(const char* String, size_t stringLen, HashType Type)
 	 */
 	return NULL;
 };
+
+Hasher::Hasher(HashType Type) : m_Type(Type)
+{
+	reset();
+}
+
+bool Hasher::isValid() const
+{
+	return m_Type >= Hash_Crc32 && m_Type <= Hash_Keccak_512;
+}
+
+HashType Hasher::getType() const
+{
+	return m_Type;
+}
+
+void Hasher::reset()
+{
+	switch (m_Type)
+	{
+	case Hash_Crc32:      m_Crc32.reset();                      break;
+	case Hash_Md5:        m_Md5.reset();                        break;
+	case Hash_Sha1:       m_Sha1.reset();                       break;
+	case Hash_Sha256:     m_Sha256.reset();                     break;
+	case Hash_Sha3_224:   m_Sha3.changeBits(SHA3::Bits224);     break;
+	case Hash_Sha3_256:   m_Sha3.changeBits(SHA3::Bits256);     break;
+	case Hash_Sha3_384:   m_Sha3.changeBits(SHA3::Bits384);     break;
+	case Hash_Sha3_512:   m_Sha3.changeBits(SHA3::Bits512);     break;
+	case Hash_Keccak_224: m_Kec.changeBits(Keccak::Keccak224);  break;
+	case Hash_Keccak_256: m_Kec.changeBits(Keccak::Keccak256);  break;
+	case Hash_Keccak_384: m_Kec.changeBits(Keccak::Keccak384);  break;
+	case Hash_Keccak_512: m_Kec.changeBits(Keccak::Keccak512);  break;
+	};
+}
+
+void Hasher::add(const void* Data, size_t Size)
+{
+	switch (m_Type)
+	{
+	case Hash_Crc32:      m_Crc32.add(Data, Size);  break;
+	case Hash_Md5:        m_Md5.add(Data, Size);    break;
+	case Hash_Sha1:       m_Sha1.add(Data, Size);   break;
+	case Hash_Sha256:     m_Sha256.add(Data, Size); break;
+	case Hash_Sha3_224:
+	case Hash_Sha3_256:
+	case Hash_Sha3_384:
+	case Hash_Sha3_512:   m_Sha3.add(Data, Size);   break;
+	case Hash_Keccak_224:
+	case Hash_Keccak_256:
+	case Hash_Keccak_384:
+	case Hash_Keccak_512: m_Kec.add(Data, Size);    break;
+	};
+}
+
+size_t Hasher::finish(char Output[MaxHashLength + 1])
+{
+	static const char Dec2Hex[16 + 1] = "0123456789abcdef";
+
+	/**
+	 * Raw bytes first, the hashers' hex strings are static buffers
+	 */
+	unsigned char Bytes[MaxHashBytes];
+	size_t Count = 0;
+
+	switch (m_Type)
+	{
+	case Hash_Crc32:      m_Crc32.getHash(Bytes);  Count = CRC32::HashBytes;  break;
+	case Hash_Md5:        m_Md5.getHash(Bytes);    Count = MD5::HashBytes;    break;
+	case Hash_Sha1:       m_Sha1.getHash(Bytes);   Count = SHA1::HashBytes;   break;
+	case Hash_Sha256:     m_Sha256.getHash(Bytes); Count = SHA256::HashBytes; break;
+	case Hash_Sha3_224:   m_Sha3.getHash(Bytes);   Count = 224 / 8;           break;
+	case Hash_Sha3_256:   m_Sha3.getHash(Bytes);   Count = 256 / 8;           break;
+	case Hash_Sha3_384:   m_Sha3.getHash(Bytes);   Count = 384 / 8;           break;
+	case Hash_Sha3_512:   m_Sha3.getHash(Bytes);   Count = 512 / 8;           break;
+	case Hash_Keccak_224: m_Kec.getHash(Bytes);    Count = 224 / 8;           break;
+	case Hash_Keccak_256: m_Kec.getHash(Bytes);    Count = 256 / 8;           break;
+	case Hash_Keccak_384: m_Kec.getHash(Bytes);    Count = 384 / 8;           break;
+	case Hash_Keccak_512: m_Kec.getHash(Bytes);    Count = 512 / 8;           break;
+	};
+
+	for (size_t i = 0; i < Count; i++)
+	{
+		Output[i * 2]     = Dec2Hex[Bytes[i] >> 4];
+		Output[i * 2 + 1] = Dec2Hex[Bytes[i] & 15];
+	}
+
+	Output[Count * 2] = '\0';
+
+	reset();
+
+	return Count * 2;
+}